@@ -0,0 +1,105 @@
+#include "compile.hpp"
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2026 Ryan Ogurek
+ *
+ * cli/compile.cpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "log/logger.hpp"
+#include "process/process.hpp"
+#include "sketch/sketch.hpp"
+#include "utils/files.hpp"
+#include "utils/paths.hpp"
+
+std::variant<cli::CompileOutput, std::string> cli::compile(
+    const std::string& name,
+    const config::Config& config,
+    std::string_view header,
+    const fs::path& workDir,
+    logging::Branch& lBranch
+) {
+    auto& logger{lBranch.createLogger("cli::compile()")};
+
+    const auto osPath{
+        paths::osDir() / config.os()->version_.string() / "ProffieOS"
+    };
+    const auto sketchPath{workDir / "ProffieOS"};
+
+    std::error_code err;
+    fs::create_directories(workDir, err);
+    if (not err) {
+        fs::copy(
+            osPath,
+            sketchPath,
+            fs::copy_options::recursive | fs::copy_options::overwrite_existing,
+            err
+        );
+    }
+    if (err) {
+        logger.error("Failed to copy OS: " + err.message());
+        return "OS FS Error: " + err.message();
+    }
+
+    if (auto depErr{sketch::installDeps(config, sketchPath, lBranch)}) {
+        return *depErr;
+    }
+
+    const auto outName{sketch::configFileName(name)};
+    if (not files::writeAtomic(sketchPath / "config" / outName, header, err)) {
+        logger.error("Failed to write config: " + err.message());
+        return "Config FS Error: " + err.message();
+    }
+
+    if (auto inoErr{sketch::updateIno(sketchPath, outName, config, lBranch)}) {
+        return *inoErr;
+    }
+
+    logger.info("Compiling...");
+
+    auto args{sketch::compileArgs(config, sketchPath)};
+    args.emplace_back("--build-path");
+    args.push_back((workDir / "build").string());
+    args.emplace_back("--no-color");
+
+    Process proc;
+    proc.create((paths::binaryDir() / "arduino-cli").string(), args);
+
+    std::string compileOutput;
+    while (auto buffer{proc.read()}) compileOutput += *buffer;
+
+    auto res{proc.finish()};
+    if (res.err_ or compileOutput.find("error") != std::string::npos) {
+        logger.error(compileOutput);
+
+        // The first error line is the most useful for a summary.
+        const auto errPos{compileOutput.find("error")};
+        if (errPos == std::string::npos) {
+            return "Compilation failed: " + std::to_string(res.systemResult_);
+        }
+        const auto lineStart{compileOutput.rfind('\n', errPos) + 1};
+        const auto lineEnd{compileOutput.find('\n', errPos)};
+        return compileOutput.substr(lineStart, lineEnd - lineStart);
+    }
+
+    const auto usage{sketch::parseUsage(compileOutput)};
+    if (usage.used_ < 0 or usage.total_ < 0) {
+        logger.warn("Usage data not found in compilation output.");
+    }
+
+    logger.info("Success");
+    return CompileOutput{.used_=usage.used_, .total_=usage.total_};
+}
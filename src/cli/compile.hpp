@@ -0,0 +1,60 @@
+#pragma once
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2026 Ryan Ogurek
+ *
+ * cli/compile.hpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <variant>
+
+#include "config/config.hpp"
+#include "log/branch.hpp"
+#include "utils/types.hpp"
+
+namespace cli {
+
+struct CompileOutput {
+    // -1 if not found in the compiler output
+    int32 used_{-1};
+    int32 total_{-1};
+};
+
+/**
+ * Compile a generated config against its ProffieOS.
+ *
+ * Unlike the editor, this works on a copy of ProffieOS in workDir, so any
+ * number can run at once. The core must already be installed.
+ *
+ * @param header The generated config
+ * @param workDir Scratch directory for this compile only, left for the
+ *                caller to remove.
+ *
+ * @return Output, or an error message on failure
+ */
+std::variant<CompileOutput, std::string> compile(
+    const std::string& name,
+    const config::Config&,
+    std::string_view header,
+    const fs::path& workDir,
+    logging::Branch&
+);
+
+} // namespace cli
+
@@ -0,0 +1,447 @@
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2026 Ryan Ogurek
+ *
+ * cli/main.cpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <wx/app.h>
+#include <wx/utils.h>
+
+#include "config/config.hpp"
+#include "config/info.hpp"
+#include "config/priv/io.hpp"
+#include "config/synth.hpp"
+#include "log/context.hpp"
+#include "log/logger.hpp"
+#include "utils/files.hpp"
+#include "utils/parallel.hpp"
+#include "utils/paths.hpp"
+#include "utils/timing.hpp"
+#include "utils/types.hpp"
+#include "versions/versions.hpp"
+
+#include "compile.hpp"
+
+namespace {
+
+constexpr cstring USAGE{
+    "Usage: proffieconfig-cli [options] <config.h | dir>...\n"
+    "\n"
+    "Parse and generate each config, printing one JSON object per line with\n"
+    "timings in milliseconds, in the order given.\n"
+    "\n"
+    "Options:\n"
+    "  -j, --jobs <n>    Configs to process at once, default is one per core\n"
+    "                    With 1, each parse is split across cores instead\n"
+    "  -o, --out <dir>   Write generated configs to dir\n"
+    "  -c, --compile     Also compile each config and report flash usage\n"
+    "  -s, --synth <shape>\n"
+    "                    Also build a synthetic config, e.g.\n"
+    "                    seed=1,presets=2000,configs=2,blades=40,splits=4,aliases=500\n"
+    "                    Keys are seed, arrays, presets, configs, blades, splits,\n"
+    "                    aliases and depth. Written to <out>/synth, or a temp dir\n"
+    "                    removed on exit.\n"
+    "  -v, --verbose     Log to stderr\n"
+    "  -h, --help        Show this message\n"
+};
+
+struct Options {
+    std::vector<fs::path> configs_;
+    std::vector<config::synth::Shape> synth_;
+    std::optional<fs::path> outDir_;
+    size jobs_{0};
+    bool compile_{false};
+    bool verbose_{false};
+};
+
+struct Result {
+    std::optional<std::string> err_;
+
+    float64 parseMs_{-1};
+    float64 generateMs_{-1};
+    float64 compileMs_{-1};
+
+    int32 flashUsed_{-1};
+    int32 flashTotal_{-1};
+};
+
+/**
+ * @return Options, or nullopt if the program should exit with exitCode
+ */
+std::optional<Options> parseArgs(const wxCmdLineArgsArray&, int& exitCode);
+
+/**
+ * Build and write out the synthetic configs, adding them to the configs.
+ *
+ * @return false on failure
+ */
+bool synthesize(Options&, logging::Logger&);
+
+Result process(
+    const fs::path&, const Options&, size idx, logging::Logger&
+);
+
+void printResult(const fs::path&, const Result&);
+
+std::string jsonString(std::string_view);
+
+/**
+ * @return Scratch dir for this run, unique to this process so concurrent runs
+ *         on one machine don't trample each other.
+ */
+fs::path tempDir();
+
+/**
+ * @return Name synthetic config idx is written under
+ */
+fs::path synthName(size idx);
+
+} // namespace
+
+class Cli : public wxAppConsole {
+public:
+    bool OnInit() override {
+        return true;
+    }
+
+    // Everything happens here, the return value is the exit code.
+    int OnRun() override {
+        int exitCode{0};
+        auto options{parseArgs(argv, exitCode)};
+        if (not options) return exitCode;
+
+        // Keep stdout to results only.
+        std::vector<std::ostream *> logOutputs;
+        if (options->verbose_) logOutputs.push_back(&std::clog);
+        logging::Context::setGlobalOuput(logOutputs, false);
+        logging::Context::getGlobal().setSeverity(
+            options->verbose_ ? logging::Severity::Info : logging::Severity::Err
+        );
+        auto& logger{logging::Context::getGlobal().createLogger("Cli::OnRun()")};
+
+        if (auto ec{paths::init()}) {
+            std::cerr << "Could not setup paths: " << ec.message() << '\n';
+            return 1;
+        }
+
+        config::setExecutableVersion(wxSTRINGIZE(BIN_VERSION));
+        versions::loadLocal(logger.binfo("Loading versions..."));
+
+        // Configs are already spread across the pool, splitting up each
+        // parse too would only have them wait on each other.
+        if (options->jobs_ != 1) config::setParallelParse(false);
+
+        if (not synthesize(*options, logger)) return 1;
+
+        const auto& configs{options->configs_};
+        std::vector<Result> results(configs.size());
+        utils::parallelFor(configs.size(), [&](size idx) {
+            results[idx] = process(configs[idx], *options, idx, logger);
+        }, options->jobs_);
+
+        auto failed{false};
+        for (size idx{0}; idx < configs.size(); ++idx) {
+            printResult(configs[idx], results[idx]);
+            failed |= results[idx].err_.has_value();
+        }
+
+        // Each run has its own, so nothing else would ever clean it up.
+        std::error_code ec;
+        fs::remove_all(tempDir(), ec);
+
+        return failed ? 1 : 0;
+    }
+};
+
+// NOLINTNEXTLINE
+wxIMPLEMENT_APP_CONSOLE(Cli);
+
+namespace {
+
+std::optional<Options> parseArgs(
+    const wxCmdLineArgsArray& args, int& exitCode
+) {
+    Options ret;
+
+    const auto fail{[&exitCode](const std::string& msg) {
+        std::cerr << msg << "\n\n" << USAGE;
+        exitCode = 2;
+        return std::nullopt;
+    }};
+
+    for (size idx{1}; idx < args.GetCount(); ++idx) {
+        const auto arg{args[idx].utf8_string()};
+
+        if (arg == "-h" or arg == "--help") {
+            std::cout << USAGE;
+            return std::nullopt;
+        }
+
+        if (arg == "-c" or arg == "--compile") {
+            ret.compile_ = true;
+        } else if (arg == "-v" or arg == "--verbose") {
+            ret.verbose_ = true;
+        } else if (arg == "-j" or arg == "--jobs") {
+            if (++idx == args.GetCount()) return fail(arg + " needs a count");
+
+            const auto count{args[idx].utf8_string()};
+            const auto res{std::from_chars(
+                count.data(), count.data() + count.size(), ret.jobs_
+            )};
+            if (res.ec != std::errc{} or res.ptr != count.data() + count.size()) {
+                return fail("Invalid job count: " + count);
+            }
+        } else if (arg == "-s" or arg == "--synth") {
+            if (++idx == args.GetCount()) return fail(arg + " needs a shape");
+
+            auto& shape{ret.synth_.emplace_back()};
+            if (auto err{config::synth::parseShape(
+                args[idx].utf8_string(), shape
+            )}) {
+                return fail("Invalid shape: " + *err);
+            }
+        } else if (arg == "-o" or arg == "--out") {
+            if (++idx == args.GetCount()) return fail(arg + " needs a dir");
+            ret.outDir_ = fs::path{args[idx].ToStdWstring()};
+        } else if (arg.starts_with('-')) {
+            return fail("Unknown option: " + arg);
+        } else {
+            const fs::path path{args[idx].ToStdWstring()};
+
+            std::error_code err;
+            if (not fs::is_directory(path, err)) {
+                ret.configs_.push_back(path);
+                continue;
+            }
+
+            // Sorted so the order is the same everywhere.
+            std::vector<fs::path> found;
+            for (const auto& entry : fs::directory_iterator{path, err}) {
+                if (not entry.is_regular_file()) continue;
+                if (entry.path().extension() != config::RAW_FILE_EXTENSION) continue;
+
+                found.push_back(entry.path());
+            }
+            std::ranges::sort(found);
+            ret.configs_.insert(ret.configs_.end(), found.begin(), found.end());
+        }
+    }
+
+    if (ret.configs_.empty() and ret.synth_.empty()) {
+        return fail("No configs given");
+    }
+
+    if (ret.outDir_) {
+        // Outputs are named for their inputs, so same-named inputs, even from
+        // different dirs, would write over each other.
+        std::set<fs::path> names;
+        for (size idx{0}; idx < ret.synth_.size(); ++idx) {
+            names.insert(synthName(idx));
+        }
+        for (const auto& path : ret.configs_) {
+            if (not names.insert(path.filename()).second) {
+                return fail(
+                    "More than one config named " + path.filename().string() +
+                    ", outputs would collide"
+                );
+            }
+        }
+
+        std::error_code err;
+        fs::create_directories(*ret.outDir_, err);
+        if (err) return fail("Could not create output dir: " + err.message());
+    }
+
+    return ret;
+}
+
+bool synthesize(Options& options, logging::Logger& logger) {
+    if (options.synth_.empty()) return true;
+
+    const auto synthDir{
+        (options.outDir_
+            ? *options.outDir_
+            : tempDir()
+        ) / "synth"
+    };
+
+    std::error_code ec;
+    fs::create_directories(synthDir, ec);
+    if (ec) {
+        std::cerr << "Could not create synth dir: " << ec.message() << '\n';
+        return false;
+    }
+
+    std::vector<fs::path> paths(options.synth_.size());
+    std::vector<std::optional<std::string>> errs(options.synth_.size());
+    utils::parallelFor(options.synth_.size(), [&](size idx) {
+        auto& branch{*logger.binfo("Building synthetic config " + std::to_string(idx) + "...")};
+
+        std::unique_ptr<config::Config> config;
+        errs[idx] = config::synth::build(options.synth_[idx], config, &branch);
+        if (errs[idx]) return;
+
+        paths[idx] = synthDir / synthName(idx);
+        errs[idx] = config::generate(*config, paths[idx], &branch);
+    }, options.jobs_);
+
+    for (size idx{0}; idx < errs.size(); ++idx) {
+        if (not errs[idx]) continue;
+
+        std::cerr << "Could not build synthetic config " << idx << ": " << *errs[idx] << '\n';
+        return false;
+    }
+
+    options.configs_.insert(options.configs_.end(), paths.begin(), paths.end());
+    return true;
+}
+
+Result process(
+    const fs::path& path,
+    const Options& options,
+    size idx,
+    logging::Logger& logger
+) {
+    Result ret;
+    auto& branch{*logger.binfo("Processing \"" + path.string() + "\"...")};
+
+    std::unique_ptr<config::Config> config;
+    ret.parseMs_ = utils::timeMs([&] {
+        ret.err_ = config::read(path, config, &branch);
+    });
+    if (ret.err_) return ret;
+
+    std::string header;
+    ret.generateMs_ = utils::timeMs([&] {
+        ret.err_ = config::priv::io::generate(header, *config, &branch);
+    });
+    if (ret.err_) return ret;
+
+    if (options.outDir_) {
+        std::error_code err;
+        const auto outPath{*options.outDir_ / path.filename()};
+        if (not files::writeAtomic(outPath, header, err)) {
+            ret.err_ = "Could not write output: " + err.message();
+            return ret;
+        }
+    }
+
+    if (not options.compile_) return ret;
+
+    // Configs in different dirs can share a name, so keep them apart.
+    const auto workDir{tempDir() / std::to_string(idx)};
+
+    std::variant<cli::CompileOutput, std::string> res;
+    ret.compileMs_ = utils::timeMs([&] {
+        res = cli::compile(
+            path.stem().string(), *config, header, workDir, branch
+        );
+    });
+
+    std::error_code err;
+    fs::remove_all(workDir, err);
+
+    if (auto *compileErr{std::get_if<std::string>(&res)}) {
+        ret.err_ = std::move(*compileErr);
+        return ret;
+    }
+
+    const auto& output{std::get<cli::CompileOutput>(res)};
+    ret.flashUsed_ = output.used_;
+    ret.flashTotal_ = output.total_;
+
+    return ret;
+}
+
+void printResult(const fs::path& path, const Result& result) {
+    std::string line{"{\"config\":"};
+    line += jsonString(path.string());
+    line += ",\"ok\":";
+    line += result.err_ ? "false" : "true";
+
+    const auto number{[&line](std::string_view key, auto val) {
+        if (val < 0) return;
+
+        line += ",\"";
+        line += key;
+        line += "\":";
+
+        std::array<char, 32> buf;
+        const auto res{std::to_chars(buf.data(), buf.data() + buf.size(), val)};
+        line.append(buf.data(), res.ptr);
+    }};
+    number("parse_ms", result.parseMs_);
+    number("generate_ms", result.generateMs_);
+    number("compile_ms", result.compileMs_);
+    number("flash_used", result.flashUsed_);
+    number("flash_total", result.flashTotal_);
+
+    if (result.err_) {
+        line += ",\"error\":";
+        line += jsonString(*result.err_);
+    }
+
+    line += "}\n";
+    std::cout << line << std::flush;
+}
+
+std::string jsonString(std::string_view str) {
+    std::string ret{'"'};
+    ret.reserve(str.size() + 2);
+
+    for (const char chr : str) {
+        switch (chr) {
+            case '"': ret += "\\\""; break;
+            case '\\': ret += "\\\\"; break;
+            case '\n': ret += "\\n"; break;
+            case '\r': ret += "\\r"; break;
+            case '\t': ret += "\\t"; break;
+            default:
+                if (static_cast<uint8>(chr) < 0x20) {
+                    constexpr std::string_view HEX{"0123456789abcdef"};
+                    ret += "\\u00";
+                    ret += HEX[chr >> 4];
+                    ret += HEX[chr & 0xF];
+                } else ret += chr;
+        }
+    }
+
+    ret += '"';
+    return ret;
+}
+
+fs::path tempDir() {
+    return fs::temp_directory_path() /
+        ("proffieconfig-cli-" + std::to_string(wxGetProcessId()));
+}
+
+fs::path synthName(size idx) {
+    return "synth" + std::to_string(idx) + config::RAW_FILE_EXTENSION;
+}
+
+} // namespace
+
@@ -19,6 +19,8 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <array>
+
 #include "config/blades/simple.hpp"
 #include "config/blades/ws281x.hpp"
 #include "data/hierarchic/model.hpp"
@@ -28,6 +30,7 @@
 #include "data/hierarchic/models/string.hpp"
 #include "data/primitive/models/number.hpp"
 #include "data/receiver.hpp"
+#include "utils/string.hpp"
 #include "utils/types.hpp"
 
 #include "config_export.h"
@@ -40,6 +43,13 @@ namespace blades {
 
 constexpr int32 NO_BLADE{1000000000};
 
+/**
+ * Names which configs may use in place of an ID's value.
+ */
+constexpr std::array<utils::MathConstant, 1> ID_CONSTANTS{{
+    {.name_="NO_BLADE", .value_=NO_BLADE},
+}};
+
 struct CONFIG_EXPORT BladeConfig : data::hier::Model, data::Receiver {
     BladeConfig(Config&);
 
@@ -32,6 +32,8 @@
 #include "config/presets/array.hpp"
 #include "config/presets/preset.hpp"
 #include "config/priv/data.hpp"
+#include "config/priv/generate/cache.hpp"
+#include "config/priv/generate/check/check.hpp"
 #include "config/priv/io.hpp"
 #include "config/priv/keys.hpp"
 #include "config/settings/define.hpp"
@@ -322,6 +324,10 @@ void Config::calcNumBlades() {
 }
 
 void Config::syncStyles() {
+    // This may touch every preset, so have each styles vec only tell its
+    // observers it's resized once.
+    Transaction transaction(*this);
+
     auto numBlades{data::context(mNumBlades)};
     auto presetArrays{data::context(presetArrays_)};
 
@@ -540,29 +546,17 @@ std::optional<std::string> Info::save(
     Config::Context ctxt{*mConfig};
     auto name{data::context(mName)};
 
-    std::optional<std::string> err;
-    std::error_code errCode;
-    const auto finalPath{this->path()};
-    const fs::path tmpPath{finalPath.string() + ".tmp"};
-    err = priv::io::generate(
-        tmpPath,
+    auto err{priv::io::generate(
+        this->path(),
         *mConfig,
         logger.binfo("Saving \"" + name.val() + "\"...")
-    );
-    if (err) {
-        fs::remove(tmpPath, errCode);
-        return err;
-    }
-
-    if (not files::copyOverwrite(tmpPath, finalPath, errCode)) {
-        err = priv::errorMessage(logger, wxTRANSLATE("Failed to move temp file: %s"), tmpPath.string(), finalPath.string(), errCode.message());
-    }
-    fs::remove(tmpPath, errCode);
+    )};
+    if (err) return err;
 
     mConfig->mSavedHash = mConfig->hash();
     mConfig->mIsSaved.set(true);
 
-    return err;
+    return std::nullopt;
 }
 
 std::optional<std::string> Info::load() {
@@ -728,18 +722,47 @@ std::optional<std::string> config::generate(
 ) {
     auto& logger{logging::Branch::optCreateLogger("generate()", lBranch)};
 
-    std::optional<std::string> err;
-    std::error_code errCode;
-
-    err = priv::io::generate(
+    return priv::io::generate(
         path,
         config,
         logger.binfo("Generating config at \"" + path.string() + "\"...")
     );
+}
+
+std::optional<std::string> config::read(
+    const fs::path& path, std::unique_ptr<Config>& out, logging::Branch *lBranch
+) {
+    auto& logger{logging::Branch::optCreateLogger("read()", lBranch)};
 
-    if (err) fs::remove(path, errCode);
+    std::unique_ptr<Config> config{new Config};
+    config->suppressActions();
+
+    auto err{priv::io::parse(
+        path,
+        *config,
+        logger.binfo("Parsing \"" + path.string() + "\"...")
+    )};
+    if (err) return err;
+
+    config->unsuppressActions();
+
+    config->mSavedHash = config->hash();
+    config->mIsSaved.set(true);
+
+    out = std::move(config);
+    return std::nullopt;
+}
+
+void config::setParallelParse(bool parallel) {
+    priv::parallelParse = parallel;
+}
+
+std::optional<std::string> config::check(
+    const Config& config, logging::Branch *lBranch
+) {
+    auto& logger{logging::Branch::optCreateLogger("check()", lBranch)};
 
-    return err;
+    return priv::gen::preCheck(config, *logger.binfo("Checking config..."));
 }
 
 namespace {
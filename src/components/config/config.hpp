@@ -45,6 +45,18 @@ namespace fs = std::filesystem;
 
 namespace config {
 
+namespace priv::gen {
+
+struct Cache;
+
+} // namespace priv::gen
+
+namespace synth {
+
+struct Builder;
+
+} // namespace synth
+
 constexpr cstring RAW_FILE_EXTENSION{".h"};
 constexpr auto MAX_NAME_LENGTH{24};
 
@@ -112,6 +124,11 @@ protected:
 
 private:
     friend struct Info;
+    friend struct priv::gen::Cache;
+    friend struct synth::Builder;
+    friend CONFIG_EXPORT std::optional<std::string> read(
+        const fs::path&, std::unique_ptr<Config>&, logging::Branch *
+    );
 
     Config();
 
@@ -149,6 +166,9 @@ private:
     data::prim::Bool mIsSaved;
     std::optional<uint64> mSavedHash;
     std::map<uint64, std::unique_ptr<utils::Data>> mCache;
+
+    // Generated output of the last generation, see priv::gen::Cache
+    mutable std::unique_ptr<priv::gen::Cache> mGenCache;
 };
 
 CONFIG_EXPORT data::logic::Element operator|(Config&, Config::OSIsOrOverVersion);
@@ -196,5 +216,33 @@ CONFIG_EXPORT std::optional<std::string> generate(
     const Config&, const fs::path&, logging::Branch * = nullptr
 );
 
+/**
+ * Parse a config file on its own, without adding it to the list, for
+ * headless and batch use.
+ *
+ * @param out Replaced with the config on success.
+ *
+ * @return err or nullopt
+ */
+CONFIG_EXPORT std::optional<std::string> read(
+    const fs::path&, std::unique_ptr<Config>& out, logging::Branch * = nullptr
+);
+
+/**
+ * Whether parsing a config may split the work across threads. On by default,
+ * turn off when already parsing several configs at once.
+ */
+CONFIG_EXPORT void setParallelParse(bool);
+
+/**
+ * Check a config is ready to generate. Only what changed since the last
+ * check is checked again, so it's cheap enough to run as it's edited.
+ *
+ * @return err or nullopt
+ */
+CONFIG_EXPORT std::optional<std::string> check(
+    const Config&, logging::Branch * = nullptr
+);
+
 } // namespace config
 
@@ -44,3 +44,7 @@ uint64 Injection::hashThis() const {
     );
 }
 
+bool Injection::cacheHash() const {
+    return false;
+}
+
@@ -33,6 +33,8 @@ struct CONFIG_EXPORT Injection : data::hier::Model {
     Injection(Config&, std::string&&);
 
     uint64 hashThis() const override;
+    // The file can change under us at any time.
+    [[nodiscard]] bool cacheHash() const override;
 
     std::string filename_;
 };
@@ -21,5 +21,7 @@
 
 cstring config::priv::executableVersion;
 
+std::atomic<bool> config::priv::parallelParse{true};
+
 data::prim::Vector config::priv::list;
 
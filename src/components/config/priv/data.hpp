@@ -19,6 +19,8 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <atomic>
+
 #include "data/primitive/models/vector.hpp"
 #include "utils/types.hpp"
 
@@ -26,6 +28,8 @@ namespace config::priv {
 
 extern cstring executableVersion;
 
+extern std::atomic<bool> parallelParse;
+
 extern data::prim::Vector list;
 
 } // namespace config::priv
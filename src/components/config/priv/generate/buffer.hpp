@@ -0,0 +1,77 @@
+#pragma once
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2026 Ryan Ogurek
+ *
+ * components/config/priv/generate/buffer.hpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <charconv>
+#include <concepts>
+#include <string>
+#include <string_view>
+
+#include "utils/types.hpp"
+
+namespace config::priv::gen {
+
+/**
+ * Contiguous output the generators render into, to be written out in one go.
+ *
+ * Takes the same insertions as an ostream and formats them the same, but
+ * numbers go straight through to_chars.
+ */
+struct Buffer {
+    Buffer& operator<<(std::string_view str) {
+        mStr += str;
+        return *this;
+    }
+
+    Buffer& operator<<(char chr) {
+        mStr += chr;
+        return *this;
+    }
+
+    template <std::integral T>
+        requires (not std::same_as<T, bool> and not std::same_as<T, char>)
+    Buffer& operator<<(T val) {
+        char buf[24];
+        const auto res{std::to_chars(std::begin(buf), std::end(buf), val)};
+        mStr.append(buf, res.ptr);
+        return *this;
+    }
+
+    Buffer& operator<<(float64 val) {
+        // Same as an ostream's default, i.e. %g
+        char buf[32];
+        const auto res{std::to_chars(
+            std::begin(buf), std::end(buf), val, std::chars_format::general, 6
+        )};
+        mStr.append(buf, res.ptr);
+        return *this;
+    }
+
+    void reserve(size capacity) { mStr.reserve(capacity); }
+
+    [[nodiscard]] const std::string& str() const { return mStr; }
+    [[nodiscard]] std::string release() { return std::move(mStr); }
+
+private:
+    std::string mStr;
+};
+
+} // namespace config::priv::gen
+
@@ -26,7 +26,7 @@
 using namespace config;
 using namespace config::priv;
 
-void gen::buttons(std::ostream& out, const Config& config) {
+void gen::buttons(gen::Buffer& out, const Config& config) {
     out << "#ifdef CONFIG_BUTTONS\n";
 
     auto buttons{data::context(config.buttons_)};
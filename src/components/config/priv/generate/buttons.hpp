@@ -19,13 +19,12 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <iostream>
-
 #include "config/config.hpp"
+#include "config/priv/generate/buffer.hpp"
 
 namespace config::priv::gen {
 
-void buttons(std::ostream&, const Config&);
+void buttons(Buffer&, const Config&);
 
 } // namespace config::priv::gen
 
@@ -0,0 +1,63 @@
+#include "cache.hpp"
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2026 Ryan Ogurek
+ *
+ * components/config/priv/generate/cache.cpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <memory>
+
+using namespace config;
+using namespace config::priv;
+
+gen::Cache& gen::Cache::of(const Config& config) {
+    if (not config.mGenCache) config.mGenCache = std::make_unique<Cache>();
+    return *config.mGenCache;
+}
+
+void gen::Cache::sweep() {
+    std::erase_if(mEntries, [](const auto& pair) {
+        return not pair.second.used_;
+    });
+
+    for (auto& [key, entry] : mEntries) entry.used_ = false;
+}
+
+
+auto gen::Cache::findCheck(uint64 key) -> const std::optional<Issue> * {
+    auto iter{mChecks.find(key)};
+    if (iter == mChecks.end()) return nullptr;
+
+    iter->second.used_ = true;
+    return &iter->second.issue_;
+}
+
+void gen::Cache::storeCheck(uint64 key, std::optional<Issue> issue) {
+    ++mStats.checks_;
+    mChecks.insert_or_assign(key, Check{
+        .issue_=std::move(issue),
+        .used_=true,
+    });
+}
+
+void gen::Cache::sweepChecks() {
+    std::erase_if(mChecks, [](const auto& pair) {
+        return not pair.second.used_;
+    });
+
+    for (auto& [key, check] : mChecks) check.used_ = false;
+}
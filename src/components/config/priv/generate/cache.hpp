@@ -0,0 +1,127 @@
+#pragma once
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2026 Ryan Ogurek
+ *
+ * components/config/priv/generate/cache.hpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "config/config.hpp"
+#include "config/priv/generate/buffer.hpp"
+#include "utils/types.hpp"
+
+namespace config::priv::gen {
+
+/**
+ * Generated text of the parts of a config which are costly to render, kept
+ * between generations and keyed by a hash of everything they're rendered
+ * from, so only the parts which changed are rendered again.
+ *
+ * Guarded by the config's lock, which generation and checks hold.
+ */
+struct Cache {
+    /**
+     * Keeps keys for different kinds of fragments apart.
+     */
+    enum Kind : uint64 {
+        ePreset = 1,
+        eBlade_Config,
+        eStyle,
+        eCheck_Preset,
+        eCheck_Style,
+    };
+
+    /**
+     * A problem found by a check, and which child it was found in.
+     */
+    struct Issue {
+        size idx_;
+        std::string what_;
+    };
+
+    /**
+     * How often fragments and checks were served from the cache rather than
+     * redone, since the cache was made.
+     */
+    struct Stats {
+        size hits_{0};
+        size renders_{0};
+        size checks_{0};
+    };
+
+    static Cache& of(const Config&);
+
+    [[nodiscard]] const Stats& stats() const { return mStats; }
+
+    /**
+     * @return Text cached for key, rendered with render(Buffer&) if there
+     * isn't any.
+     */
+    template <typename F>
+    const std::string& get(uint64 key, const F& render) {
+        auto iter{mEntries.find(key)};
+        if (iter == mEntries.end()) {
+            Buffer buf;
+            render(buf);
+            iter = mEntries.emplace(key, Entry{.text_=buf.release()}).first;
+            ++mStats.renders_;
+        } else {
+            ++mStats.hits_;
+        }
+
+        iter->second.used_ = true;
+        return iter->second.text_;
+    }
+
+    /**
+     * Drop everything which wasn't used since the last sweep, once a
+     * generation is done.
+     */
+    void sweep();
+
+    /**
+     * @return Result last stored for key, nullptr if it needs checking.
+     */
+    const std::optional<Issue> *findCheck(uint64 key);
+    void storeCheck(uint64 key, std::optional<Issue>);
+
+    /**
+     * Same as sweep(), for check results, once a check is done.
+     */
+    void sweepChecks();
+
+private:
+    struct Entry {
+        std::string text_;
+        bool used_{false};
+    };
+
+    struct Check {
+        std::optional<Issue> issue_;
+        bool used_{false};
+    };
+
+    std::unordered_map<uint64, Entry> mEntries;
+    std::unordered_map<uint64, Check> mChecks;
+    Stats mStats;
+};
+
+} // namespace config::priv::gen
+
@@ -20,6 +20,8 @@
  */
 
 #include <optional>
+#include <string_view>
+#include <vector>
 
 #include "config/blades/bladeconfig.hpp"
 #include "config/blades/servo.hpp"
@@ -27,10 +29,13 @@
 #include "config/presets/array.hpp"
 #include "config/presets/preset.hpp"
 #include "config/presets/style.hpp"
+#include "config/priv/generate/cache.hpp"
 #include "config/priv/io.hpp"
 #include "config/strings.hpp"
 #include "config/styles/style.hpp"
 #include "data/context.hpp"
+#include "utils/hash.hpp"
+#include "utils/parallel.hpp"
 
 using namespace config;
 using namespace config::priv;
@@ -38,7 +43,15 @@ using namespace config::blades;
 
 namespace {
 
-std::optional<std::string> getStyleImbalance(const std::string&);
+std::optional<std::string> checkSetup(const Config&, logging::Logger&);
+std::optional<std::string> checkBlades(BladeConfig&, logging::Logger&);
+std::optional<std::string> checkPresetArrays(const Config&, logging::Logger&);
+std::optional<std::string> checkStyles(const Config&, logging::Logger&);
+std::optional<std::string> checkButton(
+    buttons::Button&, size idx, logging::Logger&
+);
+
+std::optional<std::string> getStyleImbalance(std::string_view);
 
 } // namespace
 
@@ -47,6 +60,52 @@ std::optional<std::string> gen::preCheck(
 ) {
     auto& logger{lBranch.createLogger("config::gen::preCheck()")};
 
+    std::lock_guard scopeLock{config};
+
+    if (auto err{checkSetup(config, logger)}) return err;
+
+    auto bladeConfigs{data::context(config.bladeConfigs_)};
+    for (const auto& model : bladeConfigs.children()) {
+        auto& bladeConfig{dynamic_cast<BladeConfig&>(*model)};
+
+        auto issues{data::context(bladeConfig.issues())};
+        if (issues.val() != BladeConfig::eIssue_None) {
+            auto name{data::context(bladeConfig.name_)};
+            const auto arrayName{name.val().empty()
+                ? _("[default]")
+                : name.val()
+            };
+            return errorMessage(logger, wxTRANSLATE("Blade array %s has issues, and isn't ready yet."), arrayName);
+        }
+    }
+
+    for (const auto& model : bladeConfigs.children()) {
+        auto& bladeConfig{dynamic_cast<BladeConfig&>(*model)};
+        if (auto err{checkBlades(bladeConfig, logger)}) return err;
+    }
+
+    if (auto err{checkPresetArrays(config, logger)}) return err;
+
+    // Checked results are kept until they're no longer used, which catches
+    // anything deleted or edited.
+    auto stylesErr{checkStyles(config, logger)};
+    Cache::of(config).sweepChecks();
+    if (stylesErr) return stylesErr;
+
+    auto buttons{data::context(config.buttons_)};
+    for (size idx{0}; idx < buttons.children().size(); ++idx) {
+        auto& button{dynamic_cast<buttons::Button&>(*buttons.children()[idx])};
+        if (auto err{checkButton(button, idx, logger)}) return err;
+    }
+
+    return std::nullopt;
+}
+
+namespace {
+
+std::optional<std::string> checkSetup(
+    const Config& config, logging::Logger& logger
+) {
     // Right now, the only way to save is in `.h`, but serializing to pconf
     // would remove this restriction.
     //
@@ -61,7 +120,6 @@ std::optional<std::string> gen::preCheck(
         return errorMessage(logger, wxTRANSLATE("Config must have a board selected."));
     }
 
-    const auto& settings{config.settings_};
     const auto& awareness{config.settings_.bladeAwareness_};
 
     auto bladeDetectEnable{data::context(awareness.bladeDetect_.enable_)};
@@ -92,112 +150,100 @@ std::optional<std::string> gen::preCheck(
         return errorMessage(logger, wxTRANSLATE("Blade ID Pin and Blade Detect Pin cannot be the same."));
     }
 
-    auto bladeConfigs{data::context(config.bladeConfigs_)};
-    for (const auto& model : bladeConfigs.children()) {
-        auto& bladeConfig{dynamic_cast<BladeConfig&>(*model)};
+    return std::nullopt;
+}
 
-        auto issues{data::context(bladeConfig.issues())};
-        if (issues.val() != BladeConfig::eIssue_None) {
-            auto name{data::context(bladeConfig.name_)};
-            const auto arrayName{name.val().empty()
-                ? _("[default]")
-                : name.val()
-            };
-            return errorMessage(logger, wxTRANSLATE("Blade array %s has issues, and isn't ready yet."), arrayName);
-        }
+std::optional<std::string> checkBlades(
+    BladeConfig& bladeConfig, logging::Logger& logger
+) {
+    auto name{data::context(bladeConfig.name_)};
+    auto presetArray{data::context(bladeConfig.presetArray_)};
+
+    const auto arrayName{name.val().empty()
+        ? _("[default]")
+        : name.val()
+    };
+
+    if (presetArray.choiceIdx() == -1) {
+        return errorMessage(logger, wxTRANSLATE("Blade array %s has no preset array selection"), arrayName);
     }
 
+    auto blades{data::context(bladeConfig.blades_)};
+
     for (
-            auto arrayIdx{0};
-            arrayIdx < bladeConfigs.children().size();
-            ++arrayIdx
+            auto bladeIdx{0};
+            bladeIdx < blades.children().size();
+            ++bladeIdx
         ) {
-        const auto& model{bladeConfigs.children()[arrayIdx]};
-        auto& bladeConfig{dynamic_cast<BladeConfig&>(*model)};
+        const auto& model{blades.children()[bladeIdx]};
+        auto& blade{dynamic_cast<Blade&>(*model)};
 
-        auto name{data::context(bladeConfig.name_)};
-        auto presetArray{data::context(bladeConfig.presetArray_)};
+        auto type{data::context(blade.type())};
 
-        const auto arrayName{name.val().empty()
-            ? _("[default]")
-            : name.val()
-        };
+        if (type.choiceIdx() == Blade::eWS281X) {
+            auto dataPin{data::context(blade.ws281x().dataPin_)};
 
-        if (presetArray.choiceIdx() == -1) {
-            return errorMessage(logger, wxTRANSLATE("Blade array %s has no preset array selection"), arrayName);
+            if (dataPin.val().empty()) {
+                return errorMessage(logger, wxTRANSLATE("Blade %d in array %s missing data pin"), bladeIdx, arrayName);
+            }
+            // Subblade overlap
         }
 
-        auto blades{data::context(bladeConfig.blades_)};
-
-        for (
-                auto bladeIdx{0};
-                bladeIdx < blades.children().size();
-                ++bladeIdx
-            ) {
-            const auto& model{blades.children()[bladeIdx]};
-            auto& blade{dynamic_cast<Blade&>(*model)};
-
-            auto type{data::context(blade.type())};
-
-            if (type.choiceIdx() == Blade::eWS281X) {
-                auto dataPin{data::context(blade.ws281x().dataPin_)};
-
-                if (dataPin.val().empty()) {
-                    return errorMessage(logger, wxTRANSLATE("Blade %d in array %s missing data pin"), bladeIdx, arrayName);
-                }
-                // Subblade overlap
+        if (type.choiceIdx() == Blade::eSimple) {
+            auto& led1{blade.simple().led1_};
+            auto& led2{blade.simple().led2_};
+            auto& led3{blade.simple().led3_};
+            auto& led4{blade.simple().led4_};
+
+            auto led1Profile{data::context(led1.profile_)};
+            auto led2Profile{data::context(led2.profile_)};
+            auto led3Profile{data::context(led3.profile_)};
+            auto led4Profile{data::context(led4.profile_)};
+
+            auto led1Pin{data::context(led1.powerPin_)};
+            auto led2Pin{data::context(led2.powerPin_)};
+            auto led3Pin{data::context(led3.powerPin_)};
+            auto led4Pin{data::context(led4.powerPin_)};
+
+            constexpr auto SIMPLE_ERR_MSG{wxTRANSLATE("LED %d of blade %d in array %s missing power pin.")};
+            if (led1Profile.idx() != eLED_None and led1Pin.val().empty()) {
+                return errorMessage(logger, SIMPLE_ERR_MSG, 1, bladeIdx, arrayName);
+            }
+            if (led2Profile.idx() != eLED_None and led2Pin.val().empty()) {
+                return errorMessage(logger, SIMPLE_ERR_MSG, 2, bladeIdx, arrayName);
+            }
+            if (led3Profile.idx() != eLED_None and led3Pin.val().empty()) {
+                return errorMessage(logger, SIMPLE_ERR_MSG, 3, bladeIdx, arrayName);
+            }
+            if (led4Profile.idx() != eLED_None and led4Pin.val().empty()) {
+                return errorMessage(logger, SIMPLE_ERR_MSG, 4, bladeIdx, arrayName);
             }
 
-            if (type.choiceIdx() == Blade::eSimple) {
-                auto& led1{blade.simple().led1_};
-                auto& led2{blade.simple().led2_};
-                auto& led3{blade.simple().led3_};
-                auto& led4{blade.simple().led4_};
-
-                auto led1Profile{data::context(led1.profile_)};
-                auto led2Profile{data::context(led2.profile_)};
-                auto led3Profile{data::context(led3.profile_)};
-                auto led4Profile{data::context(led4.profile_)};
-
-                auto led1Pin{data::context(led1.powerPin_)};
-                auto led2Pin{data::context(led2.powerPin_)};
-                auto led3Pin{data::context(led3.powerPin_)};
-                auto led4Pin{data::context(led4.powerPin_)};
-
-                constexpr auto SIMPLE_ERR_MSG{wxTRANSLATE("LED %d of blade %d in array %s missing power pin.")};
-                if (led1Profile.idx() != eLED_None and led1Pin.val().empty()) {
-                    return errorMessage(logger, SIMPLE_ERR_MSG, 1, bladeIdx, arrayName);
-                }
-                if (led2Profile.idx() != eLED_None and led2Pin.val().empty()) {
-                    return errorMessage(logger, SIMPLE_ERR_MSG, 2, bladeIdx, arrayName);
-                }
-                if (led3Profile.idx() != eLED_None and led3Pin.val().empty()) {
-                    return errorMessage(logger, SIMPLE_ERR_MSG, 3, bladeIdx, arrayName);
-                }
-                if (led4Profile.idx() != eLED_None and led4Pin.val().empty()) {
-                    return errorMessage(logger, SIMPLE_ERR_MSG, 4, bladeIdx, arrayName);
-                }
-
-                if (
-                        led1Profile.idx() == eLED_None or
-                        led1Profile.idx() == eLED_None or
-                        led1Profile.idx() == eLED_None or
-                        led1Profile.idx() == eLED_None
-                   ) {
-                    return errorMessage(logger, wxTRANSLATE("Blade %d in array %s has no LEDs"), bladeIdx, arrayName);
-                }
+            if (
+                    led1Profile.idx() == eLED_None or
+                    led1Profile.idx() == eLED_None or
+                    led1Profile.idx() == eLED_None or
+                    led1Profile.idx() == eLED_None
+               ) {
+                return errorMessage(logger, wxTRANSLATE("Blade %d in array %s has no LEDs"), bladeIdx, arrayName);
             }
+        }
 
-            if (type.choiceIdx() == Blade::eServo) {
-                auto& servo{*type.selected<Servo>()};
-                auto sigPin{data::context(servo.sigPin_)};
+        if (type.choiceIdx() == Blade::eServo) {
+            auto& servo{*type.selected<Servo>()};
+            auto sigPin{data::context(servo.sigPin_)};
 
-                if (sigPin.val().empty())
-                    return errorMessage(logger, wxTRANSLATE("Blade %d in array %s missing signal pin"), bladeIdx, arrayName);
-            }
+            if (sigPin.val().empty())
+                return errorMessage(logger, wxTRANSLATE("Blade %d in array %s missing signal pin"), bladeIdx, arrayName);
         }
     }
 
+    return std::nullopt;
+}
+
+std::optional<std::string> checkPresetArrays(
+    const Config& config, logging::Logger& logger
+) {
     auto presetArrays{data::context(config.presetArrays_)};
 
     for (const auto& model : presetArrays.children()) {
@@ -220,86 +266,152 @@ std::optional<std::string> gen::preCheck(
         }
     }
 
-    constexpr cstring STYLE_ERR_STR{wxTRANSLATE("Bladestyle %zu in preset %zu (%s) in array %s has mismatched %s")};
-    for (const auto& model : presetArrays.children()) {
-        auto& presetArray{dynamic_cast<presets::Array&>(*model)};
+    return std::nullopt;
+}
 
-        auto arrayName{data::context(presetArray.name_)};
-        auto presets{data::context(presetArray.presets_)};
+std::optional<std::string> checkStyles(
+    const Config& config, logging::Logger& logger
+) {
+    auto& cache{gen::Cache::of(config)};
 
-        for (
-                size presetIdx{0};
-                presetIdx < presets.children().size();
-                ++presetIdx
-            ) {
-            const auto& model{presets.children()[presetIdx]};
+    // Styles of one preset or alias which haven't been checked as they are.
+    struct Scan {
+        uint64 key_;
+        std::vector<std::string_view> styles_;
+        std::optional<gen::Cache::Issue> issue_;
+    };
+
+    auto presetArrays{data::context(config.presetArrays_)};
+    auto aliases{data::context(config.styles_)};
+    const auto& arrayModels{presetArrays.children()};
+
+    std::vector<std::vector<uint64>> presetKeys(arrayModels.size());
+    std::vector<uint64> aliasKeys;
+
+    // One group per preset array, and one for the aliases, scanned in
+    // parallel.
+    std::vector<std::vector<Scan>> scans(arrayModels.size() + 1);
+
+    // Content views stay valid as long as the config is locked.
+    for (size arrayIdx{0}; arrayIdx < arrayModels.size(); ++arrayIdx) {
+        auto& presetArray{dynamic_cast<presets::Array&>(*arrayModels[arrayIdx])};
+
+        auto presets{data::context(presetArray.presets_)};
+        for (const auto& model : presets.children()) {
             auto& preset{dynamic_cast<presets::Preset&>(*model)};
 
-            auto presetName{data::context(preset.name_)};
-            auto styles{data::context(preset.styles_)};
+            const auto key{utils::hash::combine(
+                gen::Cache::eCheck_Preset, preset.styles_.hash()
+            )};
+            presetKeys[arrayIdx].push_back(key);
+            if (cache.findCheck(key)) continue;
 
-            for (
-                    size styleIdx{0};
-                    styleIdx < styles.children().size();
-                    ++styleIdx
-                ) {
-                const auto& model{styles.children()[styleIdx]};
+            auto& scan{scans[arrayIdx].emplace_back(Scan{.key_=key})};
+            auto styles{data::context(preset.styles_)};
+            for (const auto& model : styles.children()) {
                 auto& style{dynamic_cast<presets::Style&>(*model)};
-
-                auto content{data::context(style.content_)};
-                if (auto imbalance{getStyleImbalance(content.val())}) {
-                    return errorMessage(
-                        logger, STYLE_ERR_STR, styleIdx, presetIdx,
-                        presetName.val(), arrayName.val(),
-                        *imbalance
-                    );
-                }
+                scan.styles_.emplace_back(data::context(style.content_).val());
             }
         }
     }
 
-    auto styles{data::context(config.styles_)};
-    constexpr cstring ALIAS_ERR_STR{wxTRANSLATE("Style Alias %s has mismatched %s")};
-    for (const auto& model : styles.children()) {
+    for (const auto& model : aliases.children()) {
         auto& style{dynamic_cast<styles::Style&>(*model)};
 
-        auto name{data::context(style.name_)};
+        const auto key{utils::hash::combine(
+            gen::Cache::eCheck_Style, style.content_.hash()
+        )};
+        aliasKeys.push_back(key);
+        if (cache.findCheck(key)) continue;
 
-        auto content{data::context(style.content_)};
-        if (auto imbalance{getStyleImbalance(content.val())}) {
-            return errorMessage(
-                logger, ALIAS_ERR_STR, name.val(), *imbalance
-            );
-        }
+        scans.back().push_back({
+            .key_=key,
+            .styles_={data::context(style.content_).val()},
+        });
     }
 
-    auto buttons{data::context(config.buttons_)};
-    for (auto idx{0}; idx < buttons.children().size(); ++idx) {
-        auto& model{*buttons.children()[idx]};
-        auto& button{dynamic_cast<buttons::Button&>(model)};
+    std::erase_if(scans, [](const auto& group) { return group.empty(); });
+    utils::parallelFor(scans.size(), [&scans](size idx) {
+        for (auto& scan : scans[idx]) {
+            for (size styleIdx{0}; styleIdx < scan.styles_.size(); ++styleIdx) {
+                auto imbalance{getStyleImbalance(scan.styles_[styleIdx])};
+                if (not imbalance) continue;
 
-        auto type{data::context(button.type_)};
-        auto event{data::context(button.event_)};
-        auto pin{data::context(button.pin_)};
-
-        if (type.idx() == -1) {
-            return errorMessage(logger, wxTRANSLATE("Button %u doesn't have a type set."), idx);
+                scan.issue_ = {.idx_=styleIdx, .what_=std::move(*imbalance)};
+                break;
+            }
         }
-        if (event.idx() == -1) {
-            return errorMessage(logger, wxTRANSLATE("Button %u doesn't have its event set."), idx);
+    });
+
+    for (auto& group : scans) {
+        for (auto& scan : group) {
+            cache.storeCheck(scan.key_, std::move(scan.issue_));
         }
-        if (pin.val().empty()) {
-            return errorMessage(logger, wxTRANSLATE("Button %u doesn't have a pin set."), idx);
+    }
+
+    // Report in order, same as if all were checked one by one.
+    constexpr cstring STYLE_ERR_STR{wxTRANSLATE("Bladestyle %zu in preset %zu (%s) in array %s has mismatched %s")};
+    for (size arrayIdx{0}; arrayIdx < arrayModels.size(); ++arrayIdx) {
+        auto& presetArray{dynamic_cast<presets::Array&>(*arrayModels[arrayIdx])};
+
+        auto arrayName{data::context(presetArray.name_)};
+        auto presets{data::context(presetArray.presets_)};
+
+        for (
+                size presetIdx{0};
+                presetIdx < presets.children().size();
+                ++presetIdx
+            ) {
+            const auto& issue{*cache.findCheck(presetKeys[arrayIdx][presetIdx])};
+            if (not issue) continue;
+
+            auto& preset{presets.child<presets::Preset>(presetIdx)};
+            auto presetName{data::context(preset.name_)};
+            return errorMessage(
+                logger, STYLE_ERR_STR, issue->idx_, presetIdx,
+                presetName.val(), arrayName.val(),
+                issue->what_
+            );
         }
     }
 
+    constexpr cstring ALIAS_ERR_STR{wxTRANSLATE("Style Alias %s has mismatched %s")};
+    for (size idx{0}; idx < aliasKeys.size(); ++idx) {
+        const auto& issue{*cache.findCheck(aliasKeys[idx])};
+        if (not issue) continue;
+
+        auto name{data::context(aliases.child<styles::Style>(idx).name_)};
+        return errorMessage(
+            logger, ALIAS_ERR_STR, name.val(), issue->what_
+        );
+    }
+
     return std::nullopt;
 }
 
-namespace {
+std::optional<std::string> checkButton(
+    buttons::Button& button, size idx, logging::Logger& logger
+) {
+    auto type{data::context(button.type_)};
+    auto event{data::context(button.event_)};
+    auto pin{data::context(button.pin_)};
 
-std::optional<std::string> getStyleImbalance(const std::string& style) {
-    std::vector<char> depth;
+    if (type.idx() == -1) {
+        return errorMessage(logger, wxTRANSLATE("Button %u doesn't have a type set."), idx);
+    }
+    if (event.idx() == -1) {
+        return errorMessage(logger, wxTRANSLATE("Button %u doesn't have its event set."), idx);
+    }
+    if (pin.val().empty()) {
+        return errorMessage(logger, wxTRANSLATE("Button %u doesn't have a pin set."), idx);
+    }
+
+    return std::nullopt;
+}
+
+std::optional<std::string> getStyleImbalance(std::string_view style) {
+    // Rarely deep enough to leave SSO.
+    std::string depth;
 
     for (const char chr : style) {
         if (chr == '<' or chr == '(') {
@@ -331,4 +443,3 @@ std::optional<std::string> getStyleImbalance(const std::string& style) {
 }
 
 } // namespace
-
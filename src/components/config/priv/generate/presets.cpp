@@ -19,7 +19,10 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <cstring>
 #include <sstream>
+#include <unordered_set>
 
 #include "config/blades/bladeconfig.hpp"
 #include "config/blades/servo.hpp"
@@ -27,9 +30,13 @@
 #include "config/presets/array.hpp"
 #include "config/presets/preset.hpp"
 #include "config/presets/style.hpp"
+#include "config/priv/generate/cache.hpp"
 #include "config/priv/io.hpp"
+#include "config/priv/utils/style.hpp"
 #include "config/strings.hpp"
+#include "config/styles/style.hpp"
 #include "data/context.hpp"
+#include "utils/hash.hpp"
 #include "utils/string.hpp"
 
 using namespace config;
@@ -37,12 +44,138 @@ using namespace config::priv;
 
 namespace {
 
-void genPresets(std::ostream&, const Config&);
-void genBlades(std::ostream&, const Config&);
+constexpr std::string_view STYLE_PTR_PREFIX{"StylePtr<"};
+constexpr std::string_view STYLE_PTR_SUFFIX{">()"};
+constexpr std::string_view DEDUP_NAME_PREFIX{"DedupStyle"};
+
+std::string normalize(presets::Style&);
+std::string_view aliasable(std::string_view normalized);
+size entryBytes(const std::string& formatted);
+
+void genPresets(gen::Buffer&, const Config&, const gen::StyleAliases&);
+void genPreset(
+    gen::Buffer&,
+    presets::Preset&,
+    int32 numBlades,
+    const gen::StyleAliases&
+);
+void genBlades(gen::Buffer&, const Config&);
+void genBladeConfig(
+    gen::Buffer&, blades::BladeConfig&, const std::string& presetArrayName
+);
 
 } // namespace
 
-void gen::presets(std::ostream& out, const Config& config) {
+gen::StyleAliases gen::dedupStyles(const Config& config) {
+    StyleAliases ret;
+
+    const auto& dedupStyles{config.settings_.dedupStyles_};
+    if (not data::context(dedupStyles.enable_).val()) return ret;
+
+    const auto threshold{data::context(dedupStyles.threshold_).val()};
+    const auto numBlades{data::context(config.numBlades()).val()};
+
+    struct Repeat {
+        size order_;
+        size count_{0};
+        // Of the first one seen, as output in a preset.
+        size bytes_{0};
+    };
+    std::unordered_map<std::string, Repeat> repeats;
+
+    auto presetArrays{data::context(config.presetArrays_)};
+    for (const auto& model : presetArrays.children()) {
+        auto& presetArray{dynamic_cast<presets::Array&>(*model)};
+
+        auto presets{data::context(presetArray.presets_)};
+        for (const auto& model : presets.children()) {
+            auto& preset{dynamic_cast<presets::Preset&>(*model)};
+
+            auto styles{data::context(preset.styles_)};
+            for (auto idx{0}; idx < numBlades; ++idx) {
+                const auto& model{styles.children()[idx]};
+                auto& style{dynamic_cast<presets::Style&>(*model)};
+
+                auto normalized{normalize(style)};
+                if (aliasable(normalized).empty()) continue;
+
+                auto& repeat{repeats.try_emplace(
+                    std::move(normalized), Repeat{.order_=repeats.size()}
+                ).first->second};
+                if (repeat.count_++ == 0) {
+                    repeat.bytes_ = entryBytes(style.format(true));
+                }
+            }
+        }
+    }
+
+    std::vector<const decltype(repeats)::value_type *> candidates;
+    for (const auto& entry : repeats) {
+        if (entry.second.count_ > static_cast<size>(threshold)) {
+            candidates.push_back(&entry);
+        }
+    }
+    // Keep aliases in the order they're first used, for stable output.
+    std::ranges::sort(candidates, {}, [](const auto *entry) {
+        return entry->second.order_;
+    });
+
+    std::unordered_set<std::string> takenNames;
+    auto styles{data::context(config.styles_)};
+    for (const auto& model : styles.children()) {
+        auto& style{dynamic_cast<styles::Style&>(*model)};
+        takenNames.insert(data::context(style.name_).val());
+    }
+
+    size nameIdx{0};
+    for (const auto *entry : candidates) {
+        const auto& [normalized, repeat]{*entry};
+
+        auto aliasIdx{nameIdx};
+        std::string name;
+        do {
+            name = DEDUP_NAME_PREFIX;
+            name += std::to_string(++aliasIdx);
+        } while (takenNames.contains(name));
+
+        auto content{priv::style::format(
+            std::string{aliasable(normalized)}, true
+        )};
+
+        const auto refBytes{
+            STYLE_PTR_PREFIX.size() + name.size() + STYLE_PTR_SUFFIX.size() + 4
+        };
+        // //PROFFIECONFIG DEDUP_ALIAS\nusing name = content;\n\n
+        const auto declBytes{
+            PC_OPT_STR.size() + std::strlen(DEDUP_ALIAS_STR) + 1 +
+            name.size() + content.size() + 12
+        };
+
+        // Short styles used only a few times can cost more than they save.
+        const auto before{repeat.count_ * repeat.bytes_};
+        const auto after{(repeat.count_ * refBytes) + declBytes};
+        if (after >= before) continue;
+
+        nameIdx = aliasIdx;
+        ret.saved_ += before - after;
+        ret.hash_ = utils::hash::combine(
+            ret.hash_,
+            utils::hash::single(normalized),
+            utils::hash::single(name)
+        );
+        ret.lookup_.emplace(normalized, ret.aliases_.size());
+        ret.aliases_.push_back({
+            .name_=std::move(name),
+            .content_=std::move(content),
+        });
+    }
+
+    return ret;
+}
+
+void gen::presets(
+    gen::Buffer& out, const Config& config, const StyleAliases& aliases
+) {
     out << "#ifdef CONFIG_PRESETS\n";
 
     auto injections{data::context(config.injections_)};
@@ -54,7 +187,7 @@ void gen::presets(std::ostream& out, const Config& config) {
     }
     if (not injections.children().empty()) out << '\n';
 
-    genPresets(out, config);
+    genPresets(out, config, aliases);
     genBlades(out, config);
 
     out << "#endif\n";
@@ -62,7 +195,57 @@ void gen::presets(std::ostream& out, const Config& config) {
 
 namespace {
 
-void genPresets(std::ostream& out, const Config& config) {
+std::string normalize(presets::Style& style) {
+    auto content{data::context(style.content_).val()};
+    utils::trimWhitespaceOutsideString(content);
+    return content;
+}
+
+/**
+ * @return The StylePtr<> template argument of normalized content if it's
+ * worth aliasing, otherwise empty.
+ */
+std::string_view aliasable(std::string_view normalized) {
+    if (
+            not normalized.starts_with(STYLE_PTR_PREFIX) or
+            not normalized.ends_with(STYLE_PTR_SUFFIX)
+       ) {
+        return {};
+    }
+
+    // Comments can't survive normalization.
+    if (
+            normalized.find("//") != std::string_view::npos or
+            normalized.find("/*") != std::string_view::npos
+       ) {
+        return {};
+    }
+
+    normalized.remove_prefix(STYLE_PTR_PREFIX.size());
+    normalized.remove_suffix(STYLE_PTR_SUFFIX.size());
+
+    // Already refers to a single style, probably an alias itself.
+    const auto isName{std::ranges::all_of(normalized, [](char chr) {
+        return std::isalnum(chr) or chr == '_';
+    })};
+    if (isName) return {};
+
+    return normalized;
+}
+
+/**
+ * @return Size of a formatted style as output in a preset by genPreset()
+ */
+size entryBytes(const std::string& formatted) {
+    const auto lines{static_cast<size>(std::ranges::count(formatted, '\n')) + 1};
+    // Indent on each line, and the trailing ",\n"
+    return formatted.size() + (lines * 2) + 2;
+}
+
+void genPresets(
+    gen::Buffer& out, const Config& config, const gen::StyleAliases& aliases
+) {
+    auto& cache{gen::Cache::of(config)};
     auto numBlades{data::context(config.numBlades())};
 
     auto presetArrays{data::context(config.presetArrays_)};
@@ -76,211 +259,310 @@ void genPresets(std::ostream& out, const Config& config) {
         for (const auto& model : presets.children()) {
             auto& preset{dynamic_cast<presets::Preset&>(*model)};
 
-            auto fontDir{data::context(preset.fontDir_)};
-            auto track{data::context(preset.track_)};
-            out << "\t{ \"" << fontDir.val() << "\", \""
-                << track.val() << "\",\n";
-
-            auto styles{data::context(preset.styles_)};
-            for (auto idx{0}; idx < numBlades.val(); ++idx) {
-                const auto& model{styles.children()[idx]};
-                auto& style{dynamic_cast<presets::Style&>(*model)};
-
-                std::string line;
-
-                auto comment{data::context(style.comment_)};
-                auto commentStr{comment.val()};
-
-                utils::trimSurroundingWhitespace(commentStr);
-
-                if (not commentStr.empty()) {
-                    std::istringstream commentStream{commentStr};
-                    out << "\t\t/*\n";
-                    while (std::getline(commentStream, line)) {
-                        out << "\t\t * " << line << '\n';
-                    }
-                    out << "\t\t */\n";
-                }
+            // Styles past numBlades are kept around but not output.
+            const auto key{utils::hash::combine(
+                gen::Cache::ePreset,
+                preset.hash(),
+                utils::hash::single(numBlades.val()),
+                aliases.hash_
+            )};
+            out << cache.get(key, [&](gen::Buffer& fragment) {
+                genPreset(fragment, preset, numBlades.val(), aliases);
+            });
+        }
+        out << "};\n";
+    }
+}
 
-                auto styleStr{style.format(true)};
-                std::istringstream styleStream(styleStr);
-                while (std::getline(styleStream, line)) {
-                    out << "\t\t" << line;
+void genPreset(
+    gen::Buffer& out,
+    presets::Preset& preset,
+    int32 numBlades,
+    const gen::StyleAliases& aliases
+) {
+    auto fontDir{data::context(preset.fontDir_)};
+    auto track{data::context(preset.track_)};
+    out << "\t{ \"" << fontDir.val() << "\", \""
+        << track.val() << "\",\n";
+
+    auto styles{data::context(preset.styles_)};
+    for (auto idx{0}; idx < numBlades; ++idx) {
+        const auto& model{styles.children()[idx]};
+        auto& style{dynamic_cast<presets::Style&>(*model)};
+
+        std::string line;
+
+        auto comment{data::context(style.comment_)};
+        auto commentStr{comment.val()};
+
+        utils::trimSurroundingWhitespace(commentStr);
+
+        if (not commentStr.empty()) {
+            std::istringstream commentStream{commentStr};
+            out << "\t\t/*\n";
+            while (std::getline(commentStream, line)) {
+                out << "\t\t * " << line << '\n';
+            }
+            out << "\t\t */\n";
+        }
 
-                    if (styleStream.eof())
-                        out << ",\n";
-                    else
-                        out << '\n';
-                }
+        if (not aliases.lookup_.empty()) {
+            const auto iter{aliases.lookup_.find(normalize(style))};
+            if (iter != aliases.lookup_.end()) {
+                const auto& alias{aliases.aliases_[iter->second]};
+                out << "\t\t" << STYLE_PTR_PREFIX << alias.name_
+                    << STYLE_PTR_SUFFIX << ",\n";
+                continue;
             }
+        }
 
-            auto presetName{data::context(preset.name_)};
-            out << "\t\t\"" << presetName.val() << "\"\n\t},\n";
+        auto styleStr{style.format(true)};
+        std::istringstream styleStream(styleStr);
+        while (std::getline(styleStream, line)) {
+            out << "\t\t" << line;
+
+            if (styleStream.eof())
+                out << ",\n";
+            else
+                out << '\n';
         }
-        out << "};\n";
     }
+
+    auto presetName{data::context(preset.name_)};
+    out << "\t\t\"" << presetName.val() << "\"\n\t},\n";
 }
 
-void genBlades(std::ostream& out, const Config& config) {
+void genBlades(gen::Buffer& out, const Config& config) {
+    auto& cache{gen::Cache::of(config)};
+
     out << "BladeConfig blades[] = {\n";
 
     auto bladeConfigs{data::context(config.bladeConfigs_)};
+    auto presetArrays{data::context(config.presetArrays_)};
     for (const auto& model : bladeConfigs.children()) {
         auto& bladeConfig{dynamic_cast<blades::BladeConfig&>(*model)};
 
-        if (data::context(bladeConfig.noBladeId_).val()) {
-            out << "\t{ NO_BLADE,\n";
-        } else {
-            auto id{data::context(bladeConfig.id_)};
-            out << "\t{ " << id.val() << ",\n";
-        }
+        auto arrayChoice{data::context(bladeConfig.presetArray_.choice())};
+        const auto& arrayModel{presetArrays.children()[arrayChoice.idx()]};
+        auto& presetArray{dynamic_cast<presets::Array&>(*arrayModel)};
+        auto presetArrayName{data::context(presetArray.name_)};
 
-        auto blades{data::context(bladeConfig.blades_)};
-        for (const auto& model : blades.children()) {
-            auto& blade{dynamic_cast<blades::Blade&>(*model)};
+        // The array is only referred to by its name.
+        const auto key{utils::hash::combine(
+            gen::Cache::eBlade_Config,
+            bladeConfig.hash(),
+            utils::hash::single(presetArrayName.val())
+        )};
+        out << cache.get(key, [&](gen::Buffer& fragment) {
+            genBladeConfig(fragment, bladeConfig, presetArrayName.val());
+        });
+    }
+    out << "};\n";
+}
 
-            auto type{data::context(blade.type())};
+void genBladeConfig(
+    gen::Buffer& out,
+    blades::BladeConfig& bladeConfig,
+    const std::string& presetArrayName
+) {
+    if (data::context(bladeConfig.noBladeId_).val()) {
+        out << "\t{ NO_BLADE,\n";
+    } else {
+        auto id{data::context(bladeConfig.id_)};
+        out << "\t{ " << id.val() << ",\n";
+    }
 
-            if (type.choiceIdx() == blades::Blade::eUnassigned) {
-                out << "\t\tSimpleBladePtr<NoLED, NoLED, NoLED, NoLED, -1, -1, -1, -1>(),\n";
-                continue;
-            }
+    auto blades{data::context(bladeConfig.blades_)};
+    for (const auto& model : blades.children()) {
+        auto& blade{dynamic_cast<blades::Blade&>(*model)};
 
-            if (type.choiceIdx() == blades::Blade::eServo) {
-                auto& servo{*type.selected<blades::Servo>()};
-                auto pin{data::context(servo.sigPin_)};
+        auto type{data::context(blade.type())};
 
-                out << "\t\tServoBladePtr<" << pin.val() << ">(),\n";
-                continue;
-            }
+        if (type.choiceIdx() == blades::Blade::eUnassigned) {
+            out << "\t\tSimpleBladePtr<NoLED, NoLED, NoLED, NoLED, -1, -1, -1, -1>(),\n";
+            continue;
+        }
 
-            std::stringstream bladeStr;
-            auto brightness{data::context(blade.brightness_)};
-            if (brightness.val() != 100) {
-                bladeStr << "DimBlade(" << brightness.val() << ", ";
-            }
+        if (type.choiceIdx() == blades::Blade::eServo) {
+            auto& servo{*type.selected<blades::Servo>()};
+            auto pin{data::context(servo.sigPin_)};
+
+            out << "\t\tServoBladePtr<" << pin.val() << ">(),\n";
+            continue;
+        }
 
-            if (type.choiceIdx() == blades::Blade::eWS281X) {
-                auto& ws281x{blade.ws281x()};
+        gen::Buffer bladeStr;
+        auto brightness{data::context(blade.brightness_)};
+        if (brightness.val() != 100) {
+            bladeStr << "DimBlade(" << brightness.val() << ", ";
+        }
 
-                auto length{data::context(ws281x.length_)};
-                auto dataPin{data::context(ws281x.dataPin_)};
+        if (type.choiceIdx() == blades::Blade::eWS281X) {
+            auto& ws281x{blade.ws281x()};
 
-                bladeStr << "WS281XBladePtr<" << length.val() << ", " << dataPin.val();
-                bladeStr << ", Color8::";
+            auto length{data::context(ws281x.length_)};
+            auto dataPin{data::context(ws281x.dataPin_)};
 
-                if (data::context(ws281x.hasWhite_).val()) {
-                    auto order4{data::context(ws281x.colorOrder4_)};
-                    bool whiteFirst{
-                        order4.idx() >= eOrder4_White_First_Start and
-                        order4.idx() <= eOrder4_White_First_End
-                    };
+            bladeStr << "WS281XBladePtr<" << length.val() << ", " << dataPin.val();
+            bladeStr << ", Color8::";
 
-                    if (whiteFirst) {
-                        if (data::context(ws281x.useRgbWithWhite_).val()) {
-                            bladeStr << 'W';
-                        } else bladeStr << 'w';
+            if (data::context(ws281x.hasWhite_).val()) {
+                auto order4{data::context(ws281x.colorOrder4_)};
+                bool whiteFirst{
+                    order4.idx() >= eOrder4_White_First_Start and
+                    order4.idx() <= eOrder4_White_First_End
+                };
 
-                        auto strIdx{order4.idx() - eOrder4_White_First_Start};
-                        bladeStr << ORDER_STRS[strIdx];
-                    } else {
-                        bladeStr << ORDER_STRS[order4.idx()];
+                if (whiteFirst) {
+                    if (data::context(ws281x.useRgbWithWhite_).val()) {
+                        bladeStr << 'W';
+                    } else bladeStr << 'w';
 
-                        if (data::context(ws281x.useRgbWithWhite_).val()) {
-                            bladeStr << 'W';
-                        } else bladeStr << 'w';
-                    }
+                    auto strIdx{order4.idx() - eOrder4_White_First_Start};
+                    bladeStr << ORDER_STRS[strIdx];
                 } else {
-                    auto order3{data::context(ws281x.colorOrder3_)};
-                    bladeStr << ORDER_STRS[order3.idx()];
+                    bladeStr << ORDER_STRS[order4.idx()];
+
+                    if (data::context(ws281x.useRgbWithWhite_).val()) {
+                        bladeStr << 'W';
+                    } else bladeStr << 'w';
                 }
+            } else {
+                auto order3{data::context(ws281x.colorOrder3_)};
+                bladeStr << ORDER_STRS[order3.idx()];
+            }
 
-                bladeStr << ", " << POWER_PINS_STR;
+            bladeStr << ", " << POWER_PINS_STR;
 
-                // Generate a list of selected first and then use that to
-                // generate the actual output so that it's known when on the
-                // last item for ", "
-                std::vector<size> selected;
+            // Generate a list of selected first and then use that to
+            // generate the actual output so that it's known when on the
+            // last item for ", "
+            std::vector<size> selected;
 
-                auto powerPins{data::context(ws281x.powerPins_)};
-                for (size idx{0}; idx < powerPins.items().size(); ++idx) {
-                    if (powerPins.selected()[idx])
-                        selected.push_back(idx);
-                }
+            auto powerPins{data::context(ws281x.powerPins_)};
+            for (size idx{0}; idx < powerPins.items().size(); ++idx) {
+                if (powerPins.selected()[idx])
+                    selected.push_back(idx);
+            }
 
-                for (auto idx : selected) {
-                    if (idx != selected.front())
-                        bladeStr << ", ";
+            for (auto idx : selected) {
+                if (idx != selected.front())
+                    bladeStr << ", ";
 
-                    bladeStr << powerPins.items()[idx];
-                }
+                bladeStr << powerPins.items()[idx];
+            }
 
-                bladeStr << ">>()";
-            } else if (type.choiceIdx() == blades::Blade::eSimple) {
-                auto& simple{blade.simple()};
+            bladeStr << ">>()";
+        } else if (type.choiceIdx() == blades::Blade::eSimple) {
+            auto& simple{blade.simple()};
 
-                bladeStr << "SimpleBladePtr<";
+            bladeStr << "SimpleBladePtr<";
 
-                auto outputLEDProfile{[&bladeStr](blades::Simple::LED& led) {
-                    auto profile{data::context(led.profile_)};
+            auto outputLEDProfile{[&bladeStr](blades::Simple::LED& led) {
+                auto profile{data::context(led.profile_)};
 
-                    bladeStr << LED_STRS[profile.idx()];
+                bladeStr << LED_STRS[profile.idx()];
 
-                    auto resistance{data::context(led.resistance_)};
-                    if (resistance.enabled()) {
-                        bladeStr << '<' << resistance.val() << '>';
-                    }
+                auto resistance{data::context(led.resistance_)};
+                if (resistance.enabled()) {
+                    bladeStr << '<' << resistance.val() << '>';
+                }
 
-                    bladeStr << ", ";
-                }};
-                outputLEDProfile(simple.led1_);
-                outputLEDProfile(simple.led2_);
-                outputLEDProfile(simple.led3_);
-                outputLEDProfile(simple.led4_);
-
-                auto outputLEDPower{[&bladeStr](blades::Simple::LED& led) {
-                    auto powerPin{data::context(led.powerPin_)};
-                    
-                    if (powerPin.enabled()) {
-                        bladeStr << powerPin.val();
-                    } else bladeStr << "-1";
-                }};
-                outputLEDPower(simple.led1_);
                 bladeStr << ", ";
-                outputLEDPower(simple.led2_);
-                bladeStr << ", ";
-                outputLEDPower(simple.led3_);
-                bladeStr << ", ";
-                outputLEDPower(simple.led4_);
+            }};
+            outputLEDProfile(simple.led1_);
+            outputLEDProfile(simple.led2_);
+            outputLEDProfile(simple.led3_);
+            outputLEDProfile(simple.led4_);
+
+            auto outputLEDPower{[&bladeStr](blades::Simple::LED& led) {
+                auto powerPin{data::context(led.powerPin_)};
+                
+                if (powerPin.enabled()) {
+                    bladeStr << powerPin.val();
+                } else bladeStr << "-1";
+            }};
+            outputLEDPower(simple.led1_);
+            bladeStr << ", ";
+            outputLEDPower(simple.led2_);
+            bladeStr << ", ";
+            outputLEDPower(simple.led3_);
+            bladeStr << ", ";
+            outputLEDPower(simple.led4_);
+
+            bladeStr << ">()";
+        }
 
-                bladeStr << ">()";
-            }
+        if (brightness.val() != 100) bladeStr << ')';
 
-            if (brightness.val() != 100) bladeStr << ')';
+        auto splits{data::context(blade.ws281x().splits_)};
 
-            auto splits{data::context(blade.ws281x().splits_)};
+        if (
+                type.choiceIdx() == blades::Blade::eSimple or
+                (type.choiceIdx() == blades::Blade::eWS281X and
+                 splits.children().empty())
+           ) {
+            out << "\t\t" << bladeStr.str() << ",\n";
+            continue;
+        }
+
+        for (const auto& model : splits.children()) {
+            auto& split{dynamic_cast<blades::WS281X::Split&>(*model)};
+
+            auto type{data::context(split.type_)};
+
+            using enum blades::WS281X::Split::Type;
 
             if (
-                    type.choiceIdx() == blades::Blade::eSimple or
-                    (type.choiceIdx() == blades::Blade::eWS281X and
-                     splits.children().empty())
+                    type.selected() == eStandard or
+                    type.selected() == eReverse or
+                    type.selected() == eList
                ) {
-                out << "\t\t" << bladeStr.str() << ",\n";
-                continue;
-            }
+                out << "\t\t";
+
+                auto brightness{data::context(split.brightness_)};
+                if (brightness.val() != 100) {
+                    out << "DimBlade(" << brightness.val() << ", ";
+                }
+
+                if (type.selected() == eStandard) {
+                    auto start{data::context(split.start_)};
+                    auto end{data::context(split.end_)};
 
-            for (const auto& model : splits.children()) {
-                auto& split{dynamic_cast<blades::WS281X::Split&>(*model)};
+                    out << "SubBlade(" << start.val() << ", "
+                        << end.val() << ", ";
+                } else if (type.selected() == eReverse) {
+                    auto start{data::context(split.start_)};
+                    auto end{data::context(split.end_)};
 
-                auto type{data::context(split.type_)};
+                    out << "SubBladeReverse(" << start.val() << ", "
+                        << end.val() << ", ";
+                } else if (type.selected() == eList) {
+                    auto list{data::context(split.list_)};
 
-                using enum blades::WS281X::Split::Type;
+                    auto listStr{list.val()};
+                    if (listStr.back() == ',') listStr.pop_back();
 
-                if (
-                        type.selected() == eStandard or
-                        type.selected() == eReverse or
-                        type.selected() == eList
-                   ) {
+                    out << "SubBladeWithList<" << listStr << ">(";
+                }
+
+                
+                if (&split == &*splits.children().front()) {
+                    out << bladeStr.str() << ')';                    
+                } else out << "nullptr)";
+
+                if (brightness.val() != 100) out << ')';
+
+                out << ",\n";
+            }
+
+            if (
+                    type.selected() == eStride or
+                    type.selected() == eZig_Zag
+               ) {
+                auto segments{data::context(split.segments_)};
+
+                for (auto idx{0}; idx < segments.val(); ++idx) {
                     out << "\t\t";
 
                     auto brightness{data::context(split.brightness_)};
@@ -288,29 +570,26 @@ void genBlades(std::ostream& out, const Config& config) {
                         out << "DimBlade(" << brightness.val() << ", ";
                     }
 
-                    if (type.selected() == eStandard) {
-                        auto start{data::context(split.start_)};
-                        auto end{data::context(split.end_)};
-
-                        out << "SubBlade(" << start.val() << ", "
-                            << end.val() << ", ";
-                    } else if (type.selected() == eReverse) {
-                        auto start{data::context(split.start_)};
-                        auto end{data::context(split.end_)};
-
-                        out << "SubBladeReverse(" << start.val() << ", "
-                            << end.val() << ", ";
-                    } else if (type.selected() == eList) {
-                        auto list{data::context(split.list_)};
-
-                        auto listStr{list.val()};
-                        if (listStr.back() == ',') listStr.pop_back();
-
-                        out << "SubBladeWithList<" << listStr << ">(";
+                    auto start{data::context(split.start_)};
+                    auto end{data::context(split.end_)};
+
+                    if (type.selected() == eStride) {
+                        const auto endVal{
+                            end.val() - (segments.val() - idx - 1)
+                        };
+
+                        out << "SubBladeWithStride(";
+                        out << start.val() + idx << ", ";
+                        out << endVal << ", ";
+                        out << segments.val() << ", ";
+                    } else if (type.selected() == eZig_Zag) {
+                        out << "SubBladeZZ(";
+                        out << start.val() << ", " ;
+                        out << end.val() << ", ";
+                        out << segments.val() << ", " << idx << ", ";
                     }
 
-                    
-                    if (&split == &*splits.children().front()) {
+                    if (idx == 0 and &split == &*splits.children().front()) {
                         out << bladeStr.str() << ')';                    
                     } else out << "nullptr)";
 
@@ -318,70 +597,20 @@ void genBlades(std::ostream& out, const Config& config) {
 
                     out << ",\n";
                 }
-
-                if (
-                        type.selected() == eStride or
-                        type.selected() == eZig_Zag
-                   ) {
-                    auto segments{data::context(split.segments_)};
-
-                    for (auto idx{0}; idx < segments.val(); ++idx) {
-                        out << "\t\t";
-
-                        auto brightness{data::context(split.brightness_)};
-                        if (brightness.val() != 100) {
-                            out << "DimBlade(" << brightness.val() << ", ";
-                        }
-
-                        auto start{data::context(split.start_)};
-                        auto end{data::context(split.end_)};
-
-                        if (type.selected() == eStride) {
-                            const auto endVal{
-                                end.val() - (segments.val() - idx - 1)
-                            };
-
-                            out << "SubBladeWithStride(";
-                            out << start.val() + idx << ", ";
-                            out << endVal << ", ";
-                            out << segments.val() << ", ";
-                        } else if (type.selected() == eZig_Zag) {
-                            out << "SubBladeZZ(";
-                            out << start.val() << ", " ;
-                            out << end.val() << ", ";
-                            out << segments.val() << ", " << idx << ", ";
-                        }
-
-                        if (idx == 0 and &split == &*splits.children().front()) {
-                            out << bladeStr.str() << ')';                    
-                        } else out << "nullptr)";
-
-                        if (brightness.val() != 100) out << ')';
-
-                        out << ",\n";
-                    }
-                }
             }
         }
+    }
 
-        auto arrayChoice{data::context(bladeConfig.presetArray_.choice())};
-        auto presetArrays{data::context(config.presetArrays_)};
-        const auto& arrayModel{presetArrays.children()[arrayChoice.idx()]};
-        auto& presetArray{dynamic_cast<presets::Array&>(*arrayModel)};
-        auto presetArrayName{data::context(presetArray.name_)};
-        
-        out << "\t\tCONFIGARRAY(" << presetArrayName.val() << ")";
-
-        auto bladeConfigName{data::context(bladeConfig.name_)};
-        if (not bladeConfigName.val().empty()) {
-            out << ", \"";
-            out << bladeConfigName.val();
-            out << '\"';
-        }
+    out << "\t\tCONFIGARRAY(" << presetArrayName << ")";
 
-        out << "\n\t},\n";
+    auto bladeConfigName{data::context(bladeConfig.name_)};
+    if (not bladeConfigName.val().empty()) {
+        out << ", \"";
+        out << bladeConfigName.val();
+        out << '\"';
     }
-    out << "};\n";
+
+    out << "\n\t},\n";
 }
 
 } // namespace
@@ -19,13 +19,44 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "config/config.hpp"
+#include "config/priv/generate/buffer.hpp"
+#include "utils/types.hpp"
 
 namespace config::priv::gen {
 
-void presets(std::ostream&, const Config&);
+/**
+ * Preset styles repeated often enough to be output once as an alias in
+ * CONFIG_STYLES and referred to by name from the presets.
+ */
+struct StyleAliases {
+    struct Alias {
+        std::string name_;
+        // Template argument of the StylePtr<>, formatted.
+        std::string content_;
+    };
+
+    std::vector<Alias> aliases_;
+    // Normalized preset style content to index in aliases_.
+    std::unordered_map<std::string, size> lookup_;
+
+    // Changes whenever what the presets render to does.
+    uint64 hash_{0};
+    // Approximate header bytes saved by aliasing.
+    size saved_{0};
+};
+
+/**
+ * Find the preset styles repeated more than the configured threshold, if
+ * style deduplication is enabled.
+ */
+StyleAliases dedupStyles(const Config&);
+
+void presets(Buffer&, const Config&, const StyleAliases&);
 
 } // namespace config::priv::gen
 
@@ -22,7 +22,7 @@
 using namespace config;
 using namespace config::priv;
 
-void gen::prop(std::ostream& out, const Config& config) {
+void gen::prop(gen::Buffer& out, const Config& config) {
     auto *prop{config.prop()};
 
     if (prop == nullptr) return;
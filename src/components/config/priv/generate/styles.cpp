@@ -21,39 +21,69 @@
 
 #include <sstream>
 
+#include "config/priv/generate/cache.hpp"
+#include "config/priv/io.hpp"
+#include "config/strings.hpp"
 #include "config/styles/style.hpp"
 #include "data/context.hpp"
+#include "utils/hash.hpp"
 
 using namespace config;
 using namespace config::priv;
 
-void gen::styles(std::ostream& out, const Config& config) {
+namespace {
+
+void genStyle(gen::Buffer&, styles::Style&);
+
+} // namespace
+
+void gen::styles(
+    gen::Buffer& out, const Config& config, const StyleAliases& aliases
+) {
     out << "#ifdef CONFIG_STYLES\n";
 
+    auto& cache{Cache::of(config)};
+
     auto ctxt{data::context(config.styles_)};
     for (auto& model : ctxt.children()) {
         auto& style{dynamic_cast<styles::Style&>(*model)};
 
-        auto name{data::context(style.name_)};
-        auto comment{data::context(style.comments_)};
-        auto formatted{style.format(true)};
+        const auto key{utils::hash::combine(Cache::eStyle, style.hash())};
+        out << cache.get(key, [&](Buffer& fragment) {
+            genStyle(fragment, style);
+        });
+    }
 
-        if (not comment.val().empty()) {
-            out << "/*\n";
+    for (const auto& alias : aliases.aliases_) {
+        out << PC_OPT_STR << DEDUP_ALIAS_STR << '\n';
+        out << "using " << alias.name_ << " = " << alias.content_ << ";\n\n";
+    }
 
-            std::istringstream stream(comment.val());
-            std::string line;
-            while (std::getline(stream, line)) {
-                out << " * " << line << '\n';;
-            }
+    out << "#endif\n";
+}
+
+namespace {
+
+void genStyle(gen::Buffer& out, styles::Style& style) {
+    auto name{data::context(style.name_)};
+    auto comment{data::context(style.comments_)};
+    auto formatted{style.format(true)};
 
-            out << " */\n";
+    if (not comment.val().empty()) {
+        out << "/*\n";
+
+        std::istringstream stream(comment.val());
+        std::string line;
+        while (std::getline(stream, line)) {
+            out << " * " << line << '\n';;
         }
 
-        out << "using " << name.val() << " = " << formatted;
-        out << ";\n\n";
+        out << " */\n";
     }
 
-    out << "#endif\n";
+    out << "using " << name.val() << " = " << formatted;
+    out << ";\n\n";
 }
 
+} // namespace
+
@@ -19,13 +19,13 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <iostream>
-
 #include "config/config.hpp"
+#include "config/priv/generate/buffer.hpp"
+#include "config/priv/generate/presets.hpp"
 
 namespace config::priv::gen {
 
-void styles(std::ostream&, const Config&);
+void styles(Buffer&, const Config&, const StyleAliases&);
 
 } // namespace config::priv::gen
 
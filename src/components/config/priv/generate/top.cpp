@@ -19,6 +19,9 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <cmath>
+
 #include "config/blades/bladeconfig.hpp"
 #include "config/priv/io.hpp"
 #include "config/settings/define.hpp"
@@ -30,12 +33,12 @@ using namespace config::priv;
 
 namespace {
 
-void forGeneral(std::ostream&, const Config&);
-void forProp(std::ostream&, const Config&);
+void forGeneral(gen::Buffer&, const Config&);
+void forProp(gen::Buffer&, const Config&);
 
 } // namespace
 
-void gen::top(std::ostream& out, const Config& config) {
+void gen::top(gen::Buffer& out, const Config& config) {
     out << "#ifdef CONFIG_TOP\n";
     forGeneral(out, config);
     forProp(out, config);
@@ -44,27 +47,27 @@ void gen::top(std::ostream& out, const Config& config) {
 
 namespace {
 
-void outputOpt(std::ostream& out, std::string_view opt) {
+void outputOpt(gen::Buffer& out, std::string_view opt) {
     out << priv::PC_OPT_STR << opt << '\n';
 }
 
 template <typename VAL>
-void outputOpt(std::ostream& out, std::string_view opt, const VAL& val) {
+void outputOpt(gen::Buffer& out, std::string_view opt, const VAL& val) {
     out << priv::PC_OPT_STR << opt << ' ' << val << '\n';
 }
 
-void outputDefine(std::ostream& out, std::string_view define) {
+void outputDefine(gen::Buffer& out, std::string_view define) {
     out << priv::DEFINE_STR << define << '\n';
 }
 
 template <typename VAL>
 void outputDefine(
-    std::ostream& out, const std::string& define, const VAL& val
+    gen::Buffer& out, const std::string& define, const VAL& val
 ) {
     out << priv::DEFINE_STR << define << ' ' << val << '\n';
 }
 
-void forGeneral(std::ostream& out, const Config& config) {
+void forGeneral(gen::Buffer& out, const Config& config) {
     const auto& settings{config.settings_};
 
     if (data::context(settings.massStorage_).val()) {
@@ -75,6 +78,11 @@ void forGeneral(std::ostream& out, const Config& config) {
         outputOpt(out, ENABLE_WEBUSB_STR);
     }
 
+    if (data::context(settings.dedupStyles_.enable_).val()) {
+        auto threshold{data::context(settings.dedupStyles_.threshold_)};
+        outputOpt(out, DEDUP_STYLES_STR, threshold.val());
+    }
+
     auto osVersion{config.os()->version_};
     const auto osIsOrOver8{utils::Version(8).compare(osVersion) <= 0};
 
@@ -394,7 +402,7 @@ void forGeneral(std::ostream& out, const Config& config) {
     }
 }
 
-void forProp(std::ostream& out, const Config& config) {
+void forProp(gen::Buffer& out, const Config& config) {
     const auto *prop{config.prop()};
 
     if (prop == nullptr)
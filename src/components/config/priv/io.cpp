@@ -21,7 +21,7 @@
 
 #include <cstring>
 #include <fstream>
-#include <sstream>
+#include <variant>
 
 #include <wx/translation.h>
 
@@ -33,6 +33,7 @@
 #include "config/presets/array.hpp"
 #include "config/presets/preset.hpp"
 #include "config/priv/data.hpp"
+#include "config/priv/generate/cache.hpp"
 #include "config/priv/generate/check/check.hpp"
 #include "config/priv/io.hpp"
 #include "config/priv/generate/top.hpp"
@@ -40,17 +41,20 @@
 #include "config/priv/generate/presets.hpp"
 #include "config/priv/generate/buttons.hpp"
 #include "config/priv/generate/styles.hpp"
+#include "config/priv/parse/lexer.hpp"
 #include "config/priv/parse/top.hpp"
 #include "config/priv/parse/prop.hpp"
 #include "config/priv/parse/presets.hpp"
 #include "config/priv/parse/buttons.hpp"
 #include "config/priv/parse/styles.hpp"
 #include "config/priv/parse/utils.hpp"
+#include "config/priv/utils/style.hpp"
 #include "config/settings/define.hpp"
 #include "config/settings/settings.hpp"
 #include "log/branch.hpp"
 #include "log/context.hpp"
 #include "utils/files.hpp"
+#include "utils/parallel.hpp"
 #include "utils/string.hpp"
 #include "utils/types.hpp"
 
@@ -59,7 +63,31 @@ using namespace config::priv;
 
 namespace {
 
-std::string extractSection(std::istream&);
+/**
+ * A top-level #include or #ifdef section, with its results from the
+ * concurrent stages.
+ */
+struct Item {
+    // Include path or section name.
+    std::string name_;
+    bool isSection_{false};
+    std::string_view content_;
+    size line_{};
+
+    std::variant<
+        std::monostate,
+        parse::ParsedPresets,
+        std::vector<parse::ParsedStyle>
+    > parsed_;
+    logging::Branch *branch_{nullptr};
+};
+
+/**
+ * Skip to the end of the section, leaving the stream past its #endif.
+ *
+ * @return Offset of the #endif, or the end if there is none.
+ */
+size findSectionEnd(parse::Lexer&);
 
 } // namespace
 
@@ -71,7 +99,7 @@ std::optional<std::string> io::parse(
     // Loading the entire file into memory significantly increases performance.
     // Otherwise, all the little single-char read/unget and short seeks tend to
     // result in misses and syscalls.
-    std::stringstream stream;
+    std::string buf;
     {
         // std:ios::ate opens with tellg at end, so tellg() is size.
         std::ifstream file(
@@ -88,77 +116,160 @@ std::optional<std::string> io::parse(
         if (size > 1'000'000'000)
             return errorMessage(logger, wxTRANSLATE("Config is too large (%zu)"), size);
 
-        std::string buf(size, 0);
+        buf.resize(size);
 
         file.seekg(0);
         file.read(buf.data(), size);
 
         if (file.bad())
             return errorMessage(logger, wxTRANSLATE("Failed reading file"));
+    }
+
+    // Parsing happens in stages so that the bulk of it, which doesn't touch
+    // the config, can be spread across threads:
+    //
+    // 1. Find the top-level includes and sections.
+    // 2. Split/read the presets and styles sections, concurrently.
+    // 3. Read each preset array and format each style, concurrently.
+    // 4. Apply everything to the config in file order.
+    std::vector<Item> items;
+    {
+        parse::Lexer lexer{buf};
+
+        while (lexer.good()) {
+            parse::Lexer::Comments commentData;
+            (void)lexer.extractComments(commentData);
+
+            const auto chr{lexer.get()};
+            if (not lexer.good()) break;
+
+            if (chr != '#')
+                continue;
+
+            auto directive{parse::cppDirective(
+                lexer, logger.bverbose("Parsing directive...")
+            )};
+
+            if (directive.type_ == parse::CPPDirective::Type::Include) {
+                items.push_back({.name_=std::move(directive.buf1_)});
+            } else if (directive.type_ == parse::CPPDirective::Type::Ifdef) {
+                auto& item{items.emplace_back()};
+                item.name_ = std::move(directive.buf1_);
+                item.isSection_ = true;
+                item.line_ = lexer.line(lexer.pos());
+
+                if (item.name_ == "CONFIG_PRESETS") {
+                    item.branch_ = logger.binfo("Splitting presets...");
+                }
+
+                if (not lexer.good()) continue;
 
-        stream.str(std::move(buf));
+                const auto begin{lexer.pos()};
+                const auto end{findSectionEnd(lexer)};
+                item.content_ = lexer.slice(begin, end);
+            }
+        }
+    }
+
+    const size maxThreads{parallelParse ? 0UZ : 1UZ};
+
+    utils::parallelFor(items.size(), [&items](size idx) {
+        auto& item{items[idx]};
+        if (not item.isSection_) return;
+
+        if (item.name_ == "CONFIG_PRESETS") {
+            item.parsed_ = parse::splitPresets(item.content_, *item.branch_);
+        } else if (item.name_ == "CONFIG_STYLES") {
+            item.parsed_ = parse::readStyles(item.content_);
+        }
+    }, maxThreads);
+
+    std::vector<std::pair<parse::ParsedPresets::Array *, logging::Branch *>> arrays;
+    std::vector<parse::ParsedStyle *> styles;
+    for (auto& item : items) {
+        if (auto *presets{std::get_if<parse::ParsedPresets>(&item.parsed_)}) {
+            for (auto& presetsItem : presets->items_) {
+                auto *array{std::get_if<parse::ParsedPresets::Array>(&presetsItem)};
+                if (not array) continue;
+
+                arrays.emplace_back(
+                    array,
+                    logger.binfo("Parsing preset array \"" + array->name_ + "\"...")
+                );
+            }
+        } else if (auto *parsedStyles{std::get_if<std::vector<parse::ParsedStyle>>(&item.parsed_)}) {
+            for (auto& style : *parsedStyles) styles.push_back(&style);
+        }
     }
 
-    while (stream.good()) {
-        utils::CommentData commentData{.stream_=stream};
-        (void)utils::extractComments(commentData);
+    utils::parallelFor(arrays.size() + styles.size(), [&](size idx) {
+        if (idx < arrays.size()) {
+            auto& [array, branch]{arrays[idx]};
+            array->err_ = parse::preset::readArray(
+                array->data_, array->presets_, *branch
+            );
+            return;
+        }
+
+        auto& style{*styles[idx - arrays.size()]};
+        style.content_ = style::format(style.content_, false);
+    }, maxThreads);
 
-        const auto chr{stream.get()};
-        if (not stream.good()) break;
+    // Applied once the presets they're used in are, wherever they are.
+    std::vector<parse::ParsedStyle> dedupAliases;
 
-        if (chr != '#')
+    for (auto& item : items) {
+        if (not item.isSection_) {
+            parse::tryAddInjection(config, item.name_);
             continue;
+        }
 
-        auto directive{parse::cppDirective(
-            stream, logger.bverbose("Parsing directive...")
-        )};
-
-        if (directive.type_ == parse::CPPDirective::Type::Include) {
-            parse::tryAddInjection(config, directive.buf1_);
-        } else if (directive.type_ == parse::CPPDirective::Type::Ifdef) {
-            auto sectStr{extractSection(stream)};
-
-            if (directive.buf1_ == "CONFIG_TOP") {
-                auto err{parse::top(
-                    sectStr,
-                    config,
-                    *logger.binfo("Parsing top...")
-                )};
-                if (err) return err;
-            } else if (directive.buf1_ == "CONFIG_PROP") {
-                auto err{parse::prop(
-                    sectStr,
-                    config,
-                    *logger.binfo("Parsing prop...")
-                )};
-                if (err) return err;
-            } else if (directive.buf1_ == "CONFIG_PRESETS") {
-                auto err{parse::presets(
-                    sectStr,
-                    config,
-                    *logger.binfo("Parsing presets...")
-                )};
-                if (err) return err;
-            } else if (directive.buf1_ == "CONFIG_STYLES") {
-                auto err{parse::styles(
-                    sectStr,
-                    config,
-                    *logger.binfo("Parsing styles...")
-                )};
-                if (err) return err;
-            } else if (directive.buf1_ == "CONFIG_BUTTONS") {
-                auto err{parse::buttons(
-                    sectStr,
-                    config,
-                    *logger.binfo("Parsing buttons...")
-                )};
-                if (err) return err;
-            } else {
-                logger.warn("Unknown config ifdef-guarded section: " + directive.buf1_);
+        std::optional<std::string> err;
+        if (item.name_ == "CONFIG_TOP") {
+            err = parse::top(
+                item.content_,
+                config,
+                *logger.binfo("Parsing top...")
+            );
+        } else if (item.name_ == "CONFIG_PROP") {
+            err = parse::prop(
+                item.content_,
+                config,
+                *logger.binfo("Parsing prop...")
+            );
+        } else if (item.name_ == "CONFIG_PRESETS") {
+            err = parse::presets(
+                std::get<parse::ParsedPresets>(std::move(item.parsed_)),
+                config,
+                *logger.binfo("Applying presets...")
+            );
+        } else if (item.name_ == "CONFIG_STYLES") {
+            logger.info("Applying styles...");
+            auto& parsedStyles{
+                std::get<std::vector<parse::ParsedStyle>>(item.parsed_)
+            };
+            for (auto& style : parsedStyles) {
+                if (style.dedupAlias_) dedupAliases.push_back(std::move(style));
             }
+            parse::styles(std::move(parsedStyles), config);
+        } else if (item.name_ == "CONFIG_BUTTONS") {
+            err = parse::buttons(
+                item.content_,
+                config,
+                *logger.binfo("Parsing buttons...")
+            );
+        } else {
+            logger.warn(
+                "Unknown config ifdef-guarded section on line " +
+                std::to_string(item.line_) + ": " + item.name_
+            );
         }
+
+        if (err) return err;
     }
 
+    parse::inlineDedupAliases(dedupAliases, config);
+
     logger.info("Parsing complete, finalizing...");
 
     config.settings_.processDefines();
@@ -169,7 +280,7 @@ std::optional<std::string> io::parse(
 }
 
 std::optional<std::string> io::generate(
-    const fs::path& filePath, const Config& config, logging::Branch *lBranch
+    std::string& out, const Config& config, logging::Branch *lBranch
 ) {
     auto& logger{logging::Branch::optCreateLogger("generate()", lBranch)};
 
@@ -178,83 +289,90 @@ std::optional<std::string> io::generate(
     auto precheckErr{gen::preCheck(config, *logger.binfo("Running prechecks..."))};
     if (precheckErr) return precheckErr;
 
-    auto outFile{files::openOutput(filePath)};
-    if (not outFile.is_open()) {
-        return errorMessage(logger, wxTRANSLATE("Could not open config file for output."));
+    const auto styleAliases{gen::dedupStyles(config)};
+
+    gen::Buffer buf;
+    buf.reserve(out.capacity());
+
+    buf << "/*\n";
+    buf << " * This configuration file was generated by ProffieConfig, created by Ryryog25.\n";
+    buf << " * ProffieConfig is an All-In-One utility for managing your Proffieboard.\n";
+    buf << " * https://proffieconfig.kafrenetrading.com/\n";
+    buf << " *\n";
+    buf << " * Version: " << executableVersion << ", Generator Version: " wxSTRINGIZE(BIN_VERSION) "\n";
+    buf << " */\n";
+
+    buf << '\n';
+    gen::top(buf, config);
+    buf << '\n';
+    gen::prop(buf, config);
+    buf << '\n';
+    gen::presets(buf, config, styleAliases);
+    buf << '\n';
+    gen::buttons(buf, config);
+    buf << '\n';
+    gen::styles(buf, config, styleAliases);
+
+    // Anything not used this time belongs to something edited or removed.
+    gen::Cache::of(config).sweep();
+
+    out = buf.release();
+
+    if (not styleAliases.aliases_.empty()) {
+        logger.info(
+            "Aliased " + std::to_string(styleAliases.aliases_.size()) +
+            " repeated styles, saving ~" +
+            std::to_string(styleAliases.saved_) + " bytes"
+        );
     }
-    
-    outFile << "/*\n";
-    outFile << " * This configuration file was generated by ProffieConfig, created by Ryryog25.\n";
-    outFile << " * ProffieConfig is an All-In-One utility for managing your Proffieboard.\n";
-    outFile << " * https://proffieconfig.kafrenetrading.com/\n";
-    outFile << " *\n";
-    outFile << " * Version: " << executableVersion << ", Generator Version: " wxSTRINGIZE(BIN_VERSION) "\n";
-    outFile << " */\n";
-
-    outFile << '\n';
-    gen::top(outFile, config);
-    outFile << '\n';
-    gen::prop(outFile, config);
-    outFile << '\n';
-    gen::presets(outFile, config);
-    outFile << '\n';
-    gen::buttons(outFile, config);
-    outFile << '\n';
-    gen::styles(outFile, config);
-
-    outFile.close();
 
     logger.info("Done");
     return std::nullopt;
 }
 
-namespace {
+std::optional<std::string> io::generate(
+    const fs::path& filePath, const Config& config, logging::Branch *lBranch
+) {
+    auto& logger{logging::Branch::optCreateLogger("generate()", lBranch)};
 
-std::string extractSection(std::istream& file) {
-    std::string ret;
+    // The last output is the best guess at the size of this one.
+    std::error_code errCode;
+    const auto lastSize{fs::file_size(filePath, errCode)};
 
-    while (file.good()) {
-        auto startPos{file.tellg()};
+    std::string out;
+    if (not errCode) out.reserve(lastSize + (lastSize / 8));
 
-        utils::CommentData commentData{
-            .stream_=file,
-            .skipNewlines_=false,
-            .skipSpaces_=false,
-        };
-        if (utils::extractComments(commentData)) {
-            auto endPos{file.tellg()};
-            file.seekg(startPos);
+    auto err{generate(out, config, logger.binfo("Rendering..."))};
+    if (err) return err;
 
-            while (file.tellg() != endPos)
-                ret += static_cast<char>(file.get());
-        }
-
-        const auto chr{file.get()};
-        if (not file.good()) break;
+    if (not files::writeAtomic(filePath, out, errCode)) {
+        return errorMessage(logger, wxTRANSLATE("Could not write config file: %s"), errCode.message());
+    }
 
-        if (chr != '#') {
-            ret += static_cast<char>(chr);
-            continue;
-        }
+    return std::nullopt;
+}
 
-        startPos = file.tellg();
-        auto directive{parse::cppDirective(file, nullptr)};
-        if (directive.type_ != parse::CPPDirective::Type::Endif) {
-            auto endPos{file.tellg()};
+namespace {
 
-            file.seekg(startPos);
+size findSectionEnd(parse::Lexer& lexer) {
+    while (lexer.good()) {
+        parse::Lexer::Comments commentData{
+            .skipNewlines_=false,
+            .skipSpaces_=false,
+        };
+        (void)lexer.extractComments(commentData);
 
-            ret += '#';
-            while (file.tellg() != endPos)
-                ret += static_cast<char>(file.get());
+        const auto pos{lexer.pos()};
+        const auto chr{lexer.get()};
+        if (not lexer.good()) break;
 
-            continue;
-        }
+        if (chr != '#') continue;
 
-        break;
+        auto directive{parse::cppDirective(lexer, nullptr)};
+        if (directive.type_ == parse::CPPDirective::Type::Endif) return pos;
     }
 
-    return ret;
+    return lexer.buffer().size();
 }
 
 } // namespace
@@ -75,9 +75,22 @@ std::optional<std::string> parse(
     const fs::path&, Config&, logging::Branch *lBranch = nullptr
 );
 
+/**
+ * Render a config to header in memory
+ *
+ * @param out Replaced with the header. Its capacity is used as a size hint.
+ *
+ * @return Error message on failure. nullopt on success
+ */
+CONFIG_EXPORT std::optional<std::string> generate(
+    std::string& out, const Config&, logging::Branch *lBranch = nullptr
+);
+
 /**
  * Output a config to header on disk
  *
+ * The file is replaced atomically, so on failure it is left untouched.
+ *
  * @return Error message on failure. nullopt on success
  */
 std::optional<std::string> generate(
@@ -19,19 +19,18 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <sstream>
-
 #include "config/buttons/button.hpp"
 #include "config/priv/io.hpp"
+#include "config/priv/parse/lexer.hpp"
 #include "config/strings.hpp"
 #include "data/context.hpp"
 #include "utils/string.hpp"
 
 std::optional<std::string> config::priv::parse::buttons(
-    const std::string& buf, Config& config, logging::Branch& lBranch
+    std::string_view buf, Config& config, logging::Branch& lBranch
 ) {
     auto& logger{lBranch.createLogger("config::parseButtons()")};
-    std::istringstream stream(buf);
+    Lexer lexer{buf};
 
     enum {
         eNone,
@@ -47,19 +46,18 @@ std::optional<std::string> config::priv::parse::buttons(
     std::string inner;
     char openChar{};
 
-    while (stream.good()) {
-        utils::CommentData commentData{
-            .stream_=stream,
+    while (lexer.good()) {
+        Lexer::Comments commentData{
             .skipNewlines_=false,
             .skipSpaces_=false,
         };
-        if (utils::extractComments(commentData)) {
+        if (lexer.extractComments(commentData)) {
             if (reading == eType) reading = ePost_Type;
             if (reading == eCpp_Name) reading = ePost_Cpp_Name;
         }
 
-        const auto chr{stream.get()};
-        if (not stream.good())
+        const auto chr{lexer.get()};
+        if (not lexer.good())
             return {};
 
         if (reading == eNone) {
@@ -20,6 +20,7 @@
  */
 
 #include <string>
+#include <string_view>
 
 #include "config/config.hpp"
 #include "log/logger.hpp"
@@ -27,7 +28,7 @@
 namespace config::priv::parse {
 
 std::optional<std::string> buttons(
-    const std::string&, Config&, logging::Branch& lBranch
+    std::string_view, Config&, logging::Branch& lBranch
 );
 
 } // namespace config::priv::parse
@@ -0,0 +1,103 @@
+#include "lexer.hpp"
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2026 Ryan Ogurek
+ *
+ * components/config/priv/parse/lexer.cpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+using namespace config::priv;
+
+int32 parse::Lexer::fail() {
+    if (mPos >= mBuf.size()) mEnd = true;
+    mFail = true;
+    return END;
+}
+
+void parse::Lexer::seek(size pos) {
+    mEnd = false;
+    if (mFail) return;
+
+    mPos = std::min(pos, mBuf.size());
+}
+
+size parse::Lexer::line(size pos) {
+    if (not mHasLines) {
+        const auto *begin{mBuf.data()};
+        const auto *end{begin + mBuf.size()};
+        for (const auto *iter{begin}; iter < end; ++iter) {
+            iter = static_cast<const char *>(std::memchr(iter, '\n', end - iter));
+            if (not iter) break;
+
+            mLines.push_back(iter - begin);
+        }
+
+        mHasLines = true;
+    }
+
+    return 1 + static_cast<size>(
+        std::lower_bound(mLines.begin(), mLines.end(), pos) - mLines.begin()
+    );
+}
+
+bool parse::Lexer::readComments(Comments& data) {
+    data.out_.clear();
+
+    if (not good()) {
+        mFail = true;
+        data.type_ = Comments::Type::eType_None;
+        return false;
+    }
+
+    const uint32 typesToRead{data.type_};
+    utils::BufferCommentData bufData{
+        .buf_=mBuf,
+        .pos_=mPos,
+        .spans_=std::move(mSpans),
+        .type_=data.type_,
+        .single_=data.single_,
+        .skipNewlines_=data.skipNewlines_,
+        .skipSpaces_=data.skipSpaces_,
+    };
+    const auto ret{utils::extractComments(bufData)};
+    utils::formatComments(mBuf, bufData.spans_, data.out_);
+
+    data.type_ = bufData.type_;
+    mSpans = std::move(bufData.spans_);
+
+    // Comments are only ever stopped short of the end by content, reaching it
+    // means reading past it as a stream would've.
+    mPos = bufData.pos_;
+    if (mPos == mBuf.size()) {
+        mEnd = true;
+        mFail = true;
+    } else if (
+            mPos + 1 == mBuf.size() and
+            mBuf[mPos] == '/' and
+            (typesToRead & Comments::Type::eType_Line) and
+            (typesToRead & Comments::Type::eType_Block)
+           ) {
+        // A stream peeks past a trailing '/' once per type, and the second
+        // peek fails it.
+        mPos = mBuf.size();
+        mFail = true;
+    }
+
+    return ret;
+}
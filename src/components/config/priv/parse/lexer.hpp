@@ -0,0 +1,150 @@
+#pragma once
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2026 Ryan Ogurek
+ *
+ * components/config/priv/parse/lexer.hpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cctype>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "utils/string.hpp"
+#include "utils/types.hpp"
+
+#include "config_export.h"
+
+namespace config::priv::parse {
+
+/**
+ * Reads through a contiguous buffer for the config parsers.
+ *
+ * get(), peek(), unget() and good() behave as their istream counterparts do,
+ * including at the end of the buffer, so the parsers' state machines read
+ * the same as they did over streams, but nothing is copied or virtual.
+ */
+struct CONFIG_EXPORT Lexer {
+    static constexpr int32 END{-1};
+
+    /**
+     * Mirrors utils::CommentData, minus the stream.
+     */
+    struct Comments {
+        using Type = utils::CommentData;
+
+        std::string out_;
+        uint32 type_{Type::eType_Line | Type::eType_Block};
+        bool single_{false};
+        bool skipNewlines_{true};
+        bool skipSpaces_{true};
+    };
+
+    explicit Lexer(std::string_view buf) : mBuf{buf} {}
+
+    [[nodiscard]] bool good() const { return not mEnd and not mFail; }
+
+    /**
+     * @return Next char as unsigned, or END.
+     */
+    int32 get() {
+        if (not good() or mPos >= mBuf.size()) return fail();
+        return static_cast<unsigned char>(mBuf[mPos++]);
+    }
+
+    [[nodiscard]] int32 peek() {
+        if (not good()) return fail();
+
+        if (mPos >= mBuf.size()) {
+            mEnd = true;
+            return END;
+        }
+
+        return static_cast<unsigned char>(mBuf[mPos]);
+    }
+
+    void unget() {
+        mEnd = false;
+        if (mFail or mPos == 0) {
+            mFail = true;
+            return;
+        }
+
+        --mPos;
+    }
+
+    [[nodiscard]] size pos() const { return mPos; }
+    void seek(size);
+
+    [[nodiscard]] std::string_view buffer() const { return mBuf; }
+    [[nodiscard]] std::string_view slice(size begin, size end) const {
+        return mBuf.substr(begin, end - begin);
+    }
+
+    /**
+     * @return 1-based line of pos. The line table is built on first use.
+     */
+    [[nodiscard]] size line(size pos);
+
+    /**
+     * Same as utils::extractComments(), read straight from the buffer with
+     * utils::extractComments(BufferCommentData&).
+     *
+     * @return If a comment was parsed.
+     */
+    [[nodiscard]] bool extractComments(Comments& data) {
+        // Parsers check for comments before every char, and nearly every
+        // time it's content, with nothing to skip.
+        if (good() and mPos < mBuf.size()) {
+            const auto chr{static_cast<unsigned char>(mBuf[mPos])};
+            if (std::isgraph(chr) and chr != '/') {
+                data.out_.clear();
+                data.type_ = Comments::Type::eType_None;
+                return false;
+            }
+        }
+
+        return readComments(data);
+    }
+
+private:
+    /**
+     * Set the fail state, as reading past the end would.
+     *
+     * @return END
+     */
+    int32 fail();
+
+    bool readComments(Comments&);
+
+    std::string_view mBuf;
+    size mPos{0};
+
+    // eofbit and failbit
+    bool mEnd{false};
+    bool mFail{false};
+
+    // Offset of each '\n'
+    std::vector<size> mLines;
+    bool mHasLines{false};
+
+    // Kept between extractComments() calls to reuse its storage.
+    std::vector<utils::CommentSpan> mSpans;
+};
+
+} // namespace config::priv::parse
+
@@ -19,13 +19,12 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <sstream>
-
 #include <wx/translation.h>
 
 #include "config/presets/preset.hpp"
 #include "config/presets/style.hpp"
 #include "config/priv/io.hpp"
+#include "config/priv/parse/lexer.hpp"
 #include "data/context.hpp"
 #include "log/branch.hpp"
 #include "utils/string.hpp"
@@ -33,11 +32,13 @@
 using namespace config;
 using namespace config::priv;
 
-std::optional<std::string> parse::preset::array(
-    const std::string& buf, presets::Array& array, logging::Branch& lBranch
+std::optional<std::string> parse::preset::readArray(
+    std::string_view buf,
+    std::vector<ParsedPreset>& presets,
+    logging::Branch& lBranch
 ) {
-    auto& logger{lBranch.createLogger("config::parse::preset::array()")};
-    std::istringstream stream(buf);
+    auto& logger{lBranch.createLogger("config::parse::preset::readArray()")};
+    Lexer lexer{buf};
 
     enum {
         eNone,
@@ -57,37 +58,26 @@ std::optional<std::string> parse::preset::array(
     std::string tmp;
     std::string comments;
 
-    const auto finishStyleReading{[&array, &tmp, &comments]() {
+    const auto finishStyleReading{[&presets, &tmp, &comments]() {
         utils::trimSurroundingWhitespace(tmp);
 
-        auto presets{data::context(array.presets_)};
-        auto& preset{dynamic_cast<presets::Preset&>(
-            *presets.children().back()
-        )};
-        auto styles{data::context(preset.styles_)};
-        auto& style{styles.append<presets::Style>(array.root<Config>())};
-
-        style.content_.change(std::move(tmp));
+        presets.back().styles_.push_back({
+            .content_=std::move(tmp),
+            .comment_=std::move(comments),
+        });
         tmp.clear();
-
-        style.comment_.change(std::move(comments));
         comments.clear();
-
-        style.content_.change(style.format());
     }};
 
-    auto presets{data::context(array.presets_)};
-
-    while (stream.good()) {
-        utils::CommentData commentData{
-            .stream_=stream,
+    while (lexer.good()) {
+        Lexer::Comments commentData{
             .single_=true,
             .skipSpaces_=
                 reading != eDir and
                 reading != eTrack and
                 reading != eName
         };
-        if (utils::extractComments(commentData)) {
+        if (lexer.extractComments(commentData)) {
             if (reading == eStyle) {
                 if (commentData.type_ == utils::CommentData::eType_Block) {
                     if (not comments.empty())
@@ -107,16 +97,14 @@ std::optional<std::string> parse::preset::array(
             continue;
         }
 
-        const auto chr{stream.get()};
-        if (not stream.good())
+        const auto chr{lexer.get()};
+        if (not lexer.good())
             return {};
 
         if (reading == eNone) {
             if (chr == '{') {
                 reading = ePost_Brace;
-                presets.append<presets::Preset>(
-                    array.root<Config>()
-                );
+                presets.emplace_back();
             }
         } else if (reading == ePost_Brace or reading == ePost_Dir) {
             if (chr == '"') {
@@ -132,24 +120,14 @@ std::optional<std::string> parse::preset::array(
                 continue;
             }
 
-            auto& preset{dynamic_cast<presets::Preset&>(
-                *presets.children().back()
-            )};
-
-            auto fontDir{data::context(preset.fontDir_)};
-            fontDir.append(static_cast<char>(chr));
+            presets.back().fontDir_ += static_cast<char>(chr);
         } else if (reading == eTrack) {
             if (chr == '"') {
                 reading = ePost_Track;
                 continue;
             }
 
-            auto& preset{dynamic_cast<presets::Preset&>(
-                *presets.children().back()
-            )};
-
-            auto track{data::context(preset.track_)};
-            track.append(static_cast<char>(chr));
+            presets.back().track_ += static_cast<char>(chr);
         } else if (reading == ePost_Track) {
             if (chr == ',') {
                 reading = eStyle;
@@ -167,11 +145,7 @@ std::optional<std::string> parse::preset::array(
                 // denotes the end of styles and now is at the very last
                 // cstring name entry.
                 if (chr == '"') {
-                    auto& preset{dynamic_cast<presets::Preset&>(
-                        *presets.children().back()
-                    )};
-
-                    preset.name_.clear();
+                    presets.back().name_.emplace();
 
                     reading = eName;
                     tmp.clear();
@@ -202,13 +176,7 @@ std::optional<std::string> parse::preset::array(
 
                 depth.clear();
 
-                auto& preset{dynamic_cast<presets::Preset&>(
-                    *presets.children().back()
-                )};
-
-                preset.name_.change(
-                    "preset" + std::to_string(presets.children().size())
-                );
+                presets.back().name_ = "preset" + std::to_string(presets.size());
 
                 reading = eNone;
                 continue;
@@ -238,16 +206,11 @@ std::optional<std::string> parse::preset::array(
             if (chr == '"' or chr == '}') {
                 reading = eNone;
 
-                auto& preset{dynamic_cast<presets::Preset&>(
-                    *presets.children().back()
-                )};
-
                 if (tmp.empty()) {
-                    preset.name_.change(
-                        "preset" + std::to_string(presets.children().size())
-                    );
+                    presets.back().name_ = "preset" + std::to_string(presets.size());
                 } else {
-                    preset.name_.change(std::move(tmp));
+                    presets.back().name_ = std::move(tmp);
+                    tmp.clear();
                 }
 
                 continue;
@@ -260,3 +223,27 @@ std::optional<std::string> parse::preset::array(
     return std::nullopt;
 }
 
+void parse::preset::array(
+    std::vector<ParsedPreset>&& parsedPresets, presets::Array& array
+) {
+    auto presets{data::context(array.presets_)};
+
+    for (auto& parsed : parsedPresets) {
+        auto& preset{presets.append<presets::Preset>(array.root<Config>())};
+
+        preset.fontDir_.change(std::move(parsed.fontDir_));
+        preset.track_.change(std::move(parsed.track_));
+
+        auto styles{data::context(preset.styles_)};
+        for (auto& parsedStyle : parsed.styles_) {
+            auto& style{styles.append<presets::Style>(array.root<Config>())};
+
+            style.content_.change(std::move(parsedStyle.content_));
+            style.comment_.change(std::move(parsedStyle.comment_));
+            style.content_.change(style.format());
+        }
+
+        if (parsed.name_) preset.name_.change(std::move(*parsed.name_));
+    }
+}
+
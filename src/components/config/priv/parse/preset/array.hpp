@@ -19,16 +19,46 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "config/presets/array.hpp"
 #include "log/logger.hpp"
 
 namespace config::priv::parse::preset {
 
-std::optional<std::string> array(
-    const std::string&, presets::Array&, logging::Branch&
+struct ParsedStyle {
+    std::string content_;
+    std::string comment_;
+};
+
+/**
+ * A preset as read from the config, before it's applied to a Preset.
+ */
+struct ParsedPreset {
+    std::string fontDir_;
+    std::string track_;
+    std::vector<ParsedStyle> styles_;
+    // nullopt if the name was never reached.
+    std::optional<std::string> name_;
+};
+
+/**
+ * Read the presets of an array without touching any models, so that this may
+ * run alongside other parsing.
+ *
+ * @return Error message on failure. nullopt on success.
+ */
+std::optional<std::string> readArray(
+    std::string_view, std::vector<ParsedPreset>&, logging::Branch&
 );
 
+/**
+ * Append presets from readArray() to array.
+ */
+void array(std::vector<ParsedPreset>&&, presets::Array&);
+
 } // namespace config::priv::parse::preset
 
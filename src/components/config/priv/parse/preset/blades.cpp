@@ -29,6 +29,7 @@
 #include "config/blades/bladeconfig.hpp"
 #include "config/blades/servo.hpp"
 #include "config/priv/io.hpp"
+#include "config/priv/parse/lexer.hpp"
 #include "config/strings.hpp"
 #include "data/context.hpp"
 #include "log/branch.hpp"
@@ -47,10 +48,10 @@ std::optional<std::string> parseBlade(
 } // namespace
 
 std::optional<std::string> parse::preset::blades(
-    const std::string& buf, Config& config, logging::Branch& lBranch
+    std::string_view buf, Config& config, logging::Branch& lBranch
 ) {
     auto& logger{lBranch.createLogger("config::parse::blades()")};
-    std::istringstream stream(buf);
+    Lexer lexer{buf};
 
     enum {
         eNone,
@@ -68,12 +69,12 @@ std::optional<std::string> parse::preset::blades(
 
     auto bladeConfigs{data::context(config.bladeConfigs_)};
 
-    while (stream.good()) {
-        utils::CommentData commentData{.stream_=stream};
-        (void)utils::extractComments(commentData);
+    while (lexer.good()) {
+        Lexer::Comments commentData;
+        (void)lexer.extractComments(commentData);
 
-        const auto chr{stream.get()};
-        if (not stream.good())
+        const auto chr{lexer.get()};
+        if (not lexer.good())
             return {};
 
         if (reading == eNone) {
@@ -86,10 +87,7 @@ std::optional<std::string> parse::preset::blades(
             if (chr == ',') {
                 utils::trimWhitespace(buffer);
 
-                auto idVal{buffer == "NO_BLADE"
-                    ? NO_BLADE
-                    : utils::doStringMath(buffer)
-                };
+                auto idVal{utils::doStringMath(buffer, ID_CONSTANTS)};
 
                 if (idVal) {
                     auto& lastArray{dynamic_cast<BladeConfig&>(
@@ -20,6 +20,7 @@
  */
 
 #include <string>
+#include <string_view>
 
 #include "config/config.hpp"
 #include "log/logger.hpp"
@@ -27,7 +28,7 @@
 namespace config::priv::parse::preset {
 
 std::optional<std::string> blades(
-    const std::string&, Config&, logging::Branch&
+    std::string_view, Config&, logging::Branch&
 );
 
 } // namespace config::priv::parse::preset
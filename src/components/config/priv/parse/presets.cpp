@@ -19,8 +19,6 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <sstream>
-
 #include "config/presets/array.hpp"
 #include "config/presets/preset.hpp"
 #include "config/priv/io.hpp"
@@ -30,11 +28,13 @@
 #include "data/context.hpp"
 #include "utils/string.hpp"
 
-std::optional<std::string> config::priv::parse::presets(
-    const std::string& buf, Config& config, logging::Branch& lBranch
+config::priv::parse::ParsedPresets config::priv::parse::splitPresets(
+    std::string_view buf, logging::Branch& lBranch
 ) {
-    auto& logger{lBranch.createLogger("config::parsePresets()")};
-    std::istringstream stream(buf);
+    auto& logger{lBranch.createLogger("config::parse::splitPresets()")};
+    Lexer lexer{buf};
+
+    ParsedPresets ret;
 
     enum Read {
         None,
@@ -47,23 +47,25 @@ std::optional<std::string> config::priv::parse::presets(
 
     std::string tmp;
     std::string name;
-    while (stream.good()) {
-        utils::CommentData commentData{
-            .stream_=stream,
+    while (lexer.good()) {
+        Lexer::Comments commentData{
             .skipSpaces_=false,
         };
-        (void)utils::extractComments(commentData);
+        (void)lexer.extractComments(commentData);
 
-        auto chr{stream.get()};
-        if (not stream.good())
-            return {};
+        auto chr{lexer.get()};
+        if (not lexer.good())
+            return ret;
 
         if (read == Read::None) {
             if (chr == '#') {
-                auto directive{cppDirective(stream, nullptr)};
+                auto directive{cppDirective(lexer, nullptr)};
 
-                if (directive.type_ == CPPDirective::Type::Include)
-                    tryAddInjection(config, directive.buf1_);
+                if (directive.type_ == CPPDirective::Type::Include) {
+                    ret.items_.emplace_back(ParsedPresets::Include{
+                        std::move(directive.buf1_)
+                    });
+                }
 
                 continue;
             }
@@ -106,49 +108,40 @@ std::optional<std::string> config::priv::parse::presets(
                 ++depth;
 
                 if (depth == 1)
-                    start = stream.tellg();
+                    start = lexer.pos();
             } else if (chr == '}') {
                 if (depth == 0) {
-                    if (read == Read::Preset_Array)
-                        return errorMessage(logger, wxTRANSLATE("Preset array is missing start { before ending };"));
-
-                    return errorMessage(logger, wxTRANSLATE("BladeConfig array is missing start { before ending };"));
+                    if (read == Read::Preset_Array) {
+                        ret.err_ = errorMessage(logger, wxTRANSLATE("Preset array is missing start { before ending };"));
+                    } else {
+                        ret.err_ = errorMessage(logger, wxTRANSLATE("BladeConfig array is missing start { before ending };"));
+                    }
+                    return ret;
                 }
 
                 --depth;
 
                 if (depth == 0) {
-                    const uint32 dataEndPos = stream.tellg();
+                    const uint32 dataEndPos = lexer.pos();
 
                     // Include the outer brace set to provide an extra buffer
-                    // for parse::preset::array(). On the off-chance the config
-                    // is malformed with a missing last preset }, that may
-                    // catch it. Every little bit helps the whacky configs
+                    // for parse::preset::readArray(). On the off-chance the
+                    // config is malformed with a missing last preset }, that
+                    // may catch it. Every little bit helps the whacky configs
                     // people manage to make/find.
-                    const auto data{buf.substr(start, dataEndPos - start)};
-                    std::optional<std::string> ret;
+                    auto data{buf.substr(start, dataEndPos - start)};
                     if (read == Read::Preset_Array) {
-                        auto presetArrays{data::context(config.presetArrays_)};
-
-                        auto& array{presetArrays.append<presets::Array>(config)};
-                        auto nameCtxt{data::context(array.name_)};
-                        nameCtxt.change(std::move(name));
-
-                        ret = parse::preset::array(
-                            data,
-                            array,
-                            *logger.binfo("Parsing preset array \"" + nameCtxt.val() + "\"...")
-                        );
+                        ret.items_.emplace_back(ParsedPresets::Array{
+                            .name_=std::move(name),
+                            .data_=std::move(data),
+                        });
+                        name.clear();
                     } else /* read == Read::Blade_Arrays */ {
-                        ret = parse::preset::blades(
-                            data,
-                            config,
-                            *logger.binfo("Parsing blade arrays...")
-                        );
+                        ret.items_.emplace_back(ParsedPresets::Blades{
+                            std::move(data)
+                        });
                     }
 
-                    if (ret) return ret;
-
                     read = Read::None;
                 }
             }
@@ -158,6 +151,37 @@ std::optional<std::string> config::priv::parse::presets(
     if (read != Read::None)
         logger.warn("Searching (" + std::to_string(read) + ") not complete before end.");
 
-    return std::nullopt;
+    return ret;
 }
 
+std::optional<std::string> config::priv::parse::presets(
+    ParsedPresets&& parsed, Config& config, logging::Branch& lBranch
+) {
+    auto& logger{lBranch.createLogger("config::parsePresets()")};
+
+    for (auto& item : parsed.items_) {
+        if (auto *include{std::get_if<ParsedPresets::Include>(&item)}) {
+            tryAddInjection(config, include->path_);
+        } else if (auto *parsedArray{std::get_if<ParsedPresets::Array>(&item)}) {
+            if (parsedArray->err_) return std::move(parsedArray->err_);
+
+            auto presetArrays{data::context(config.presetArrays_)};
+
+            auto& array{presetArrays.append<presets::Array>(config)};
+            auto nameCtxt{data::context(array.name_)};
+            nameCtxt.change(std::move(parsedArray->name_));
+
+            logger.verbose("Applying preset array \"" + nameCtxt.val() + "\"...");
+            preset::array(std::move(parsedArray->presets_), array);
+        } else if (auto *blades{std::get_if<ParsedPresets::Blades>(&item)}) {
+            auto err{preset::blades(
+                blades->data_,
+                config,
+                *logger.binfo("Parsing blade arrays...")
+            )};
+            if (err) return err;
+        }
+    }
+
+    return std::move(parsed.err_);
+}
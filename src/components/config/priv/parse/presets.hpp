@@ -19,15 +19,56 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <optional>
 #include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
 
 #include "config/config.hpp"
+#include "config/priv/parse/preset/array.hpp"
 #include "log/logger.hpp"
 
 namespace config::priv::parse {
 
+/**
+ * The parts of the presets section, in order.
+ */
+struct ParsedPresets {
+    struct Include {
+        std::string path_;
+    };
+
+    struct Array {
+        std::string name_;
+        // Contents for preset::readArray(), which fills presets_ or err_.
+        std::string_view data_;
+        std::vector<preset::ParsedPreset> presets_;
+        std::optional<std::string> err_;
+    };
+
+    struct Blades {
+        std::string_view data_;
+    };
+
+    std::vector<std::variant<Include, Array, Blades>> items_;
+    // Set if splitting failed after items_.
+    std::optional<std::string> err_;
+};
+
+/**
+ * Split the presets section into its parts without touching any models.
+ * Preset arrays are not read.
+ */
+ParsedPresets splitPresets(std::string_view, logging::Branch& lBranch);
+
+/**
+ * Apply a split presets section, with its arrays read, to config.
+ *
+ * @return Error message on failure. nullopt on success.
+ */
 std::optional<std::string> presets(
-    const std::string&, Config&, logging::Branch& lBranch
+    ParsedPresets&&, Config&, logging::Branch& lBranch
 );
 
 } // namespace config::priv::parse
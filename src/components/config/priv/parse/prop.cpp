@@ -19,32 +19,30 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <sstream>
-
 #include "config/priv/parse/utils.hpp"
 #include "utils/string.hpp"
 
 std::optional<std::string> config::priv::parse::prop(
-    const std::string& buf, Config& config, logging::Branch& lBranch
+    std::string_view buf, Config& config, logging::Branch& lBranch
 ) {
     auto& logger{lBranch.createLogger("config::parse::prop()")};
-    std::istringstream stream(buf);
+    Lexer lexer{buf};
 
     auto propVec{config.propVec()};
     if (not propVec) return {};
 
-    while (stream.good()) {
-        utils::CommentData commentData{.stream_=stream};
-        (void)utils::extractComments(commentData);
+    while (lexer.good()) {
+        Lexer::Comments commentData;
+        (void)lexer.extractComments(commentData);
 
-        auto chr{stream.get()};
-        if (not stream.good())
+        auto chr{lexer.get()};
+        if (not lexer.good())
             break;
 
         if (chr != '#')
             continue;
 
-        auto directive{cppDirective(stream, logger.bverbose("Directive..."))};
+        auto directive{cppDirective(lexer, logger.bverbose("Directive..."))};
         if (directive.type_ != CPPDirective::Type::Include)
             continue;
 
@@ -19,36 +19,57 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <sstream>
+#include <unordered_map>
 
 #include "config/presets/array.hpp"
 #include "config/presets/preset.hpp"
+#include "config/priv/parse/lexer.hpp"
+#include "config/priv/io.hpp"
 #include "config/priv/utils/style.hpp"
+#include "config/strings.hpp"
 #include "config/styles/style.hpp"
 #include "data/context.hpp"
 #include "utils/string.hpp"
 
-std::optional<std::string> config::priv::parse::styles(
-    const std::string& buf, Config& config, logging::Branch& lBranch
-) {
-    auto& logger{lBranch.createLogger("config::parse::styles()")};
-    std::istringstream stream(buf);
+auto config::priv::parse::readStyles(
+    std::string_view buf
+) -> std::vector<ParsedStyle> {
+    Lexer lexer{buf};
+    std::vector<ParsedStyle> ret;
 
+    // Aliases are `using Name = Content;`. Any other using (namespaces,
+    // declarations) is skipped to its ;
     enum {
         eNone,
+        eName,
+        ePost_Name,
         eStyle,
-        eStyle_Name,
+        eSkip,
     } reading{eNone};
 
-    std::string readHistory;
+    // Identifier currently being read while looking for `using`
+    std::string word;
 
     std::string comments;
     std::string bladestyle;
     std::string name;
 
-    while (stream.good()) {
-        utils::CommentData commentData{.stream_=stream};
-        if (utils::extractComments(commentData)) {
+    const auto isIdentifier{[](int32 chr) {
+        return std::isalnum(chr) or chr == '_';
+    }};
+    const auto endWord{[&]() {
+        if (reading == eNone and word == "using") reading = eName;
+        word.clear();
+    }};
+
+    while (lexer.good()) {
+        Lexer::Comments commentData{
+            .skipNewlines_=false,
+            .skipSpaces_=false,
+        };
+        if (lexer.extractComments(commentData)) {
+            endWord();
+
             if (
                     // If there's line comments outside the style, just add it
                     // to the comments, and not as an in-line.
@@ -69,35 +90,52 @@ std::optional<std::string> config::priv::parse::styles(
             }
         }
 
-        const auto chr{stream.get()};
-        if (not stream.good())
-            continue;
+        const auto chr{lexer.get()};
+        if (not lexer.good())
+            break;
 
         if (reading == eNone) {
-            if (name.empty()) {
-                readHistory += static_cast<char>(chr);
-                if (readHistory.rfind("using") != std::string::npos) {
-                    reading = eStyle_Name;
-                    readHistory.clear();
-                }
+            if (isIdentifier(chr)) {
+                word += static_cast<char>(chr);
+                continue;
             }
-        } else if (reading == eStyle_Name) {
+
+            endWord();
+        } else if (reading == eName) {
+            if (isIdentifier(chr)) {
+                name += static_cast<char>(chr);
+            } else if (chr == '=' and not name.empty()) {
+                reading = eStyle;
+            } else if (std::isspace(chr)) {
+                if (not name.empty()) reading = ePost_Name;
+            } else {
+                reading = eSkip;
+            }
+        } else if (reading == ePost_Name) {
             if (chr == '=') {
                 reading = eStyle;
-                continue;
+            } else if (not std::isspace(chr)) {
+                reading = eSkip;
+            }
+        } else if (reading == eSkip) {
+            if (chr == ';') {
+                name.clear();
+                comments.clear();
+                reading = eNone;
             }
-
-            name += static_cast<char>(chr);
         } else if (reading == eStyle) {
             if (chr == ';') {
-                auto styles{data::context(config.styles_)};
-
-                // RIP quadruple nested for loops.
-
-                auto& style{styles.append<styles::Style>(config)};
-                style.name_.change(std::move(name));
-                style.comments_.change(std::move(comments));
-                style.content_.change(style::format(bladestyle, false));
+                auto marker{std::string{PC_OPT_NOCOMMENT_STR}};
+                marker += DEDUP_ALIAS_STR;
+                utils::trimSurroundingWhitespace(comments);
+                const auto dedupAlias{comments == marker};
+
+                ret.push_back({
+                    .name_=std::move(name),
+                    .comments_=dedupAlias ? std::string{} : std::move(comments),
+                    .content_=std::move(bladestyle),
+                    .dedupAlias_=dedupAlias,
+                });
 
                 name.clear();
                 bladestyle.clear();
@@ -107,10 +145,65 @@ std::optional<std::string> config::priv::parse::styles(
                 continue;
             }
 
-            bladestyle += static_cast<char>(chr);
+            if (not std::isspace(chr)) bladestyle += static_cast<char>(chr);
         }
     }
 
-    return std::nullopt;
+    return ret;
+}
+
+void config::priv::parse::styles(
+    std::vector<ParsedStyle>&& parsedStyles, Config& config
+) {
+    auto styles{data::context(config.styles_)};
+
+    for (auto& parsed : parsedStyles) {
+        if (parsed.dedupAlias_) continue;
+
+        auto& style{styles.append<styles::Style>(config)};
+        style.name_.change(std::move(parsed.name_));
+        style.comments_.change(std::move(parsed.comments_));
+        style.content_.change(std::move(parsed.content_));
+    }
+}
+
+void config::priv::parse::inlineDedupAliases(
+    const std::vector<ParsedStyle>& parsedStyles, Config& config
+) {
+    // Preset style as it refers to the alias, to what it stands for.
+    std::unordered_map<std::string, std::string> aliases;
+    for (const auto& parsed : parsedStyles) {
+        if (not parsed.dedupAlias_) continue;
+
+        aliases.emplace(
+            "StylePtr<" + parsed.name_ + ">()",
+            "StylePtr<" + parsed.content_ + ">()"
+        );
+    }
+    if (aliases.empty()) return;
+
+    auto presetArrays{data::context(config.presetArrays_)};
+    for (const auto& arrayModel : presetArrays.children()) {
+        auto& presetArray{dynamic_cast<presets::Array&>(*arrayModel)};
+
+        auto presets{data::context(presetArray.presets_)};
+        for (const auto& presetModel : presets.children()) {
+            auto& preset{dynamic_cast<presets::Preset&>(*presetModel)};
+
+            auto styles{data::context(preset.styles_)};
+            for (const auto& styleModel : styles.children()) {
+                auto& style{dynamic_cast<presets::Style&>(*styleModel)};
+
+                auto content{data::context(style.content_).val()};
+                utils::trimWhitespaceOutsideString(content);
+
+                const auto iter{aliases.find(content)};
+                if (iter == aliases.end()) continue;
+
+                style.content_.change(std::string{iter->second});
+                style.content_.change(style.format());
+            }
+        }
+    }
 }
 
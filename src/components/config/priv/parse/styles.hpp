@@ -20,15 +20,42 @@
  */
 
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "config/config.hpp"
 #include "log/logger.hpp"
 
+#include "config_export.h"
+
 namespace config::priv::parse {
 
-std::optional<std::string> styles(
-    const std::string&, Config&, logging::Branch& lBranch
-);
+struct ParsedStyle {
+    std::string name_;
+    std::string comments_;
+    // Unformatted as read, pass through style::format() before applying.
+    std::string content_;
+    // An alias made by style dedup, not something the user wrote.
+    bool dedupAlias_{false};
+};
+
+/**
+ * Read the styles section without touching any models.
+ */
+CONFIG_EXPORT std::vector<ParsedStyle> readStyles(std::string_view);
+
+/**
+ * Append read and formatted styles to config.
+ *
+ * Dedup aliases are left out, they're put back with inlineDedupAliases().
+ */
+void styles(std::vector<ParsedStyle>&&, Config&);
+
+/**
+ * Replace each preset style which refers to a dedup alias with what the
+ * alias stands for, so that the alias is only ever an output detail.
+ */
+void inlineDedupAliases(const std::vector<ParsedStyle>&, Config&);
 
 } // namespace config::priv::parse
 
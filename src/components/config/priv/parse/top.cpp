@@ -19,8 +19,6 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <sstream>
-
 #include "config/priv/io.hpp"
 #include "config/priv/parse/utils.hpp"
 #include "config/settings/define.hpp"
@@ -36,30 +34,30 @@ namespace {
 /**
  * @return if should re-loop
  */
-bool parseCommentOrPCOpt(std::istream&, Config&, logging::Logger&);
+bool parseCommentOrPCOpt(parse::Lexer&, Config&, logging::Logger&);
 
 } // namespace
 
 std::optional<std::string> parse::top(
-    const std::string& buf, Config& config, logging::Branch& lBranch
+    std::string_view buf, Config& config, logging::Branch& lBranch
 ) {
     auto& logger{lBranch.createLogger("config::parse::top()")};
-    std::istringstream stream(buf);
+    Lexer lexer{buf};
 
-    while (stream.good()) {
-        if (parseCommentOrPCOpt(stream, config, logger))
+    while (lexer.good()) {
+        if (parseCommentOrPCOpt(lexer, config, logger))
             continue;
 
         // At least what's next isn't a comment.
-        auto chr{stream.get()};
-        if (not stream.good())
+        auto chr{lexer.get()};
+        if (not lexer.good())
             return {};
 
         if (chr != '#')
             continue;
 
         auto directive{cppDirective(
-            stream, logger.binfo("Parsing directive...")
+            lexer, logger.binfo("Parsing directive...")
         )};
         switch (directive.type_) {
             using enum CPPDirective::Type;
@@ -103,15 +101,14 @@ std::optional<std::string> parse::top(
 namespace {
 
 bool parseCommentOrPCOpt(
-    std::istream& stream,
+    parse::Lexer& lexer,
     Config& config,
     logging::Logger& /*logger*/
 ) {
-    utils::CommentData commentData{
-        .stream_=stream,
+    parse::Lexer::Comments commentData{
         .single_=true,
     };
-    if (not utils::extractComments(commentData))
+    if (not lexer.extractComments(commentData))
         return false;
 
     if (commentData.type_ != utils::CommentData::eType_Line)
@@ -137,6 +134,15 @@ bool parseCommentOrPCOpt(
         config.settings_.massStorage_.set(true);
     } else if (key == ENABLE_WEBUSB_STR) {
         config.settings_.webUsb_.set(true);
+    } else if (key == DEDUP_STYLES_STR) {
+        config.settings_.dedupStyles_.enable_.set(true);
+
+        auto threshold{utils::doStringMath(value)};
+        if (threshold) {
+            config.settings_.dedupStyles_.threshold_.set(
+                static_cast<int32>(*threshold)
+            );
+        }
     } else if (key == OS_VERSION_STR) {
         utils::Version version(value);
         if (not version)
@@ -35,7 +35,7 @@
 using namespace config::priv;
 
 parse::CPPDirective parse::cppDirective(
-    std::istream& stream,
+    Lexer& lexer,
     logging::Branch *lBranch
 ) {
     auto& logger{logging::Branch::optCreateLogger("config::parse::cppDirective()", lBranch)};
@@ -117,24 +117,23 @@ parse::CPPDirective parse::cppDirective(
         }
     }};
 
-    // A '#' has already been grabbed from stream.
-    while (stream.good()) {
-        utils::CommentData commentData{
-            .stream_=stream,
+    // A '#' has already been grabbed from lexer.
+    while (lexer.good()) {
+        Lexer::Comments comments{
             .single_=true,
             .skipNewlines_=false,
             .skipSpaces_=false,
         };
-        if (utils::extractComments(commentData)) {
+        if (lexer.extractComments(comments)) {
             // This means there's nothing else on the line
-            if (commentData.type_ == utils::CommentData::eType_Line) {
+            if (comments.type_ == utils::CommentData::eType_Line) {
                 finish();
                 return ret;
             }
         }
 
-        auto chr{stream.get()};
-        if (not stream.good())
+        auto chr{lexer.get()};
+        if (not lexer.good())
             return ret;
 
         if (chr == '\n') {
@@ -145,7 +144,7 @@ parse::CPPDirective parse::cppDirective(
         switch (read) {
             case Read::None:
                 if (not std::isspace(chr)) {
-                    stream.unget();
+                    lexer.unget();
                     read = Read::Directive;
                 }
 
@@ -160,7 +159,7 @@ parse::CPPDirective parse::cppDirective(
                 break;
             case Read::Define_Pre:
                 if (not std::isspace(chr)) {
-                    stream.unget();
+                    lexer.unget();
                     read = Read::Define_Key;
                 }
 
@@ -211,7 +210,7 @@ parse::CPPDirective parse::cppDirective(
                 break;
             case Read::Ifdef_Pre:
                 if (not std::isspace(chr)) {
-                    stream.unget();
+                    lexer.unget();
                     read = Read::Ifdef;
                 }
 
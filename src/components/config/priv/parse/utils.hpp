@@ -19,10 +19,10 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <iostream>
 #include <string>
 
 #include "config/config.hpp"
+#include "config/priv/parse/lexer.hpp"
 #include "log/logger.hpp"
 
 namespace config::priv::parse {
@@ -40,7 +40,10 @@ struct CPPDirective {
     std::string buf2_;
 };
 
-[[nodiscard]] CPPDirective cppDirective(std::istream&, logging::Branch *);
+/**
+ * Read a directive, after its '#', up to the end of the line.
+ */
+[[nodiscard]] CPPDirective cppDirective(Lexer&, logging::Branch *);
 
 void tryAddInjection(Config&, const std::string&);
 
@@ -19,9 +19,9 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <sstream>
 #include <stack>
 
+#include "config/priv/parse/lexer.hpp"
 #include "utils/string.hpp"
 
 using namespace config::priv;
@@ -136,29 +136,28 @@ void style::commentFilter(
 std::string style::format(
     const std::string& in, bool ignoreLength
 ) {
-    std::istringstream stream(in);
+    parse::Lexer lexer{in};
 
     Element root;
 
     // First, extract out everything into `Element`s.
     std::stack<Element *> stack;
     stack.push(&root);
-    while (stream.good()) {
+    while (lexer.good()) {
         auto *current{stack.top()};
 
-        utils::CommentData commentData{
-            .stream_=stream,
+        parse::Lexer::Comments commentData{
             .skipSpaces_=false,
         };
-        if (utils::extractComments(commentData)) {
+        if (lexer.extractComments(commentData)) {
             if (not current->comment_.empty())
                 current->comment_ += '\n';
 
             current->comment_ += commentData.out_;
         }
 
-        const auto chr{stream.get()};
-        if (not stream.good())
+        const auto chr{lexer.get()};
+        if (not lexer.good())
             break;
 
         // Next child
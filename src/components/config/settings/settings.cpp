@@ -19,6 +19,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "config/blades/bladeconfig.hpp"
 #include "config/config.hpp"
 #include "config/priv/io.hpp"
 #include "config/priv/keys.hpp"
@@ -46,6 +47,7 @@ Settings::Settings(Config& parent) :
     massStorage_(root()),
     mountSdSetting_(root()),
     webUsb_(root()),
+    dedupStyles_{.enable_=root(), .threshold_=root()},
     menu_{
         .enable_=root(),
         .specTemplate_=root(),
@@ -117,6 +119,13 @@ Settings::Settings(Config& parent) :
     }()};
     respondWith(bootVolume_.enable_, bootVolEnableTable);
 
+    static const auto dedupStylesEnableTable{[] {
+        data::hier::Bool::RecvTable table;
+        table.onSet_ = data::map<&Settings::onDedupStylesEnable>();
+        return table;
+    }()};
+    respondWith(dedupStyles_.enable_, dedupStylesEnableTable);
+
     static const auto filterEnableTable{[] {
         data::hier::Bool::RecvTable table;
         table.onSet_ = data::map<&Settings::onFilterEnableSet>();
@@ -171,6 +180,9 @@ Settings::Settings(Config& parent) :
     bootVolume_.value_.update({.min_=0, .max_=4000, .inc_=50});
     bootVolume_.value_.set(1000);
 
+    dedupStyles_.threshold_.update({.min_=1, .max_=1000});
+    dedupStyles_.threshold_.set(2);
+
     filter_.cutoff_.update({.min_=1, .max_=10000, .inc_=10});
     filter_.cutoff_.set(100);
 
@@ -209,6 +221,7 @@ void Settings::onActivate() {
     onMassStorageSet();
     onSaveOptSet();
     onBootVolumeEnable();
+    onDedupStylesEnable();
     onFilterEnableSet();
 }
 
@@ -219,6 +232,9 @@ auto Settings::children() const -> std::vector<const Model *> {
 
 		&webUsb_,
 
+		&dedupStyles_.enable_,
+		&dedupStyles_.threshold_,
+
 		&bladeAwareness_,
 
 		&volume_,
@@ -339,6 +355,11 @@ void Settings::onBootVolumeEnable() {
     bootVolume_.value_.enable(ctxt.val());
 }
 
+void Settings::onDedupStylesEnable() {
+    auto ctxt{data::context(dedupStyles_.enable_)};
+    dedupStyles_.threshold_.enable(ctxt.val());
+}
+
 void Settings::onFilterEnableSet() {
     auto ctxt{data::context(filter_.enable_)};
     filter_.order_.enable(ctxt.val());
@@ -570,8 +591,8 @@ bool processDefine(
             auto lowStr{view.substr(0, splitPos)};
             auto highStr{view.substr(splitPos + 1)};
 
-            auto low{utils::doStringMath(lowStr)};
-            auto high{utils::doStringMath(highStr)};
+            auto low{utils::doStringMath(lowStr, blades::ID_CONSTANTS)};
+            auto high{utils::doStringMath(highStr, blades::ID_CONSTANTS)};
 
             if (low and high) {
                 bladeId.noBladeIdRange_.low_.set(static_cast<int32>(*low));
@@ -48,6 +48,12 @@ struct CONFIG_EXPORT Settings : data::hier::Model, data::Receiver {
 
     data::hier::Bool webUsb_;
 
+    // Alias preset styles repeated more than threshold times.
+    struct {
+        data::hier::Bool enable_;
+        data::hier::Integer threshold_;
+    } dedupStyles_;
+
     struct {
         data::hier::Bool enable_;
         data::hier::String specTemplate_;
@@ -159,6 +165,7 @@ protected:
     void onSaveOptSet();
     void onVolume();
     void onBootVolumeEnable();
+    void onDedupStylesEnable();
     void onFilterEnableSet();
     void onDisableTalkieSet();
 
@@ -175,6 +175,9 @@ enum ColorOrder4 {
 constexpr cstring OS_VERSION_STR{"OS_VERSION"};
 constexpr cstring ENABLE_MASS_STORAGE_STR{"ENABLE_MASS_STORAGE"};
 constexpr cstring ENABLE_WEBUSB_STR{"ENABLE_WEBUSB"};
+constexpr cstring DEDUP_STYLES_STR{"DEDUP_STYLES"};
+// Marks a generated style alias, which is inlined back when read.
+constexpr cstring DEDUP_ALIAS_STR{"DEDUP_ALIAS"};
 
 constexpr cstring MOUNT_SD_SETTING_STR{"MOUNT_SD_SETTING"};
 constexpr cstring MENU_SPEC_TEMPLATE_STR{"MENU_SPEC_TEMPLATE"};
@@ -0,0 +1,427 @@
+#include "synth.hpp"
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2026 Ryan Ogurek
+ *
+ * components/config/synth.cpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <random>
+#include <vector>
+
+#include "config/blades/bladeconfig.hpp"
+#include "config/blades/ws281x.hpp"
+#include "config/presets/array.hpp"
+#include "config/presets/preset.hpp"
+#include "config/presets/style.hpp"
+#include "config/priv/generate/check/check.hpp"
+#include "config/priv/io.hpp"
+#include "config/strings.hpp"
+#include "config/styles/style.hpp"
+#include "data/context.hpp"
+#include "log/logger.hpp"
+
+using namespace config;
+
+namespace {
+
+constexpr std::array<std::string_view, 11> COLORS{
+    "Red",
+    "Green",
+    "Blue",
+    "White",
+    "Cyan",
+    "Magenta",
+    "Yellow",
+    "Orange",
+    "DeepSkyBlue",
+    "DodgerBlue",
+    "Black",
+};
+
+constexpr std::array<std::string_view, 7> DATA_PINS{
+    "bladePin",
+    "blade2Pin",
+    "blade3Pin",
+    "blade4Pin",
+    "blade5Pin",
+    "blade6Pin",
+    "blade7Pin",
+};
+
+constexpr std::array<std::string_view, 6> POWER_PINS{
+    "bladePowerPin1",
+    "bladePowerPin2",
+    "bladePowerPin3",
+    "bladePowerPin4",
+    "bladePowerPin5",
+    "bladePowerPin6",
+};
+
+constexpr std::string_view ALIAS_PREFIX{"SynthStyle"};
+
+} // namespace
+
+namespace config::synth {
+
+struct Builder {
+    explicit Builder(const Shape& shape) : mShape{shape}, mRng{shape.seed_} {}
+
+    std::optional<std::string> run(
+        std::unique_ptr<Config>& out, logging::Logger&
+    );
+
+private:
+    void board(Config&);
+    void presetArrays(Config&);
+    void bladeConfigs(Config&);
+    void styleAliases(Config&);
+    void presets(Config&);
+
+    std::string color();
+    std::string layer(size depth);
+    // A full blade style, without the StylePtr
+    std::string base();
+    std::string presetStyle();
+
+    /**
+     * The standard distributions differ between standard libraries, so this
+     * is used instead to build the same config everywhere.
+     *
+     * @return [0, num)
+     */
+    size pick(size num);
+
+    const Shape& mShape;
+    std::mt19937_64 mRng;
+};
+
+} // namespace config::synth
+
+std::optional<std::string> synth::parseShape(std::string_view str, Shape& shape) {
+    constexpr std::array<std::pair<std::string_view, size Shape::*>, 7> FIELDS{{
+        {"arrays", &Shape::presetArrays_},
+        {"presets", &Shape::presets_},
+        {"configs", &Shape::bladeConfigs_},
+        {"blades", &Shape::blades_},
+        {"splits", &Shape::splits_},
+        {"aliases", &Shape::styleAliases_},
+        {"depth", &Shape::styleDepth_},
+    }};
+
+    while (not str.empty()) {
+        const auto end{std::min(str.find(','), str.size())};
+        const auto item{str.substr(0, end)};
+        str.remove_prefix(std::min(end + 1, str.size()));
+
+        const auto eqPos{item.find('=')};
+        if (eqPos == std::string_view::npos) {
+            return "Expected key=value, got \"" + std::string{item} + '"';
+        }
+
+        const auto key{item.substr(0, eqPos)};
+        const auto valStr{item.substr(eqPos + 1)};
+
+        uint64 val{};
+        const auto res{std::from_chars(
+            valStr.data(), valStr.data() + valStr.size(), val
+        )};
+        if (res.ec != std::errc{} or res.ptr != valStr.data() + valStr.size()) {
+            return "Invalid value for " + std::string{key} + ": \"" + std::string{valStr} + '"';
+        }
+
+        if (key == "seed") {
+            shape.seed_ = val;
+            continue;
+        }
+
+        bool found{false};
+        for (const auto& [name, member] : FIELDS) {
+            if (name != key) continue;
+
+            shape.*member = static_cast<size>(val);
+            found = true;
+            break;
+        }
+        if (not found) return "Unknown shape key: \"" + std::string{key} + '"';
+    }
+
+    if (
+            shape.presetArrays_ == 0 or shape.presets_ == 0 or
+            shape.bladeConfigs_ == 0 or shape.blades_ == 0 or
+            shape.splits_ == 0
+       ) {
+        return "Arrays, presets, configs, blades and splits must be at least 1";
+    }
+
+    return std::nullopt;
+}
+
+std::optional<std::string> synth::build(
+    const Shape& shape, std::unique_ptr<Config>& out, logging::Branch *lBranch
+) {
+    auto& logger{logging::Branch::optCreateLogger("config::synth::build()", lBranch)};
+
+    Builder builder{shape};
+    return builder.run(out, logger);
+}
+
+std::optional<std::string> synth::Builder::run(
+    std::unique_ptr<Config>& out, logging::Logger& logger
+) {
+    std::unique_ptr<Config> config{new Config};
+    config->suppressActions();
+
+    if (not config->os()) {
+        return priv::errorMessage(logger, wxTRANSLATE("No OS is installed to build a config for."));
+    }
+
+    board(*config);
+    if (not config->board()) {
+        return priv::errorMessage(logger, wxTRANSLATE("OS has no boards to build a config for."));
+    }
+
+    // Blade configs refer to preset arrays by index, and presets need to know
+    // how many blades there are.
+    presetArrays(*config);
+    bladeConfigs(*config);
+    styleAliases(*config);
+    presets(*config);
+
+    config->unsuppressActions();
+
+    auto err{priv::gen::preCheck(*config, *logger.binfo("Checking..."))};
+    if (err) return err;
+
+    out = std::move(config);
+    return std::nullopt;
+}
+
+void synth::Builder::board(Config& config) {
+    const auto& boards{config.os()->boards_};
+    if (boards.empty()) return;
+
+    auto iter{boards.begin()};
+    std::advance(iter, pick(boards.size()));
+    config.boardChoice().choose(static_cast<int32>(iter->first));
+}
+
+void synth::Builder::presetArrays(Config& config) {
+    auto presetArrays{data::context(config.presetArrays_)};
+    for (size idx{0}; idx < mShape.presetArrays_; ++idx) {
+        auto& array{presetArrays.append<presets::Array>(config)};
+        array.name_.change("synth" + std::to_string(idx));
+    }
+}
+
+void synth::Builder::bladeConfigs(Config& config) {
+    using blades::Blade;
+    using blades::BladeConfig;
+    using blades::WS281X;
+
+    const auto multiple{mShape.bladeConfigs_ > 1};
+    if (multiple) {
+        auto& bladeId{config.settings_.bladeAwareness_.bladeId_};
+        bladeId.enable_.set(true);
+        bladeId.pin_.change("bladeIdentifyPin");
+    }
+
+    // Every blade config needs the same number of blades, so the splits are
+    // decided once.
+    std::vector<size> splits(mShape.blades_);
+    for (auto& num : splits) num = 1 + pick(mShape.splits_);
+
+    auto bladeConfigs{data::context(config.bladeConfigs_)};
+    for (size idx{0}; idx < mShape.bladeConfigs_; ++idx) {
+        auto& bladeConfig{bladeConfigs.append<BladeConfig>(config)};
+
+        if (multiple) {
+            bladeConfig.name_.change("synth" + std::to_string(idx));
+            // Kept apart like real ID resistors.
+            bladeConfig.id_.set(static_cast<int32>(idx * 5000 + pick(5000)));
+        }
+        bladeConfig.presetArray_.choice().choose(
+            static_cast<int32>(idx % mShape.presetArrays_)
+        );
+
+        auto blades{data::context(bladeConfig.blades_)};
+        for (size bladeIdx{0}; bladeIdx < mShape.blades_; ++bladeIdx) {
+            auto& blade{blades.append<Blade>(config)};
+            blade.type().choice().choose(Blade::eWS281X);
+
+            auto& ws281x{blade.ws281x()};
+            const auto numSplits{splits[bladeIdx]};
+            const auto length{std::max<size>(numSplits, 10 + pick(135))};
+
+            ws281x.length_.set(static_cast<int32>(length));
+            ws281x.dataPin_.change(std::string{
+                DATA_PINS[bladeIdx % DATA_PINS.size()]
+            });
+            ws281x.colorOrder3_.choose(static_cast<int32>(pick(eOrder3_Max)));
+            ws281x.powerPins_.select(std::string{
+                POWER_PINS[pick(POWER_PINS.size())]
+            });
+
+            if (numSplits == 1) continue;
+
+            auto splitsCtxt{data::context(ws281x.splits_)};
+            for (size splitIdx{0}; splitIdx < numSplits; ++splitIdx) {
+                auto& split{splitsCtxt.append<WS281X::Split>(ws281x)};
+
+                split.type_.select(WS281X::Split::eStandard);
+                split.start_.set(static_cast<int32>(
+                    splitIdx * length / numSplits
+                ));
+                split.end_.set(static_cast<int32>(
+                    ((splitIdx + 1) * length / numSplits) - 1
+                ));
+            }
+        }
+    }
+}
+
+void synth::Builder::styleAliases(Config& config) {
+    auto styles{data::context(config.styles_)};
+    for (size idx{0}; idx < mShape.styleAliases_; ++idx) {
+        auto& style{styles.append<styles::Style>(config)};
+        style.name_.change(std::string{ALIAS_PREFIX} + std::to_string(idx));
+        style.content_.change(base());
+    }
+}
+
+void synth::Builder::presets(Config& config) {
+    const auto numBlades{static_cast<size>(
+        data::context(config.numBlades()).val()
+    )};
+
+    auto presetArrays{data::context(config.presetArrays_)};
+    for (size arrayIdx{0}; arrayIdx < mShape.presetArrays_; ++arrayIdx) {
+        auto& array{presetArrays.child<presets::Array>(arrayIdx)};
+        auto presetsCtxt{data::context(array.presets_)};
+
+        for (size idx{0}; idx < mShape.presets_; ++idx) {
+            auto& preset{presetsCtxt.append<presets::Preset>(config)};
+
+            const auto tag{std::to_string((arrayIdx * mShape.presets_) + idx)};
+            preset.name_.change("synth " + tag);
+            preset.fontDir_.change("font" + tag);
+            preset.track_.change(
+                "tracks/track" + std::to_string(pick(20)) + ".wav"
+            );
+
+            auto styles{data::context(preset.styles_)};
+            while (styles.children().size() < numBlades) {
+                styles.append<presets::Style>(config);
+            }
+
+            for (const auto& model : styles.children()) {
+                auto& style{dynamic_cast<presets::Style&>(*model)};
+                style.content_.change(presetStyle());
+            }
+        }
+    }
+}
+
+std::string synth::Builder::color() {
+    if (pick(4) != 0) return std::string{COLORS[pick(COLORS.size())]};
+
+    // Appended a piece at a time, since the order operands of + are
+    // evaluated in isn't fixed, and neither would the output be.
+    std::string ret{"Rgb<"};
+    ret += std::to_string(pick(256));
+    ret += ',';
+    ret += std::to_string(pick(256));
+    ret += ',';
+    ret += std::to_string(pick(256));
+    ret += '>';
+    return ret;
+}
+
+std::string synth::Builder::layer(size depth) {
+    if (depth == 0) return color();
+
+    std::string ret;
+    const auto twoLayers{[&]() {
+        ret += layer(depth - 1);
+        ret += ',';
+        ret += layer(depth - 1);
+    }};
+
+    switch (pick(5)) {
+        case 0:
+            ret += "AudioFlicker<";
+            twoLayers();
+            break;
+        case 1:
+            ret += "Stripes<";
+            ret += std::to_string(1000 + pick(20000));
+            ret += ",-";
+            ret += std::to_string(500 + pick(3000));
+            ret += ',';
+            twoLayers();
+            break;
+        case 2:
+            ret += "Pulsing<";
+            twoLayers();
+            ret += ',';
+            ret += std::to_string(200 + pick(3000));
+            break;
+        case 3:
+            ret += "Gradient<";
+            twoLayers();
+            break;
+        default:
+            ret += "Mix<SwingSpeed<400>,";
+            twoLayers();
+            break;
+    }
+
+    ret += '>';
+    return ret;
+}
+
+std::string synth::Builder::base() {
+    std::string ret{"Layers<"};
+    ret += layer(mShape.styleDepth_);
+    ret += ",ResponsiveLockupL<White,TrInstant,TrFade<100>>,BlastL<";
+    ret += color();
+    ret += ">,InOutTrL<TrWipe<";
+    ret += std::to_string(100 + pick(900));
+    ret += ">,TrWipeIn<";
+    ret += std::to_string(100 + pick(900));
+    ret += ">>>";
+    return ret;
+}
+
+std::string synth::Builder::presetStyle() {
+    std::string ret{"StylePtr<"};
+    if (mShape.styleAliases_ != 0 and pick(4) == 0) {
+        ret += ALIAS_PREFIX;
+        ret += std::to_string(pick(mShape.styleAliases_));
+    } else {
+        ret += base();
+    }
+    ret += ">()";
+    return ret;
+}
+
+size synth::Builder::pick(size num) {
+    return static_cast<size>(mRng() % num);
+}
+
@@ -0,0 +1,82 @@
+#pragma once
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2026 Ryan Ogurek
+ *
+ * components/config/synth.hpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "config/config.hpp"
+#include "log/branch.hpp"
+#include "utils/types.hpp"
+
+#include "config_export.h"
+
+/**
+ * Synthetic configs, far bigger than anyone writes by hand, for finding what
+ * doesn't scale.
+ */
+namespace config::synth {
+
+struct Shape {
+    uint64 seed_{0};
+
+    size presetArrays_{1};
+    // Per preset array
+    size presets_{20};
+
+    // Each uses the preset arrays in turn.
+    size bladeConfigs_{1};
+    // WS281X blades per blade config
+    size blades_{2};
+    // Most a blade is split into, 1 to never split.
+    size splits_{1};
+
+    size styleAliases_{0};
+    // How many levels generated styles nest.
+    size styleDepth_{3};
+};
+
+/**
+ * Update shape from a list like "presets=2000,blades=40".
+ *
+ * Keys are seed, arrays, presets, configs, blades, splits, aliases and depth.
+ *
+ * @return err or nullopt
+ */
+CONFIG_EXPORT std::optional<std::string> parseShape(std::string_view, Shape&);
+
+/**
+ * Randomly build a valid config of the given shape. The same shape always
+ * builds the same config.
+ *
+ * Needs at least one OS installed.
+ *
+ * @param out Replaced with the config on success.
+ *
+ * @return err or nullopt
+ */
+CONFIG_EXPORT std::optional<std::string> build(
+    const Shape&, std::unique_ptr<Config>& out, logging::Branch * = nullptr
+);
+
+} // namespace config::synth
+
@@ -19,6 +19,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cassert>
 #include <mutex>
 
@@ -40,7 +41,7 @@ void Model::focus() {
     std::lock_guard scopeLock(*this);
     // If a UI element is attached that would respond to this, it'll focus, if
     // not, this does nothing.
-    sendToObservers<&RecvTable::onFocus_>();
+    deferToObservers<&RecvTable::onFocus_>();
 }
 
 // NOLINTNEXTLINE(readability-make-member-function-const)
@@ -50,16 +51,25 @@ bool Model::setupEnable(bool& en) {
 
 void Model::doEnable(bool en) {
     mEnabled = en;
-    sendToObservers<&RecvTable::onEnable_>();
+    deferToObservers<&RecvTable::onEnable_>();
 }
 
 void Model::sendToObservers(const RecvTableBinding& binding) const {
-    for (auto *receiver : mReceivers) {
+    // A mapping may (de)activate receivers, so go through those here to start
+    // with, skipping any which have left since.
+    const auto receivers{mReceivers};
+    for (auto *receiver : receivers) {
+        if (std::ranges::find(mReceivers, receiver) == mReceivers.end()) {
+            continue;
+        }
+
         std::lock_guard scopeLock(receiver->pMutex);
 
         auto observeIter{receiver->mObserveMap.find(this)};
-        if (observeIter != receiver->mObserveMap.end())
-            binding.tryTable(*receiver, *observeIter->second);
+        if (observeIter != receiver->mObserveMap.end()) {
+            auto& entry{observeIter->second};
+            binding.send(*receiver, *entry.table_, entry.dispatch_);
+        }
     }
 }
 
@@ -70,10 +80,38 @@ void Model::responderHook(const RecvTableBinding&) const {
     // The actual processing is in hier::Model
 }
 
-const std::set<data::Receiver *>& Model::receivers() const {
+void Model::RecvTableBinding::send(
+    Receiver& rcvr,
+    const data::RecvTable& table,
+    Dispatches& dispatch
+) const {
+    auto iter{dispatch.begin()};
+    while (iter != dispatch.end() and iter->id_ != id_) ++iter;
+
+    if (iter == dispatch.end()) {
+        dispatch.push_back(resolve(rcvr, table));
+        iter = std::prev(dispatch.end());
+    }
+
+    // The mapping may change the receiver's tables, don't hold a reference.
+    const auto found{*iter};
+    if (found.func_) invoke(found);
+}
+
+const Model::Receivers& Model::receivers() const {
     return mReceivers;
 }
 
+void Model::addReceiver(Receiver *receiver) const {
+    if (std::ranges::find(mReceivers, receiver) == mReceivers.end())
+        mReceivers.push_back(receiver);
+}
+
+void Model::removeReceiver(Receiver *receiver) const {
+    auto *iter{std::ranges::find(mReceivers, receiver)};
+    if (iter != mReceivers.end()) mReceivers.erase(iter);
+}
+
 Model::ROContext::ROContext(const Model& model) : mModel{&model} {
     mModel->lock();
 }
@@ -19,10 +19,13 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <set>
+#include <cstdint>
+#include <memory>
+#include <tuple>
 
 #include "data/recvtable.hpp"
 #include "utils/hash.hpp"
+#include "utils/smallvec.hpp"
 #include "utils/types.hpp"
 
 #include "data_export.h"
@@ -94,9 +97,33 @@ protected:
         constexpr RecvTableBinding(uint64 id) : id_{id} {}
 
         virtual ~RecvTableBinding() = default;
-        virtual void tryTable(Receiver&, const data::RecvTable&) const = 0;
+
+        /**
+         * Call the mapping in the table for this, if it has one.
+         *
+         * Finding the mapping needs RTTI, so that's only done the first time
+         * for each receiver and model, and kept in the dispatch vec after.
+         */
+        void send(Receiver&, const data::RecvTable&, Dispatches&) const;
+
+        /**
+         * @return A copy which may outlive the send, or nullptr if the
+         *         binding carries args, as those only make sense at the
+         *         moment they're sent.
+         */
+        [[nodiscard]] virtual std::unique_ptr<RecvTableBinding> clone() const {
+            return nullptr;
+        }
 
         uint64 id_;
+        // Set by deferToObservers()
+        bool deferrable_{false};
+
+    protected:
+        [[nodiscard]] virtual Dispatch resolve(
+            Receiver&, const data::RecvTable&
+        ) const = 0;
+        virtual void invoke(const Dispatch&) const = 0;
     };
 
     template <auto MEM_PTR>
@@ -105,6 +132,21 @@ protected:
         sendToObservers(binding);
     }
 
+    /**
+     * Like sendToObservers(), but a hierarchic model may hold it until its
+     * open transaction ends, and then send it only once.
+     *
+     * Only for notifying of a change which has already been made. Anything
+     * observers have to see before a change must go through
+     * sendToObservers(), so it's never held past the change.
+     */
+    template <auto MEM_PTR>
+    constexpr void deferToObservers() const {
+        BindingImpl<MEM_PTR> binding(*this);
+        binding.deferrable_ = true;
+        sendToObservers(binding);
+    }
+
     template <auto MEM_PTR>
     constexpr void responderHook(const auto&... args) const {
         BindingImpl<MEM_PTR> binding(*this, args...);
@@ -114,11 +156,20 @@ protected:
     virtual void sendToObservers(const RecvTableBinding&) const;
     virtual void responderHook(const RecvTableBinding&) const;
 
-    const std::set<Receiver *>& receivers() const;
+    using Receivers = utils::SmallVec<Receiver *, 3>;
+
+    /**
+     * May change during notification, if a mapping (de)activates a receiver,
+     * so iterate by index rather than iterator.
+     */
+    [[nodiscard]] const Receivers& receivers() const;
 
 private:
     friend Receiver;
 
+    void addReceiver(Receiver *) const;
+    void removeReceiver(Receiver *) const;
+
     template <auto MEM_PTR>
     struct BindingImpl;
 
@@ -129,39 +180,58 @@ private:
     >
     struct BindingImpl<MEM_PTR> : RecvTableBinding {
         BindingImpl(const Model& model, const Args&... args) :
-            RecvTableBinding(
-                utils::hash::combine(
-                    typeid(Table).hash_code(),
-                    utils::hash::single(MEM_PTR)
-                )
-            ), mLambda{lambda(model, args...)} {}
-
-        void tryTable(
-            Receiver& rcvr, const data::RecvTable& table
-        ) const override {
-            mLambda(rcvr, table);
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            RecvTableBinding(reinterpret_cast<uintptr_t>(&TAG)),
+            mModel{model},
+            mArgs{args...} {}
+
+        [[nodiscard]] std::unique_ptr<RecvTableBinding> clone() const override {
+            if constexpr (sizeof...(Args) == 0) {
+                return std::make_unique<BindingImpl>(*this);
+            } else {
+                return nullptr;
+            }
         }
 
     private:
-        static auto lambda(const Model& model, const Args&... args) {
-            return [&model, &args...](
-                Receiver& receiver, const data::RecvTable& table
-            ) {
-                if (auto *derived{dynamic_cast<const Table *>(&table)}) {
-                    auto mapping{derived->*MEM_PTR};
-                    if (mapping.func_)
-                        mapping.func_(model, receiver, args...);
-                }
+        using Func = typename data::RecvTable::Mapping<Args...>::Func;
+
+        // Its address is the id, as no other binding's tag can share it.
+        static inline const char TAG{};
+
+        [[nodiscard]] Dispatch resolve(
+            Receiver& rcvr, const data::RecvTable& table
+        ) const override {
+            const auto *derived{dynamic_cast<const Table *>(&table)};
+            if (not derived) return {.id_=id_};
+
+            const auto& mapping{derived->*MEM_PTR};
+            if (not mapping.func_) return {.id_=id_};
+
+            return {
+                .id_=id_,
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+                .func_=reinterpret_cast<void (*)()>(mapping.func_),
+                .rcvr_=mapping.resolve_(rcvr),
             };
-        };
+        }
+
+        void invoke(const Dispatch& dispatch) const override {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            const auto func{reinterpret_cast<Func>(dispatch.func_)};
+
+            std::apply([&](const Args&... args) {
+                func(dispatch.rcvr_, mModel, args...);
+            }, mArgs);
+        }
 
-        decltype(lambda(
-            std::declval<Model&>(), std::declval<const Args&>()...
-        )) mLambda;
+        const Model& mModel;
+        // Only referenced, since only bindings w/o args outlive the send.
+        std::tuple<const Args&...> mArgs;
     };
 
     bool mEnabled{true};
-    mutable std::set<Receiver *> mReceivers;
+    mutable Receivers mReceivers;
 };
 
 struct DATA_EXPORT Model::ROContext {
@@ -41,7 +41,7 @@ void Bool::doSet(bool undo, bool val) {
 
     mValue = val;
 
-    sendToObservers<&RecvTable::onSet_>();
+    deferToObservers<&RecvTable::onSet_>();
 
     if (not undo)
         responderHook<&RecvTable::onSet_>();
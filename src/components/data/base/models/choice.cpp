@@ -55,7 +55,7 @@ int32 Choice::doChoose(bool undo, int32 idx) {
 
     mIdx = idx;
 
-    sendToObservers<&RecvTable::onChoice_>();
+    deferToObservers<&RecvTable::onChoice_>();
 
     if (not undo)
         responderHook<&RecvTable::onChoice_>();
@@ -108,7 +108,7 @@ std::pair<uint32, int32> Choice::doUpdate(bool undo, uint32 num, int32 idx) {
     sendToObservers<&RecvTable::onUpdate_>(info);
 
     if (not info.choicePreserved_)
-        sendToObservers<&RecvTable::onChoice_>();
+        deferToObservers<&RecvTable::onChoice_>();
 
     if (not undo) {
         responderHook<&RecvTable::onUpdate_>(info);
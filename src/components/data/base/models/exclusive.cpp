@@ -87,7 +87,7 @@ void Exclusive::onSet(const Model& model) {
     }
 
     mSelected = selIdx;
-    sendToObservers<&RecvTable::onSelection_>();
+    deferToObservers<&RecvTable::onSelection_>();
 }
 
 Exclusive::ROContext::ROContext(const Exclusive& excl) :
@@ -59,7 +59,7 @@ T detail::Number<T>::doSet(bool undo, T val) {
     auto ret{mValue};
     mValue = val;
 
-    sendToObservers<&RecvTable::onSet_>();
+    deferToObservers<&RecvTable::onSet_>();
 
     if (not undo)
         responderHook<&RecvTable::onSet_>();
@@ -97,10 +97,10 @@ auto detail::Number<T>::doUpdate(
         clamp(mValue);
     }
 
-    sendToObservers<&RecvTable::onUpdate_>();
+    deferToObservers<&RecvTable::onUpdate_>();
 
     if (lastVal != mValue)
-        sendToObservers<&RecvTable::onSet_>();
+        deferToObservers<&RecvTable::onSet_>();
 
     if (not undo) {
         responderHook<&RecvTable::onUpdate_>();
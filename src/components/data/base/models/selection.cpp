@@ -94,7 +94,7 @@ Selection::doSetItems(
         mSelected = std::move(selected);
     }
 
-    sendToObservers<&RecvTable::onItems_>();
+    deferToObservers<&RecvTable::onItems_>();
 
     if (not undo)
         responderHook<&RecvTable::onItems_>();
@@ -116,12 +116,12 @@ void Selector::onChoice() {
     auto ctxt{context(choice())};
 
     if (canMoveUp(ctxt) != mLastCanMoveUp) {
-        sendToObservers<&RecvTable::onCanMoveUp_>();
+        deferToObservers<&RecvTable::onCanMoveUp_>();
         mLastCanMoveUp = canMoveUp(ctxt);
     }
 
     if (canMoveDown(ctxt) != mLastCanMoveDown) {
-        sendToObservers<&RecvTable::onCanMoveDown_>();
+        deferToObservers<&RecvTable::onCanMoveDown_>();
         mLastCanMoveDown = canMoveDown(ctxt);
     }
 }
@@ -66,10 +66,10 @@ std::pair<std::string, size> String::doChange(
     auto lastPos{mPos};
     mPos = pos;
 
-    sendToObservers<&RecvTable::onChange_>();
+    deferToObservers<&RecvTable::onChange_>();
 
     if (moved)
-        sendToObservers<&RecvTable::onMove_>();
+        deferToObservers<&RecvTable::onMove_>();
 
     if (not undo) {
         responderHook<&RecvTable::onChange_>();
@@ -81,6 +81,40 @@ std::pair<std::string, size> String::doChange(
     return {lastStr, lastPos};
 }
 
+size String::doEdit(
+    bool undo, size offset, size len, std::string_view str, size pos
+) {
+    assert(offset + len <= mValue.length());
+
+    auto moved{mPos != pos};
+
+    if (undo) {
+        if (moved)
+            responderHook<&RecvTable::onMove_>();
+
+        responderHook<&RecvTable::onChange_>();
+    }
+
+    mValue.replace(offset, len, str);
+
+    auto lastPos{mPos};
+    mPos = pos;
+
+    deferToObservers<&RecvTable::onChange_>();
+
+    if (moved)
+        deferToObservers<&RecvTable::onMove_>();
+
+    if (not undo) {
+        responderHook<&RecvTable::onChange_>();
+
+        if (moved)
+            responderHook<&RecvTable::onMove_>();
+    }
+
+    return lastPos;
+}
+
 // NOLINTNEXTLINE(readability-make-member-function-const)
 bool String::setupMove(size pos) {
     return pos != mPos;
@@ -93,7 +127,7 @@ size String::doMove(bool undo, size pos) {
     auto ret{mPos};
     mPos = pos;
 
-    sendToObservers<&RecvTable::onMove_>();
+    deferToObservers<&RecvTable::onMove_>();
 
     if (not undo)
         responderHook<&RecvTable::onMove_>();
@@ -20,6 +20,7 @@
  */
 
 #include <string>
+#include <string_view>
 
 #include "data/base/model.hpp"
 #include "utils/types.hpp"
@@ -28,8 +29,7 @@
 
 namespace data::base {
 
-// TODO: The actions for this would like to be more space efficient, and
-//       preserve things like selection?
+// TODO: The actions for this would like to preserve things like selection?
 struct DATA_EXPORT String : virtual Model {
     struct DATA_EXPORT ROContext;
     struct DATA_EXPORT Context;
@@ -64,6 +64,15 @@ protected:
     bool setupChange(std::string&, size&);
     std::pair<std::string, size> doChange(bool undo, std::string&&, size);
 
+    /**
+     * Replace len chars at offset with str in place, and move to pos.
+     *
+     * @return the last pos
+     */
+    size doEdit(
+        bool undo, size offset, size len, std::string_view str, size pos
+    );
+
     bool setupMove(size);
     size doMove(bool undo, size);
 
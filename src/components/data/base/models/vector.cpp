@@ -54,6 +54,7 @@ void Vector::doInsert(bool undoRemove, size idx, std::unique_ptr<Model>&& obj) {
     );
 
     sendToObservers<&RecvTable::onInsert_>(idx);
+    deferToObservers<&RecvTable::onResized_>();
 
     if (not undoRemove)
         responderHook<&RecvTable::onInsert_>(idx);
@@ -80,6 +81,7 @@ std::unique_ptr<Model> Vector::doRemove(bool undoInsert, size idx) {
     mChildren.erase(iter);
 
     sendToObservers<&RecvTable::onRemove_>(idx);
+    deferToObservers<&RecvTable::onResized_>();
 
     if (not undoInsert)
         responderHook<&RecvTable::onRemove_>(idx);
@@ -153,6 +153,12 @@ struct DATA_EXPORT Vector::RecvTable : Model::RecvTable {
      * Models at pos and pos + 1 swapped.
      */
     Mapping<size> onSwap_;
+
+    /**
+     * Models were inserted or removed. Follows onInsert_ and onRemove_, but
+     * is deferred, so a transaction doing many sends it once at the end.
+     */
+    Mapping<> onResized_;
 };
 
 } // namespace data::base
@@ -34,7 +34,7 @@ utils::Version Version::doSet(bool undo, utils::Version&& ver) {
     auto ret{std::move(mVer)};
     mVer = std::move(ver);
 
-    sendToObservers<&RecvTable::onSet_>();
+    deferToObservers<&RecvTable::onSet_>();
 
     if (not undo)
         responderHook<&RecvTable::onSet_>();
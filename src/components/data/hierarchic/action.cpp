@@ -19,6 +19,8 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "data/hierarchic/model.hpp"
+
 using namespace data::hier;
 
 Action::Action() = default;
@@ -29,3 +31,28 @@ bool Action::maybeCoalesce(Action&) {
     return false;
 }
 
+size Action::footprint() const {
+    return sizeof(Action);
+}
+
+size Action::totalFootprint() const {
+    auto ret{footprint()};
+
+    for (const auto& [_, child] : mChildren) {
+        ret += sizeof(decltype(mChildren)::value_type);
+        ret += child->totalFootprint();
+    }
+
+    return ret;
+}
+
+void Action::doPerform() {
+    perform();
+    mSource->invalidateHash();
+}
+
+void Action::doRetract() {
+    retract();
+    mSource->invalidateHash();
+}
+
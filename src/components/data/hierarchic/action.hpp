@@ -20,6 +20,7 @@
  */
 
 #include <cassert>
+#include <chrono>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -42,10 +43,12 @@ struct DATA_EXPORT Action {
     virtual ~Action();
 
     /**
-     * If a new action is added that matches the type of the previous one,
-     * this will be called on the previous with the new to provide an
-     * opportunity to coalesce the actions together, however is appropriate
-     * for the action.
+     * If a new action is added that matches the type and source of the
+     * previous one shortly after it, this will be called on the previous with
+     * the new to provide an opportunity to coalesce the actions together,
+     * however is appropriate for the action. Both have been performed.
+     *
+     * Only called for actions without any child actions.
      *
      * By default, this does nothing.
      *
@@ -70,6 +73,14 @@ struct DATA_EXPORT Action {
      */
     virtual void retract() = 0;
 
+    /**
+     * Estimated bytes held by this action, not counting child actions.
+     *
+     * By default, this is only the base. Actions which hold onto strings,
+     * vectors, or models should override this to count them.
+     */
+    [[nodiscard]] virtual size footprint() const;
+
 protected:
     Action();
 
@@ -83,8 +94,28 @@ private:
     friend Model;
     friend Root;
 
+    /**
+     * perform() or retract(), and invalidate the hash of the source.
+     */
+    void doPerform();
+    void doRetract();
+
+    /**
+     * footprint() of this and all child actions.
+     */
+    [[nodiscard]] size totalFootprint() const;
+
     Model *mSource{nullptr};
 
+    // totalFootprint() when recorded into the history.
+    size mFootprint{0};
+
+    // When recorded, or last coalesced into.
+    std::chrono::steady_clock::time_point mTime;
+
+    // Undone and redone together with the action before it.
+    bool mJoined{false};
+
     std::vector<std::pair<uint64, std::unique_ptr<Action>>> mChildren;
 };
 
@@ -19,6 +19,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cassert>
 
 #include "data/hierarchic/root.hpp"
@@ -32,6 +33,12 @@ Model::Model(Root& root) : mRoot{root} {}
 Model::Model(const Model& other, Root& root) :
     base::Model(other), mRoot{root} {}
 
+Model::~Model() {
+    // The root's own members are already gone, and a root is never removed
+    // mid-transaction anyways.
+    if (this != &mRoot) mRoot.dropDeferred(*this);
+}
+
 bool Model::enable(bool en) {
     return processAction(std::make_unique<EnableAction>(en));
 }
@@ -67,18 +74,51 @@ std::vector<const Model *> Model::children() const {
 uint64 Model::hash(uint64 seed) const {
     std::lock_guard scopeLock(*this);
 
-    auto ret{utils::hash::combine(seed, hashThis())};
+    return utils::hash::combine(seed, subtreeHash());
+}
+
+uint64 Model::subtreeHash() const {
+    if (mHashValid) return mHash;
+
+    auto ret{hashThis()};
+    auto isVolatile{not cacheHash()};
 
-    for (const auto *child : childrenToHash())
-        ret = child->hash(ret);
+    for (const auto *child : childrenToHash()) {
+        ret = utils::hash::combine(ret, child->subtreeHash());
+
+        child->mHashParent = this;
+        isVolatile = isVolatile or child->mHashVolatile;
+    }
+
+    ++mRoot.mHashesComputed;
+
+    mHash = ret;
+    mHashVolatile = isVolatile;
+    mHashValid = not isVolatile;
 
     return ret;
 }
 
+void Model::invalidateHash() const {
+    // Anything already invalid has had everything above invalidated too, or
+    // was never hashed by its parent.
+    for (
+            const auto *model{this};
+            model and model->mHashValid;
+            model = model->mHashParent
+        ) {
+        model->mHashValid = false;
+    }
+}
+
 uint64 Model::hashThis() const {
     return 0;
 }
 
+bool Model::cacheHash() const {
+    return true;
+}
+
 std::vector<const Model *> Model::childrenToHash() const {
     return children();
 }
@@ -117,7 +157,7 @@ bool Model::processAction(std::unique_ptr<Action>&& action) {
     if (mRoot.isActuallyCapturing())
         mRoot.recordAction(std::move(action));
 
-    store->perform();
+    store->doPerform();
 
     if (mRoot.isActuallyCapturing())
         mRoot.finishCapture();
@@ -126,6 +166,16 @@ bool Model::processAction(std::unique_ptr<Action>&& action) {
 }
 
 void Model::sendToObservers(const RecvTableBinding& binding) const {
+    // Nobody to tell, and nothing to hold on to.
+    if (receivers().empty()) return;
+
+    if (mRoot.mDeferDepth != 0 and binding.deferrable_) {
+        if (auto deferred{binding.clone()}) {
+            mRoot.defer(*this, std::move(deferred));
+            return;
+        }
+    }
+
     mRoot.mStates.push_back(Root::State::In_Observer);
 
     data::base::Model::sendToObservers(binding);
@@ -145,12 +195,20 @@ void Model::responderHook(const RecvTableBinding& binding) const {
             curFrame.responderId_ = binding.id_;
         }
 
-        for (auto *receiver : receivers()) {
+        // Receivers may leave mid-dispatch, as in sendToObservers()
+        const auto rcvrs{receivers()};
+        for (auto *receiver : rcvrs) {
+            if (std::ranges::find(receivers(), receiver) == receivers().end()) {
+                continue;
+            }
+
             std::lock_guard scopeLock(receiver->pMutex);
 
             auto iter{receiver->mRespondMap.find(this)};
-            if (iter != receiver->mRespondMap.end())
-                binding.tryTable(*receiver, *iter->second);
+            if (iter != receiver->mRespondMap.end()) {
+                auto& entry{iter->second};
+                binding.send(*receiver, *entry.table_, entry.dispatch_);
+            }
         }
 
         if (state == Root::State::Performance) {
@@ -175,7 +233,7 @@ void Model::responderHook(const RecvTableBinding& binding) const {
                 newFrame.replayIdx_ = action->mChildren.size() - 1;
                 newFrame.action_ = action.get();
 
-                action->retract();
+                action->doRetract();
 
                 mRoot.mActionFrames.pop_back();
             }
@@ -202,7 +260,7 @@ void Model::responderHook(const RecvTableBinding& binding) const {
                 newFrame.replayIdx_ = 0;
                 newFrame.action_ = action.get();
 
-                action->perform();
+                action->doPerform();
 
                 mRoot.mActionFrames.pop_back();
             }
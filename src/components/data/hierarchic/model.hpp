@@ -43,6 +43,7 @@ struct DATA_EXPORT Model : virtual base::Model {
     Model(const Model&, Root&);
 
     Model(const Model &) = delete;
+    ~Model() override;
 
     template<typename T = Root>
     T& root() const {
@@ -58,6 +59,13 @@ struct DATA_EXPORT Model : virtual base::Model {
     std::vector<Model *> children();
     virtual std::vector<const Model *> children() const;
 
+    /**
+     * Hash of this model and everything under it.
+     *
+     * The hash of each model is kept until an action is performed on it or
+     * anything under it, so only the path down to what changed is hashed
+     * again.
+     */
     [[nodiscard]] uint64 hash(uint64 = 0) const;
 
 protected:
@@ -68,6 +76,14 @@ protected:
      */
     virtual uint64 hashThis() const;
 
+    /**
+     * Whether hashThis() can be kept between actions.
+     *
+     * Models which hash something outside the model (e.g. a file) must
+     * return false, and then they and their parents are always rehashed.
+     */
+    [[nodiscard]] virtual bool cacheHash() const;
+
     /**
      * If the children which should be hashed differ from the all model's
      * children, the model may override this to specialize.
@@ -82,7 +98,24 @@ protected:
     void responderHook(const RecvTableBinding&) const override;
 
 private:
+    friend Action;
+    friend Root;
+
+    [[nodiscard]] uint64 subtreeHash() const;
+
+    /**
+     * Drop the kept hash for this and every parent up.
+     */
+    void invalidateHash() const;
+
     Root& mRoot;
+
+    // The model this was last hashed under, for invalidating upwards.
+    mutable const Model *mHashParent{nullptr};
+    mutable uint64 mHash{0};
+    mutable bool mHashValid{false};
+    // This, or something under it, can't be kept.
+    mutable bool mHashVolatile{false};
 };
 
 struct DATA_EXPORT Model::EnableAction : Action {
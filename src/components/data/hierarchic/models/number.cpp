@@ -56,6 +56,11 @@ uint64 detail::Number<T>::hashThis() const {
 template <typename T>
 detail::Number<T>::SetAction::SetAction(T val) : mValue{val} {}
 
+template <typename T>
+bool detail::Number<T>::SetAction::maybeCoalesce(Action&) {
+    return true;
+}
+
 template <typename T>
 bool detail::Number<T>::SetAction::setup() {
     return source<Number<T>>().setupSet(mValue);
@@ -47,6 +47,11 @@ template <typename T>
 struct DATA_EXPORT Number<T>::SetAction : Action {
     SetAction(T);
 
+    /**
+     * Repeated sets (e.g. dragging or stepping) only need the first value.
+     */
+    bool maybeCoalesce(Action&) override;
+
     bool setup() override;
     void perform() override;
     void retract() override;
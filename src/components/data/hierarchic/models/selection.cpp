@@ -107,6 +107,15 @@ void Selection::SetItemsAction::retract() {
     mItems = std::move(orig.first);
 }
 
+size Selection::SetItemsAction::footprint() const {
+    auto ret{sizeof(*this) + (mSelected.capacity() / 8)};
+
+    ret += mItems.capacity() * sizeof(std::string);
+    for (const auto& item : mItems) ret += item.capacity();
+
+    return ret;
+}
+
 Selection::InsertAction::InsertAction(uint32 idx, std::string&& item) :
     mIdx{idx}, mItem{std::move(item)} {}
 
@@ -122,6 +131,10 @@ void Selection::InsertAction::retract() {
     mItem = std::move(source<Selection>().doRemove(true, mIdx).first);
 }
 
+size Selection::InsertAction::footprint() const {
+    return sizeof(*this) + mItem.capacity();
+}
+
 Selection::RemoveAction::RemoveAction(uint32 idx) : mIdx{idx} {}
 
 bool Selection::RemoveAction::setup() {
@@ -138,3 +151,7 @@ void Selection::RemoveAction::retract() {
     source<Selection>().doInsert(true, mIdx, std::move(mItem), mSelected);
 }
 
+size Selection::RemoveAction::footprint() const {
+    return sizeof(*this) + mItem.capacity();
+}
+
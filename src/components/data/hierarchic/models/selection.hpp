@@ -63,6 +63,7 @@ struct DATA_EXPORT Selection::SetItemsAction : Action {
     bool setup() override;
     void perform() override;
     void retract() override;
+    [[nodiscard]] size footprint() const override;
 
 private:
     std::vector<std::string> mItems;
@@ -75,6 +76,7 @@ struct DATA_EXPORT Selection::InsertAction : Action {
     bool setup() override;
     void perform() override;
     void retract() override;
+    [[nodiscard]] size footprint() const override;
 
 private:
     const uint32 mIdx;
@@ -87,6 +89,7 @@ struct DATA_EXPORT Selection::RemoveAction : Action {
     bool setup() override;
     void perform() override;
     void retract() override;
+    [[nodiscard]] size footprint() const override;
 
 private:
     const uint32 mIdx;
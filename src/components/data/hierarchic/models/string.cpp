@@ -19,6 +19,9 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <cctype>
+
 #include "utils/hash.hpp"
 
 using namespace data::hier;
@@ -44,20 +47,92 @@ uint64 String::hashThis() const {
 String::ChangeAction::ChangeAction(std::string&& str, size pos) :
     mStr{std::move(str)}, mPos{pos} {}
 
+bool String::ChangeAction::maybeCoalesce(Action& action) {
+    auto *next{static_cast<ChangeAction *>(&action)};
+
+    const auto isTyping{mRemoved.empty() and next->mRemoved.empty()};
+    const auto isDeleting{mInserted.empty() and next->mInserted.empty()};
+
+    if (isTyping and next->mOffset == mOffset + mInserted.length()) {
+        const auto isSpace{[](char chr) {
+            return std::isspace(static_cast<unsigned char>(chr)) != 0;
+        }};
+
+        // Start of a new word, keep it separate.
+        if (
+                not mInserted.empty() and not next->mInserted.empty() and
+                isSpace(mInserted.back()) and
+                not isSpace(next->mInserted.front())
+           ) {
+            return false;
+        }
+
+        mInserted += next->mInserted;
+        return true;
+    }
+
+    // Backspace
+    if (isDeleting and next->mOffset + next->mRemoved.length() == mOffset) {
+        mRemoved.insert(0, next->mRemoved);
+        mOffset = next->mOffset;
+        return true;
+    }
+
+    // Delete
+    if (isDeleting and next->mOffset == mOffset) {
+        mRemoved += next->mRemoved;
+        return true;
+    }
+
+    return false;
+}
+
 bool String::ChangeAction::setup() {
-    return source<String>().setupChange(mStr, mPos);
+    if (not source<String>().setupChange(mStr, mPos)) return false;
+
+    const auto& last{ROContext(source<String>()).val()};
+
+    // Narrow down to the span which actually changed.
+    size prefix{0};
+    const auto maxLen{std::min(last.length(), mStr.length())};
+    while (prefix < maxLen and last[prefix] == mStr[prefix]) ++prefix;
+
+    size suffix{0};
+    while (
+            prefix + suffix < maxLen and
+            last[last.length() - suffix - 1] == mStr[mStr.length() - suffix - 1]
+          ) {
+        ++suffix;
+    }
+
+    mOffset = prefix;
+    mRemoved = last.substr(prefix, last.length() - prefix - suffix);
+    mInserted = mStr.substr(prefix, mStr.length() - prefix - suffix);
+
+    mStr.clear();
+    mStr.shrink_to_fit();
+
+    return true;
 }
 
 void String::ChangeAction::perform() {
-    auto last{source<String>().doChange(false, std::move(mStr), mPos)};
-    mStr = std::move(last.first);
-    mPos = last.second;
+    mPos = source<String>().doEdit(
+        false, mOffset, mRemoved.length(), mInserted, mPos
+    );
 }
 
 void String::ChangeAction::retract() {
-    auto orig{source<String>().doChange(true, std::move(mStr), mPos)};
-    mStr = std::move(orig.first);
-    mPos = orig.second;
+    mPos = source<String>().doEdit(
+        true, mOffset, mInserted.length(), mRemoved, mPos
+    );
+}
+
+size String::ChangeAction::footprint() const {
+    return
+        sizeof(*this) +
+        mStr.capacity() +
+        mRemoved.capacity() +
+        mInserted.capacity();
 }
 
 String::MoveAction::MoveAction(size pos) : mPos{pos} {}
@@ -41,16 +41,32 @@ protected:
     uint64 hashThis() const override;
 };
 
+/**
+ * Only the edit from the last value is kept: the span replaced, and what it
+ * was replaced with.
+ */
 struct DATA_EXPORT String::ChangeAction : Action {
     ChangeAction(std::string&&, size);
 
+    /**
+     * Continued typing, backspacing, or deleting is merged into one action,
+     * broken up at the start of each word typed.
+     */
+    bool maybeCoalesce(Action&) override;
+
     bool setup() override;
     void perform() override;
     void retract() override;
+    [[nodiscard]] size footprint() const override;
 
 private:
+    // Only the full new value until setup().
     std::string mStr;
     size mPos;
+
+    size mOffset{0};
+    std::string mRemoved;
+    std::string mInserted;
 };
 
 struct DATA_EXPORT String::MoveAction : Action {
@@ -24,6 +24,25 @@
 
 using namespace data::hier;
 
+namespace {
+
+/**
+ * Rough guess at the bytes held by a model, counting only the base of each
+ * model in the tree.
+ */
+size modelFootprint(const data::base::Model *model) {
+    const auto *hierModel{dynamic_cast<const data::hier::Model *>(model)};
+    if (not hierModel) return model ? sizeof(data::base::Model) : 0;
+
+    size ret{sizeof(data::hier::Model)};
+    for (const auto *child : hierModel->children())
+        ret += modelFootprint(child);
+
+    return ret;
+}
+
+} // namespace
+
 Vector::Vector(Root& root) : Model(root) {}
 
 // No copy ctor. Don't know how to copy children (or if they even can be).
@@ -79,6 +98,10 @@ void Vector::InsertAction::retract() {
     mModel = source<Vector>().doRemove(true, mPos);
 }
 
+size Vector::InsertAction::footprint() const {
+    return sizeof(*this) + modelFootprint(mModel.get());
+}
+
 Vector::RemoveAction::RemoveAction(size pos) : mPos{pos} {}
 
 bool Vector::RemoveAction::setup() {
@@ -99,6 +122,10 @@ void Vector::RemoveAction::retract() {
     Receiver::maybeActivate(raw);
 }
 
+size Vector::RemoveAction::footprint() const {
+    return sizeof(*this) + modelFootprint(mModel.get());
+}
+
 Vector::ClearAction::ClearAction() = default;
 
 bool Vector::ClearAction::setup() {
@@ -122,6 +149,15 @@ void Vector::ClearAction::retract() {
     mModels.clear();
 }
 
+size Vector::ClearAction::footprint() const {
+    auto ret{sizeof(*this)};
+
+    ret += mModels.capacity() * sizeof(decltype(mModels)::value_type);
+    for (const auto& model : mModels) ret += modelFootprint(model.get());
+
+    return ret;
+}
+
 Vector::SwapAction::SwapAction(size pos) : mPos{pos} {}
 
 bool Vector::SwapAction::setup() {
@@ -49,6 +49,7 @@ struct DATA_EXPORT Vector::InsertAction : Action {
     bool setup() override;
     void perform() override;
     void retract() override;
+    [[nodiscard]] size footprint() const override;
 
 private:
     const size mPos;
@@ -61,6 +62,7 @@ struct DATA_EXPORT Vector::RemoveAction : Action {
     bool setup() override;
     void perform() override;
     void retract() override;
+    [[nodiscard]] size footprint() const override;
 
 private:
     const size mPos;
@@ -73,6 +75,7 @@ struct DATA_EXPORT Vector::ClearAction : Action {
     bool setup() override;
     void perform() override;
     void retract() override;
+    [[nodiscard]] size footprint() const override;
 
 private:
     std::vector<std::unique_ptr<base::Model>> mModels;
@@ -20,7 +20,9 @@
  */
 
 #include <cassert>
+#include <chrono>
 #include <mutex>
+#include <typeinfo>
 
 using namespace data::hier;
 
@@ -48,17 +50,19 @@ void Root::unsuppressActions(bool clearHistory) {
         auto couldRedo{canRedo()};
 
         mActions.clear();
+        mActionsFootprint = 0;
         const auto lastIdx{mActionIdx};
         mActionIdx = eAct_Idx_First;
 
         sendToObservers<&RecvTable::onActionClear_>(lastIdx);
-        sendToObservers<&RecvTable::onAction_>();
+        deferToObservers<&RecvTable::onAction_>();
+        sendToObservers<&RecvTable::onHistory_>(0UZ, 0UZ);
 
         // If could, can't anymore
         if (couldUndo)
-            sendToObservers<&RecvTable::onCanUndo_>();
+            deferToObservers<&RecvTable::onCanUndo_>();
         if (couldRedo)
-            sendToObservers<&RecvTable::onCanRedo_>();
+            deferToObservers<&RecvTable::onCanRedo_>();
     }
 
     mStates.pop_back();
@@ -150,34 +154,83 @@ void Root::beginReplay(bool undo, Action& action) {
 
 void Root::endReplay() {
     assert(mActionFrames.size() == 1);
+    assert(
+        mStates.back() == State::Replay_Undo or
+        mStates.back() == State::Replay_Redo
+    );
 
-    auto& frame{mActionFrames.back()};
-    auto& children{frame.action_->mChildren};
+    replayChildren(mStates.back() == State::Replay_Undo);
 
-    if (mStates.back() == State::Replay_Undo) {
-        for (; frame.replayIdx_ != -1UZ; --frame.replayIdx_) {
-            const auto& child{children[frame.replayIdx_]};
+    mActionFrames.pop_back();
+    mStates.pop_back();
+}
 
-            // These should all be 0 responder id. Any others should've been
-            // caught during normal processing.
-            assert(child.first == 0);
+void Root::replayChildren(bool undo) {
+    // The frame vec may be grown in the process, so don't keep a reference.
+    const auto frameIdx{mActionFrames.size() - 1};
 
-            child.second->retract();
-        }
-    } else if (mStates.back() == State::Replay_Redo) {
-        for (; frame.replayIdx_ != children.size(); ++frame.replayIdx_) {
-            const auto& child{children[frame.replayIdx_]};
+    while (not false) {
+        auto& frame{mActionFrames[frameIdx]};
+        auto& children{frame.action_->mChildren};
 
-            // These should all be 0 responder id. Any others should've been
-            // caught during normal processing.
-            assert(child.first == 0);
+        if (undo ? frame.replayIdx_ == -1UZ : frame.replayIdx_ == children.size())
+            break;
 
-            child.second->perform();
-        }
-    } else assert(0);
+        const auto& [id, action]{children[frame.replayIdx_]};
 
-    mActionFrames.pop_back();
-    mStates.pop_back();
+        // These should all be 0 responder id. Any others should've been
+        // caught during normal processing.
+        assert(id == 0);
+
+        auto *child{action.get()};
+        if (undo) --frame.replayIdx_;
+        else ++frame.replayIdx_;
+
+        auto& newFrame{mActionFrames.emplace_back()};
+        newFrame.replayIdx_ = undo ? child->mChildren.size() - 1 : 0;
+        newFrame.action_ = child;
+
+        if (undo) child->doRetract();
+        else child->doPerform();
+
+        mActionFrames.pop_back();
+    }
+}
+
+void Root::beginDefer() {
+    ++mDeferDepth;
+}
+
+void Root::endDefer() {
+    assert(mDeferDepth != 0);
+
+    if (--mDeferDepth != 0) return;
+
+    // Anything sent to observers now goes right through, and observers can't
+    // cause further actions, so nothing is added while these are sent.
+    auto deferred{std::move(mDeferred)};
+    mDeferred.clear();
+    mDeferredKeys.clear();
+
+    for (const auto& [model, binding] : deferred)
+        model->sendToObservers(*binding);
+}
+
+void Root::defer(
+    const Model& model, std::unique_ptr<RecvTableBinding>&& binding
+) {
+    if (not mDeferredKeys.emplace(&model, binding->id_).second) return;
+
+    mDeferred.emplace_back(&model, std::move(binding));
+}
+
+void Root::dropDeferred(const Model& model) {
+    std::erase_if(mDeferred, [&](const auto& entry) {
+        if (entry.first != &model) return false;
+
+        mDeferredKeys.erase({&model, entry.second->id_});
+        return true;
+    });
 }
 
 void Root::recordAction(std::unique_ptr<Action>&& action) {
@@ -209,44 +262,117 @@ void Root::finishCapture() {
     if (mPerformanceNesting != 0)
         return;
 
-    // Try coalesce before anything else
-    // if (
-    //         // There's a prior action.
-    //         mActionIdx > 0 and
-    //         // For now, only try to coalesce individual actions. Other
-    //         // situations are more complicated than I care to deal with for
-    //         // now.
-    //         mActions[mActionIdx - 1].size() == 1 and
-    //         mActions[mActionIdx].size() == 1
-    //    ) {
-    //     auto& lastAct{*mActions[mActionIdx - 1][0]};
-    //     auto& newAct{*mActions[mActionIdx][0]};
-    //     if (lastAct.maybeCoalesce(newAct)) {
-    //         mActions.pop_back();
-    //         --mActionIdx;
-    //     }
-    // }
+    // Undo was available before this action if there's one prior.
+    const auto couldUndo{mActionIdx != 0};
 
     // If there are actions on the redo side, they need to be cleared.
     if (mActions.size() > mActionIdx + 1) {
+        for (auto idx{mActionIdx + 1}; idx < mActions.size(); ++idx)
+            mActionsFootprint -= mActions[idx]->mFootprint;
+
         // Truncate the actions, removing any available redo.
         mActions.resize(mActionIdx + 1);
 
         // Cleared; can't anymore
-        sendToObservers<&RecvTable::onCanRedo_>();
+        deferToObservers<&RecvTable::onCanRedo_>();
     }
 
+    if (not maybeCoalesce()) {
+        auto& action{*mActions[mActionIdx]};
+        action.mTime = now();
+        action.mFootprint = action.totalFootprint();
+        mActionsFootprint += action.mFootprint;
+    }
+
+    trimHistory();
+
     // Call after all processing is complete.
-    sendToObservers<&RecvTable::onAction_>();
+    deferToObservers<&RecvTable::onAction_>();
 
     // This is the first action, undo is available now, and it was not
     // prior.
-    if (mActions.size() == 1)
-        sendToObservers<&RecvTable::onCanUndo_>();
+    if (not couldUndo)
+        deferToObservers<&RecvTable::onCanUndo_>();
+
+    sendToObservers<&RecvTable::onHistory_>(
+        mActions.size(), mActionsFootprint
+    );
 
     mStates.pop_back();
 }
 
+bool Root::maybeCoalesce() {
+    if (mActionIdx == 0) return false;
+
+    auto& last{*mActions[mActionIdx - 1]};
+    auto& action{*mActions[mActionIdx]};
+
+    const auto time{now()};
+    if (
+            // Transactions are each their own step.
+            action.mSource == this or
+            last.mSource != action.mSource or
+            typeid(last) != typeid(action) or
+            time - last.mTime > std::chrono::milliseconds{eCoalesce_Window_Ms}
+       ) {
+        return false;
+    }
+
+    // Anything caused in response is tied to the responders being hit for
+    // each action, so these can only be replayed together, not merged.
+    if (not last.mChildren.empty() or not action.mChildren.empty()) {
+        action.mJoined = true;
+        return false;
+    }
+
+    if (not last.maybeCoalesce(action)) return false;
+
+    mActionsFootprint -= last.mFootprint;
+    last.mFootprint = last.totalFootprint();
+    mActionsFootprint += last.mFootprint;
+    last.mTime = time;
+
+    mActions.pop_back();
+    --mActionIdx;
+
+    return true;
+}
+
+std::chrono::steady_clock::time_point Root::now() const {
+    return mClock ? mClock() : std::chrono::steady_clock::now();
+}
+
+void Root::trimHistory() {
+    if (not canUndo()) return;
+
+    size numDrop{0};
+    while (
+            numDrop < mActionIdx and (
+                mActions.size() - numDrop > mMaxActions or
+                mActionsFootprint > mMaxFootprint
+            )
+          ) {
+        mActionsFootprint -= mActions[numDrop]->mFootprint;
+        ++numDrop;
+    }
+
+    if (numDrop == 0) return;
+
+    mActions.erase(
+        mActions.begin(),
+        std::next(mActions.begin(), static_cast<ssize>(numDrop))
+    );
+    mActionIdx -= numDrop;
+
+    // What's left of a joined group stands on its own.
+    mActions.front()->mJoined = false;
+}
+
+uint64 Root::hashesComputed() const {
+    std::lock_guard scopeLock(*this);
+    return mHashesComputed;
+}
+
 bool Root::canUndo() const {
     return mActionIdx != eAct_Idx_First;
 }
@@ -269,6 +395,14 @@ bool Root::ROContext::canRedo() const {
     return model().canRedo();
 }
 
+size Root::ROContext::undoDepth() const {
+    return model().mActions.size();
+}
+
+size Root::ROContext::undoFootprint() const {
+    return model().mActionsFootprint;
+}
+
 Root::Context::Context(Root& root) : 
     Model::Context(root), ROContext(root), Model::ROContext(root) {}
 
@@ -280,25 +414,28 @@ void Root::Context::undo() const {
 
     auto couldRedo{canRedo()};
 
-    auto& action{model().mActions[model().mActionIdx]};
-    model().beginReplay(true, *action);
-    // This will cause a cascade due to the replay state.
-    action->retract();
-    model().endReplay();
+    Action *action{nullptr};
+    do {
+        action = model().mActions[model().mActionIdx].get();
+        model().beginReplay(true, *action);
+        // This will cause a cascade due to the replay state.
+        action->doRetract();
+        model().endReplay();
 
-    action->source<Model>().focus();
+        --model().mActionIdx;
+    } while (action->mJoined and canUndo());
 
-    --model().mActionIdx;
+    action->source<Model>().focus();
 
-    model().sendToObservers<&RecvTable::onAction_>();
+    model().deferToObservers<&RecvTable::onAction_>();
 
     // If we couldn't before, now we can.
     if (not couldRedo)
-        model().sendToObservers<&RecvTable::onCanRedo_>();
+        model().deferToObservers<&RecvTable::onCanRedo_>();
 
     // We could on entry to this function
     if (not canUndo())
-        model().sendToObservers<&RecvTable::onCanUndo_>();
+        model().deferToObservers<&RecvTable::onCanUndo_>();
 }
 
 void Root::Context::redo() const {
@@ -309,24 +446,90 @@ void Root::Context::redo() const {
 
     auto couldUndo{canUndo()};
 
-    ++model().mActionIdx;
-
-    auto& action{model().mActions[model().mActionIdx]};
-    model().beginReplay(false, *action);
-    // This will cause a cascade due to the replay state.
-    action->perform();
-    model().endReplay();
+    Action *action{nullptr};
+    do {
+        ++model().mActionIdx;
+
+        action = model().mActions[model().mActionIdx].get();
+        model().beginReplay(false, *action);
+        // This will cause a cascade due to the replay state.
+        action->doPerform();
+        model().endReplay();
+    } while (
+            canRedo() and
+            model().mActions[model().mActionIdx + 1]->mJoined
+        );
 
     action->source<Model>().focus();
 
-    model().sendToObservers<&RecvTable::onAction_>();
+    model().deferToObservers<&RecvTable::onAction_>();
 
     // If we couldn't before, now we can.
     if (not couldUndo)
-        model().sendToObservers<&RecvTable::onCanUndo_>();
+        model().deferToObservers<&RecvTable::onCanUndo_>();
 
     // We could on entry to this function
     if (not canRedo())
-        model().sendToObservers<&RecvTable::onCanRedo_>();
+        model().deferToObservers<&RecvTable::onCanRedo_>();
+}
+
+void Root::Context::setUndoBudget(size maxActions, size maxFootprint) const {
+    model().mMaxActions = maxActions;
+    model().mMaxFootprint = maxFootprint;
+
+    // Otherwise it'll be trimmed when the current action finishes.
+    if (model().mStates.back() != State::Normal) return;
+
+    const auto oldDepth{undoDepth()};
+    model().trimHistory();
+    if (undoDepth() == oldDepth) return;
+
+    model().sendToObservers<&RecvTable::onHistory_>(
+        undoDepth(), undoFootprint()
+    );
+}
+
+void Root::Context::setClock(Clock clock) const {
+    model().mClock = clock;
+}
+
+struct Root::TransactionAction : Action {
+    bool setup() override { return true; }
+
+    // The edits are all recorded as children, just replay those.
+    void perform() override { source<Root>().replayChildren(false); }
+    void retract() override { source<Root>().replayChildren(true); }
+};
+
+Root::Transaction::Transaction(Root& root) : mRoot{root} {
+    mRoot.mMutex.lock();
+    mRoot.beginDefer();
+
+    // When suppressed, nothing is recorded anyways, and during replay the
+    // edits are already recorded.
+    if (not mRoot.capturePerformance() or not mRoot.isActuallyCapturing())
+        return;
+
+    auto action{std::make_unique<TransactionAction>()};
+    action->mSource = &mRoot;
+    mRoot.recordAction(std::move(action));
+
+    mCapturing = true;
+}
+
+Root::Transaction::~Transaction() {
+    if (mCapturing) {
+        const auto& frame{mRoot.mActionFrames.back()};
+        if (frame.action_->mChildren.empty() and mRoot.mPerformanceNesting == 1) {
+            // Nothing was done, don't leave an empty step.
+            mRoot.mActionFrames.pop_back();
+            mRoot.abortCapture();
+        } else {
+            mRoot.finishCapture();
+        }
+    }
+
+    mRoot.endDefer();
+    mRoot.mMutex.unlock();
 }
 
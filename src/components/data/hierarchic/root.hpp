@@ -19,8 +19,10 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <chrono>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <vector>
 
 #include "data/hierarchic/action.hpp"
@@ -38,6 +40,7 @@ struct DATA_EXPORT Root : Model {
     struct DATA_EXPORT ROContext;
     struct DATA_EXPORT Context;
     struct DATA_EXPORT RecvTable;
+    struct DATA_EXPORT Transaction;
 
     ~Root() override;
 
@@ -51,6 +54,34 @@ struct DATA_EXPORT Root : Model {
         eAct_Idx_First = ~0ULL,
     };
 
+    /**
+     * Default undo budget. Once either is exceeded, the oldest actions are
+     * dropped from the history.
+     */
+    enum : uint64 {
+        eUndo_Max_Actions = 1000,
+        eUndo_Max_Footprint = 64ULL * 1024 * 1024,
+    };
+
+    /**
+     * Actions on the same model this close together may be merged, or undone
+     * and redone together.
+     */
+    enum : uint64 {
+        eCoalesce_Window_Ms = 1000,
+    };
+
+    /**
+     * Source of the time actions are recorded at, for coalescing.
+     */
+    using Clock = std::chrono::steady_clock::time_point (*)();
+
+    /**
+     * @return How many times a model in this root has been hashed, rather
+     *         than had its kept hash reused.
+     */
+    [[nodiscard]] uint64 hashesComputed() const;
+
 protected:
     Root();
     Root(const Root&);
@@ -76,6 +107,8 @@ protected:
 
 private:
     friend Model;
+
+    struct TransactionAction;
     
     /**
      * Whenever an action is originally performed, other cascading actions may
@@ -119,6 +152,26 @@ private:
      */
     void endReplay();
 
+    /**
+     * Replay the remaining non-responder children of the action in the
+     * current frame, each in its own frame.
+     */
+    void replayChildren(bool undo);
+
+    /**
+     * Hold deferrable observer notifications until the matching endDefer(),
+     * then send each once.
+     */
+    void beginDefer();
+    void endDefer();
+
+    void defer(const Model&, std::unique_ptr<RecvTableBinding>&&);
+
+    /**
+     * Forget anything deferred for the model, which is going away.
+     */
+    void dropDeferred(const Model&);
+
     /**
      * Record action in current list.
      */
@@ -132,6 +185,26 @@ private:
     [[nodiscard]] bool canUndo() const;
     [[nodiscard]] bool canRedo() const;
 
+    /**
+     * Try to merge the just-finished action into the one before it, or
+     * otherwise join it to that one for undo/redo.
+     *
+     * @return if the action was merged and removed.
+     */
+    [[nodiscard]] bool maybeCoalesce();
+
+    /**
+     * @return Now, by mClock if set, otherwise the steady clock.
+     */
+    [[nodiscard]] std::chrono::steady_clock::time_point now() const;
+
+    /**
+     * Drop the oldest actions until the history is back within budget.
+     *
+     * The current action is always kept, as are any which can be redone.
+     */
+    void trimHistory();
+
     /**
      * The index corresponds to the "current" action. The one that represents
      * the state as it is currently. To undo, that action must be undone. To
@@ -144,6 +217,13 @@ private:
     size mActionIdx{eAct_Idx_First};
     std::vector<std::unique_ptr<Action>> mActions;
 
+    // Estimated bytes held by mActions
+    size mActionsFootprint{0};
+    size mMaxActions{eUndo_Max_Actions};
+    size mMaxFootprint{eUndo_Max_Footprint};
+
+    Clock mClock{nullptr};
+
     enum class State {
         Normal,
         Suppressed,
@@ -177,6 +257,14 @@ private:
 
     uint32 mPerformanceNesting{0};
 
+    uint64 mHashesComputed{0};
+
+    uint32 mDeferDepth{0};
+    std::vector<std::pair<const Model *, std::unique_ptr<RecvTableBinding>>>
+        mDeferred;
+    // Model and binding id of each in mDeferred, to only send once.
+    std::set<std::pair<const Model *, uint64>> mDeferredKeys;
+
     std::recursive_mutex mMutex;
 };
 
@@ -190,6 +278,16 @@ struct DATA_EXPORT Root::ROContext : virtual Model::ROContext {
 
     [[nodiscard]] bool canUndo() const;
     [[nodiscard]] bool canRedo() const;
+
+    /**
+     * @return Number of actions held for undo/redo.
+     */
+    [[nodiscard]] size undoDepth() const;
+
+    /**
+     * @return Estimated bytes held by actions for undo/redo.
+     */
+    [[nodiscard]] size undoFootprint() const;
 };
 
 struct DATA_EXPORT Root::Context : Model::Context, ROContext {
@@ -200,6 +298,52 @@ struct DATA_EXPORT Root::Context : Model::Context, ROContext {
 
     void undo() const;
     void redo() const;
+
+    /**
+     * Limit the undo history, dropping the oldest actions immediately if
+     * it's already over.
+     *
+     * @param maxActions Most actions to hold
+     * @param maxFootprint Most estimated bytes for actions to hold
+     */
+    void setUndoBudget(size maxActions, size maxFootprint) const;
+
+    /**
+     * Replace the clock actions are timed by, e.g. to test coalescing without
+     * waiting on the real one.
+     *
+     * @param clock nullptr for the steady clock
+     */
+    void setClock(Clock clock) const;
+};
+
+/**
+ * Scope for a batch of edits, e.g. filling in styles for every preset.
+ *
+ * Everything done in the scope is recorded as a single action, undone and
+ * redone together. Notifications sent with deferToObservers() are held
+ * until the scope ends and then each is sent once per model. The rest, i.e.
+ * those observers need before a change and those with args (e.g. Vector
+ * inserts), are still sent as they happen. Observers of a Vector which only
+ * need to catch up once can wait for its onResized_ instead.
+ *
+ * The root is locked for the lifetime of the transaction. Transactions may
+ * nest, and may be opened in responders.
+ */
+struct DATA_EXPORT Root::Transaction {
+    Transaction(Root&);
+    ~Transaction();
+
+    Transaction(const Transaction&) = delete;
+    Transaction(Transaction&&) = delete;
+    Transaction& operator=(const Transaction&) = delete;
+    Transaction& operator=(Transaction&&) = delete;
+
+private:
+    Root& mRoot;
+
+    // Recording the transaction as an action.
+    bool mCapturing{false};
 };
 
 struct DATA_EXPORT Root::RecvTable : Model::RecvTable {
@@ -224,6 +368,13 @@ struct DATA_EXPORT Root::RecvTable : Model::RecvTable {
      * Root now has/no longer has actions to redo.
      */
     Mapping<> onCanRedo_;
+
+    /**
+     * Actions held for undo/redo changed.
+     *
+     * size depth, size footprint
+     */
+    Mapping<size, size> onHistory_;
 };
 
 } // namespace data::hier
@@ -19,6 +19,8 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <set>
+
 #include "data/base/model.hpp"
 #include "data/base/models/bool.hpp"
 #include "data/base/models/choice.hpp"
@@ -20,6 +20,7 @@
  */
 
 #include <cassert>
+#include <vector>
 
 #include "data/base/model.hpp"
 #include "data/hierarchic/model.hpp"
@@ -90,9 +91,9 @@ void Receiver::activate() {
     // Attach can also happen here, sequentially, since nothing else will be
     // allowed to occur until unlock.
     const auto processMap{[this, &models](const RecvMap& map) {
-        for (auto [model, table] : map) {
+        for (const auto& [model, entry] : map) {
             model->lock();
-            model->mReceivers.insert(this);
+            model->addReceiver(this);
 
             models.push_back(model);
         }
@@ -138,9 +139,9 @@ void Receiver::deactivate() {
     models.reserve(mObserveMap.size() + mRespondMap.size());
 
     const auto processMap{[this, &models](const RecvMap& map) {
-        for (auto [model, table] : map) {
+        for (const auto& [model, entry] : map) {
             model->lock();
-            model->mReceivers.erase(this);
+            model->removeReceiver(this);
 
             models.push_back(model);
         }
@@ -187,14 +188,14 @@ void Receiver::amendFor(
     // roles.
     assert(not mapped(model));
 
-    map[&model] = &table;
+    map[&model] = {.table_=&table, .dispatch_={}};
 
     // If things are already attached, then this needs special treatment.
     // This won't call onActivate again, if needed another hook can be added,
     // but I don't think it's needed currently.
     if (mAttached) {
         std::lock_guard scopeLock(model);
-        model.mReceivers.insert(this);
+        model.addReceiver(this);
     }
 }
 
@@ -207,7 +208,7 @@ void Receiver::repeal(const base::Model& model) {
 
     if (mAttached) {
         std::lock_guard scopeLock(model);
-        model.mReceivers.erase(this);
+        model.removeReceiver(this);
     }
 }
 
@@ -217,13 +218,13 @@ void Receiver::repealAllWithTable(const RecvTable& test) {
     // Don't modify the maps while iterating...
     std::vector<const base::Model *> toRepeal;
 
-    for (auto [model, table] : mObserveMap) {
-        if (table == &test)
+    for (const auto& [model, entry] : mObserveMap) {
+        if (entry.table_ == &test)
             toRepeal.push_back(model);
     }
 
-    for (auto [model, table] : mRespondMap) {
-        if (table == &test)
+    for (const auto& [model, entry] : mRespondMap) {
+        if (entry.table_ == &test)
             toRepeal.push_back(model);
     }
 
@@ -19,9 +19,11 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <map>
 #include <mutex>
 
+#include "data/recvtable.hpp"
+#include "utils/smallvec.hpp"
+
 #include "data_export.h"
 
 namespace data {
@@ -76,7 +78,12 @@ struct DATA_EXPORT Receiver {
     void repealAllWithTable(const RecvTable&);
 
 protected:
-    using RecvMap = std::map<const base::Model *, const RecvTable *>;
+    struct Entry {
+        const RecvTable *table_;
+        // Mappings found in the table so far.
+        Dispatches dispatch_;
+    };
+    using RecvMap = utils::SmallMap<const base::Model *, Entry, 2>;
 
     Receiver();
 
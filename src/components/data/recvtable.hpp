@@ -21,6 +21,9 @@
 
 #include <type_traits>
 
+#include "utils/smallvec.hpp"
+#include "utils/types.hpp"
+
 #include "data_export.h"
 
 namespace data {
@@ -57,15 +60,35 @@ struct DATA_EXPORT RecvTable {
 
     template <typename ...Args>
     struct Mapping {
-        using Func = void (*)(const base::Model&, Receiver&, Args...);
+        // Takes the receiver as returned by resolve_
+        using Func = void (*)(void *, const base::Model&, Args...);
+        using Resolve = void *(*)(Receiver&);
 
         constexpr Mapping() = default;
-        constexpr Mapping(Func func) : func_{func} {}
+        constexpr Mapping(Func func, Resolve resolve) :
+            func_{func}, resolve_{resolve} {}
 
         Func func_{nullptr};
+        Resolve resolve_{nullptr};
     };
 };
 
+/**
+ * A mapping found in a receiver's table for a model, kept so that it only has
+ * to be looked up once.
+ */
+struct Dispatch {
+    // RecvTableBinding::id_
+    uint64 id_{0};
+    // Mapping::func_, type-erased. nullptr if the table has none.
+    void (*func_)(){nullptr};
+    // Mapping::resolve_ for the receiver.
+    void *rcvr_{nullptr};
+};
+
+// Usually only one or two bindings are ever sent to a receiver for a model.
+using Dispatches = utils::SmallVec<Dispatch, 2>;
+
 namespace priv {
 
 // Avoid ambiguous resolution via concept constrain
@@ -84,11 +107,15 @@ template <
     void (Derived::*MEM_PTR)(Args...)
 >
 struct Mapper<MEM_PTR> {
-    static void mapped(
-        const base::Model&, Receiver& rcvr, Args... args
-    ) {
-        (dynamic_cast<Derived&>(rcvr).*MEM_PTR)(args...);
+    static void mapped(void *rcvr, const base::Model&, Args... args) {
+        (static_cast<Derived *>(rcvr)->*MEM_PTR)(args...);
     }
+
+    static void *resolve(Receiver& rcvr) {
+        return &dynamic_cast<Derived&>(rcvr);
+    }
+
+    static constexpr RecvTable::Mapping<Args...> MAPPING{&mapped, &resolve};
 };
 
 template <
@@ -97,18 +124,22 @@ template <
     void (Derived::*MEM_PTR)(const base::Model&, Args...)
 >
 struct Mapper<MEM_PTR> {
-    static void mapped(
-        const base::Model& model, Receiver& rcvr, Args... args
-    ) {
-        (dynamic_cast<Derived&>(rcvr).*MEM_PTR)(model, args...);
+    static void mapped(void *rcvr, const base::Model& model, Args... args) {
+        (static_cast<Derived *>(rcvr)->*MEM_PTR)(model, args...);
     }
+
+    static void *resolve(Receiver& rcvr) {
+        return &dynamic_cast<Derived&>(rcvr);
+    }
+
+    static constexpr RecvTable::Mapping<Args...> MAPPING{&mapped, &resolve};
 };
 
 } // namespace priv
 
 template <auto MP>
 consteval auto map() {
-    return priv::Mapper<MP>::mapped;
+    return priv::Mapper<MP>::MAPPING;
 }
 
 } // namespace data
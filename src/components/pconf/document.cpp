@@ -0,0 +1,278 @@
+#include "document.hpp"
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2026 Ryan Ogurek
+ *
+ * components/pconf/document.cpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "log/logger.hpp"
+#include "pconf/parse.hpp"
+
+namespace {
+
+std::optional<std::string> toString(std::optional<std::string_view> view) {
+    if (not view) return std::nullopt;
+    return std::string{*view};
+}
+
+} // namespace
+
+/**
+ * Bump allocator for joined values.
+ *
+ * Nothing allocated here is individually freed.
+ */
+class pconf::Document::Arena {
+public:
+    void *allocate(size bytes, size align) {
+        auto space{static_cast<size>(mEnd - mPos)};
+        void *ptr{mPos};
+        if (not mPos or not std::align(align, bytes, ptr, space)) {
+            const auto blockSize{std::max(BLOCK_SIZE, bytes + align)};
+            mBlocks.emplace_back(new std::byte[blockSize]);
+            mAllocated += blockSize;
+
+            mPos = mBlocks.back().get();
+            mEnd = mPos + blockSize;
+
+            space = blockSize;
+            ptr = mPos;
+            std::align(align, bytes, ptr, space);
+        }
+
+        mPos = static_cast<std::byte *>(ptr) + bytes;
+        return ptr;
+    }
+
+    std::string_view copy(std::string_view str) {
+        if (str.empty()) return {};
+
+        auto *dst{static_cast<char *>(allocate(str.size(), 1))};
+        std::memcpy(dst, str.data(), str.size());
+        return {dst, str.size()};
+    }
+
+    [[nodiscard]] size footprint() const { return mAllocated; }
+
+private:
+    static constexpr size BLOCK_SIZE{16 * 1024};
+
+    std::vector<std::unique_ptr<std::byte[]>> mBlocks;
+    std::byte *mPos{nullptr};
+    std::byte *mEnd{nullptr};
+    size mAllocated{0};
+};
+
+/**
+ * Lays out parse events into the Document's node array.
+ *
+ * The children of a section are collected separately until it ends, then
+ * moved into the array together, so every section's children are contiguous.
+ */
+class pconf::Document::Builder : public Handler {
+public:
+    Builder(Document& doc, std::unique_ptr<char[]> buffer, size length) :
+        mDoc{doc} {
+        mDoc.mBuffer = std::move(buffer);
+        mDoc.mBufferSize = length;
+    }
+
+    [[nodiscard]] std::string_view source() const {
+        return {mDoc.mBuffer.get(), mDoc.mBufferSize};
+    }
+
+    bool onSectionBegin(const Event&) override;
+    bool onEntry(const Event&) override;
+    bool onSectionEnd() override;
+
+    /**
+     * Place the top-level entries and resolve all the child ranges.
+     */
+    void finish();
+
+private:
+    Node node(const Event&);
+    void place(Node& parent, const std::vector<Node>& children);
+    std::string_view keep(std::string_view);
+
+    Document& mDoc;
+
+    // Pending children for each open section, starting with the root. These
+    // aren't popped so that their storage is reused.
+    std::vector<std::vector<Node>> mLevels{1};
+    size mDepth{0};
+};
+
+pconf::Document::Document() :
+    mArena{std::make_unique<Arena>()} {
+    mRoot.mType = Type::SECTION;
+}
+
+pconf::Document::Document(Document&&) noexcept = default;
+pconf::Document& pconf::Document::operator=(Document&&) noexcept = default;
+pconf::Document::~Document() = default;
+
+const pconf::Document::Node *pconf::Document::Node::find(
+    std::string_view name
+) const {
+    for (const auto& node : entries()) {
+        if (node.name_ == name) return &node;
+    }
+
+    return nullptr;
+}
+
+std::vector<const pconf::Document::Node *> pconf::Document::Node::findAll(
+    std::string_view name
+) const {
+    std::vector<const Node *> ret;
+    for (const auto& node : entries()) {
+        if (node.name_ == name) ret.push_back(&node);
+    }
+
+    return ret;
+}
+
+pconf::Data pconf::Document::data() const {
+    const auto convert{[](auto self, Children children) -> Data {
+        Data ret;
+        for (const auto& node : children) {
+            if (node.isSection()) {
+                ret.emplace_back(Section::create(
+                    std::string{node.name_},
+                    toString(node.label_),
+                    node.labelNum_,
+                    self(self, node.entries())
+                ));
+            } else {
+                ret.push_back(Entry::create(
+                    std::string{node.name_},
+                    toString(node.value_),
+                    toString(node.label_),
+                    node.labelNum_
+                ));
+            }
+        }
+
+        return ret;
+    }};
+
+    return convert(convert, entries());
+}
+
+size pconf::Document::footprint() const {
+    return
+        mBufferSize +
+        (mNodes.capacity() * sizeof(Node)) +
+        (mArena ? mArena->footprint() : 0);
+}
+
+bool pconf::read(
+    const fs::path& path, Document& out, logging::Branch *lBranch
+) {
+    auto& logger{logging::Branch::optCreateLogger("pconf::read()", lBranch)};
+
+    std::unique_ptr<char[]> buffer;
+    size length{};
+    if (not readFile(path, buffer, length, logger.bverbose("Reading..."))) {
+        return false;
+    }
+
+    return read(std::move(buffer), length, out, logger.bverbose("Parsing..."));
+}
+
+bool pconf::read(
+    std::unique_ptr<char[]> buffer,
+    size length,
+    Document& out,
+    logging::Branch *lBranch
+) {
+    out = Document{};
+    Document::Builder builder{out, std::move(buffer), length};
+    if (not parse(builder.source(), builder, lBranch)) {
+        out = Document{};
+        return false;
+    }
+
+    builder.finish();
+    return true;
+}
+
+bool pconf::Document::Builder::onSectionBegin(const Event& event) {
+    auto& section{mLevels[mDepth].emplace_back(node(event))};
+    section.mType = Type::SECTION;
+
+    if (++mDepth == mLevels.size()) mLevels.emplace_back();
+    return true;
+}
+
+bool pconf::Document::Builder::onEntry(const Event& event) {
+    mLevels[mDepth].push_back(node(event));
+    return true;
+}
+
+bool pconf::Document::Builder::onSectionEnd() {
+    auto& children{mLevels[mDepth]};
+    --mDepth;
+
+    place(mLevels[mDepth].back(), children);
+    children.clear();
+    return true;
+}
+
+void pconf::Document::Builder::finish() {
+    place(mDoc.mRoot, mLevels[0]);
+
+    // Nothing more will be added, so the storage is now stable.
+    auto *nodes{mDoc.mNodes.data()};
+    for (auto& node : mDoc.mNodes) {
+        node.mChildren = nodes + node.mFirstChild;
+    }
+    mDoc.mRoot.mChildren = nodes + mDoc.mRoot.mFirstChild;
+}
+
+pconf::Document::Node pconf::Document::Builder::node(const Event& event) {
+    Node ret;
+    ret.name_ = event.name_;
+    ret.label_ = event.label_;
+    ret.labelNum_ = event.labelNum_;
+    if (event.value_) ret.value_ = keep(*event.value_);
+    return ret;
+}
+
+void pconf::Document::Builder::place(
+    Node& parent, const std::vector<Node>& children
+) {
+    parent.mFirstChild = static_cast<uint32>(mDoc.mNodes.size());
+    parent.mNumChildren = static_cast<uint32>(children.size());
+    mDoc.mNodes.insert(mDoc.mNodes.end(), children.begin(), children.end());
+}
+
+std::string_view pconf::Document::Builder::keep(std::string_view str) {
+    // Joined values only live as long as the event, everything else already
+    // points into the buffer.
+    const auto *begin{mDoc.mBuffer.get()};
+    if (str.data() >= begin and str.data() + str.size() <= begin + mDoc.mBufferSize) {
+        return str;
+    }
+
+    return mDoc.mArena->copy(str);
+}
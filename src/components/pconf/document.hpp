@@ -0,0 +1,152 @@
+#pragma once
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2026 Ryan Ogurek
+ *
+ * components/pconf/document.hpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "log/branch.hpp"
+#include "pconf/types.hpp"
+#include "utils/files.hpp"
+#include "utils/types.hpp"
+
+#include "pconf_export.h"
+
+namespace pconf {
+
+/**
+ * Read-only pconf DOM.
+ *
+ * The file is read into a single buffer, and all names, labels, and values
+ * are views into it. Values which must be joined (multiline or multiple quoted
+ * strings) are copied once into the document's arena.
+ *
+ * Nodes are stored in a single contiguous array, with the children of every
+ * section laid out next to each other, so traversal is a linear walk.
+ *
+ * Everything is released at once when the Document is destroyed, so no view
+ * obtained from a Document may outlive it.
+ */
+class PCONF_EXPORT Document {
+public:
+    class Builder;
+    struct Node;
+
+    /**
+     * Contiguous range over the direct children of a node.
+     */
+    using Children = std::span<const Node>;
+
+    struct PCONF_EXPORT Node {
+        std::string_view name_;
+        std::optional<std::string_view> value_;
+        std::optional<std::string_view> label_;
+        std::optional<uint32> labelNum_;
+
+        [[nodiscard]] Type type() const { return mType; }
+        [[nodiscard]] bool isSection() const { return mType == Type::SECTION; }
+
+        /**
+         * @return Children of the section, empty if this is not a section.
+         */
+        [[nodiscard]] std::span<const Node> entries() const {
+            return {mChildren, mNumChildren};
+        }
+
+        /**
+         * Linear search of the direct children for the first with `name`.
+         */
+        [[nodiscard]] const Node *find(std::string_view name) const;
+        [[nodiscard]] std::vector<const Node *> findAll(
+            std::string_view name
+        ) const;
+
+    private:
+        friend Document;
+        friend Builder;
+
+        Type mType{Type::ENTRY};
+        uint32 mFirstChild{0};
+        uint32 mNumChildren{0};
+        const Node *mChildren{nullptr};
+    };
+
+    Document();
+    Document(const Document&) = delete;
+    Document(Document&&) noexcept;
+    Document& operator=(const Document&) = delete;
+    Document& operator=(Document&&) noexcept;
+    ~Document();
+
+    /**
+     * Top-level entries of the document.
+     */
+    [[nodiscard]] Children entries() const { return mRoot.entries(); }
+    [[nodiscard]] const Node *find(std::string_view name) const {
+        return mRoot.find(name);
+    }
+    [[nodiscard]] std::vector<const Node *> findAll(
+        std::string_view name
+    ) const {
+        return mRoot.findAll(name);
+    }
+
+    /**
+     * Convert to the owning representation for callers that haven't been
+     * migrated to the DOM.
+     */
+    [[nodiscard]] Data data() const;
+
+    [[nodiscard]] size numNodes() const { return mNodes.size(); }
+    /**
+     * @return Bytes held by the document (buffer + nodes + arena)
+     */
+    [[nodiscard]] size footprint() const;
+
+private:
+    class Arena;
+
+    std::unique_ptr<char[]> mBuffer;
+    size mBufferSize{0};
+    std::unique_ptr<Arena> mArena;
+    std::vector<Node> mNodes;
+    Node mRoot;
+};
+
+/**
+ * Read the file at path into a Document.
+ */
+PCONF_EXPORT bool read(const fs::path&, Document& out, logging::Branch *);
+
+/**
+ * Parse an in-memory buffer, which is taken over by the Document.
+ */
+PCONF_EXPORT bool read(
+    std::unique_ptr<char[]> buffer,
+    size length,
+    Document& out,
+    logging::Branch *
+);
+
+} // namespace pconf
+
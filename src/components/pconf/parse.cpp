@@ -0,0 +1,572 @@
+#include "parse.hpp"
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2026 Ryan Ogurek
+ *
+ * components/pconf/parse.cpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <string>
+#include <variant>
+
+#include "log/logger.hpp"
+
+namespace {
+
+bool isSpace(char chr) {
+    return std::isspace(static_cast<unsigned char>(chr));
+}
+
+std::string_view trimSurroundingWhitespace(std::string_view str) {
+    while (not str.empty() and isSpace(str.front())) str.remove_prefix(1);
+    while (not str.empty() and isSpace(str.back())) str.remove_suffix(1);
+    return str;
+}
+
+std::optional<std::string> toString(std::optional<std::string_view> view) {
+    if (not view) return std::nullopt;
+    return std::string{*view};
+}
+
+/**
+ * Line-based state machine which drives a pconf::Handler.
+ *
+ * An entry is only complete (and sent) once its line ends, or for multiline
+ * values, once the closing brace is hit.
+ */
+class Parser {
+public:
+    Parser(pconf::Handler& handler, logging::Logger& logger) :
+        mHandler{handler}, mLogger{logger} {}
+
+    bool run(std::string_view);
+
+private:
+    bool parseLine(std::string_view line, size lineNo);
+
+    void appendValue(std::string_view);
+    bool sendPending();
+
+    pconf::Handler& mHandler;
+    logging::Logger& mLogger;
+
+    size mDepth{0};
+
+    enum class LineType {
+        Entry,
+        Multiline,
+    } mType{LineType::Entry};
+
+    pconf::Event mPending;
+    bool mHasPending{false};
+    bool mPendingSection{false};
+
+    // When a value spans multiple strings, it can't be a view into the
+    // buffer, so it's accumulated here instead.
+    std::string mJoined;
+    bool mJoining{false};
+};
+
+} // namespace
+
+pconf::DataBuilder::DataBuilder(Data& out) {
+    mStack.push(&out);
+}
+
+bool pconf::DataBuilder::onSectionBegin(const Event& event) {
+    auto section{Section::create(
+        std::string{event.name_},
+        toString(event.label_),
+        event.labelNum_
+    )};
+
+    auto *entries{&section->entries_};
+    mStack.top()->emplace_back(std::move(section));
+    mStack.push(entries);
+    return true;
+}
+
+bool pconf::DataBuilder::onEntry(const Event& event) {
+    mStack.top()->push_back(Entry::create(
+        std::string{event.name_},
+        toString(event.value_),
+        toString(event.label_),
+        event.labelNum_
+    ));
+    return true;
+}
+
+bool pconf::DataBuilder::onSectionEnd() {
+    mStack.pop();
+    return true;
+}
+
+bool pconf::parse(
+    std::string_view buffer, Handler& handler, logging::Branch *lBranch
+) {
+    auto& logger{logging::Branch::optCreateLogger("pconf::parse()", lBranch)};
+    return Parser{handler, logger}.run(buffer);
+}
+
+bool pconf::walk(const Data& data, Handler& handler) {
+    for (const auto& entry : data) {
+        const Event event{
+            .name_=entry->name_,
+            .value_=entry->value_,
+            .label_=entry->label_,
+            .labelNum_=entry->labelNum_,
+        };
+
+        if (auto section{entry.section()}) {
+            if (not handler.onSectionBegin(event)) return false;
+            if (not walk(section->entries_, handler)) return false;
+            if (not handler.onSectionEnd()) return false;
+        } else if (not handler.onEntry(event)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool pconf::readFile(
+    const fs::path& path,
+    std::unique_ptr<char[]>& buffer,
+    size& length,
+    logging::Branch *lBranch
+) {
+    auto& logger{logging::Branch::optCreateLogger("pconf::readFile()", lBranch)};
+
+    auto file{files::openInput(path)};
+    if (not file.is_open()) {
+        logger.error("Failed to open " + path.string());
+        return false;
+    }
+
+    file.seekg(0, std::ios::end);
+    length = static_cast<size>(file.tellg());
+    file.seekg(0, std::ios::beg);
+
+    buffer.reset(new char[length]);
+    file.read(buffer.get(), static_cast<std::streamsize>(length));
+    if (static_cast<size>(file.gcount()) != length) {
+        logger.error("Failed to read " + path.string());
+        return false;
+    }
+
+    return true;
+}
+
+namespace {
+
+bool Parser::run(std::string_view remaining) {
+    for (size lineNo{0}; not remaining.empty(); ++lineNo) {
+        const auto *newline{static_cast<const char *>(
+            std::memchr(remaining.data(), '\n', remaining.size())
+        )};
+
+        std::string_view line;
+        if (newline) {
+            line = remaining.substr(0, newline - remaining.data());
+            remaining.remove_prefix(line.size() + 1);
+        } else {
+            line = remaining;
+            remaining = {};
+        }
+
+        if (not parseLine(line, lineNo)) return false;
+    }
+
+    // Unterminated multiline just ends at EOF.
+    if (not sendPending()) return false;
+
+    for (; mDepth; --mDepth) {
+        if (not mHandler.onSectionEnd()) return false;
+    }
+
+    return true;
+}
+
+bool Parser::parseLine(std::string_view line, size lineNo) {
+    // Handle comments
+    {
+        bool inQuote{false};
+        bool lastWasSlash{false};
+        for (size idx{0}; idx < line.size(); ++idx) {
+            auto chr{line[idx]};
+
+            if (not inQuote and chr == '/') {
+                if (lastWasSlash) {
+                    // Trim everything on line after "//"
+                    line = line.substr(0, idx - 1);
+                    break;
+                }
+
+                lastWasSlash = true;
+                continue;
+            }
+
+            lastWasSlash = false;
+
+            if (chr == '"')
+                inQuote = not inQuote;
+        }
+    }
+
+    line = trimSurroundingWhitespace(line);
+    if (line.empty())
+        return true;
+
+    const auto expectMsg{[lineNo](
+        std::string_view expect,
+        std::variant<std::monostate, std::string_view, char> got = {}
+    ) {
+        std::string ret;
+        ret += "Expected ";
+        ret += expect;
+
+        if (not std::holds_alternative<std::monostate>(got)) {
+            ret += " but got ";
+
+            if (auto *ptr{std::get_if<std::string_view>(&got)}) {
+                ret += *ptr;
+            } else {
+                ret += '\'';
+                ret += std::get<char>(got);
+                ret += '\'';
+            }
+        }
+
+        ret += " on line ";
+        ret += std::to_string(lineNo);
+        return ret;
+    }};
+
+    const auto earlyMsg{[lineNo](
+        std::string_view when
+    ) {
+        std::string ret;
+        ret += "Unexpected line end when ";
+        ret += when;
+        ret += " on line ";
+        ret += std::to_string(lineNo);
+        return ret;
+    }};
+
+    if (line.front() == '}') {
+        switch (mType) {
+            case LineType::Entry:
+                // End of section
+                if (mDepth == 0) {
+                    mLogger.error(expectMsg("entry", "section-end"));
+                    return false;
+                }
+
+                --mDepth;
+                return mHandler.onSectionEnd();
+            case LineType::Multiline:
+                mType = LineType::Entry;
+                return sendPending();
+        }
+    }
+
+    if (mType == LineType::Multiline) {
+        if (line.front() != '"') {
+            mLogger.error(expectMsg("multiline start quote", line.front()));
+            return false;
+        }
+
+        if (line.size() < 2) {
+            mLogger.error(earlyMsg("parsing multiline"));
+            return false;
+        }
+
+        if (line.back() != '"') {
+            mLogger.error(expectMsg("multiline end quote", line.back()));
+            return false;
+        }
+
+        appendValue(line.substr(1, line.size() - 2));
+        return true;
+    }
+
+    enum class Reading {
+        Name,
+        Label_Start,
+        Label,
+        Label_End,
+        NLabel,
+        Post_Label,
+        Value,
+        Value_Unquoted,
+        Value_In,
+        Value_Out,
+    } reading{Reading::Name};
+
+    size mark{0};
+    const auto mkEnt{[&](size end) {
+        mPending = {};
+        mPending.name_ = trimSurroundingWhitespace(line.substr(mark, end - mark));
+        mHasPending = true;
+    }};
+
+    for (size idx{0}; idx < line.size(); ++idx) {
+        const auto chr{line[idx]};
+        const auto atEnd{idx + 1 == line.size()};
+
+        switch (reading) {
+            case Reading::Name:
+                if (chr == '{') {
+                    mkEnt(idx);
+
+                    if (atEnd) {
+                        mPendingSection = true;
+
+                        // Make sure line-end handler below doesn't
+                        // duplicate the entry creation.
+                        reading = Reading::Value;
+
+                        // Loop will exit on continue
+                        continue;
+                    }
+
+                    mark = idx + 1;
+                    reading = Reading::NLabel;
+                    continue;
+                }
+
+                if (chr == '(') {
+                    mkEnt(idx);
+                    reading = Reading::Label_Start;
+                    continue;
+                }
+
+                if (chr == ':') {
+                    mkEnt(idx);
+
+                    // See comment in Post_Label case
+                    mPending.value_.emplace();
+                    mark = idx + 1;
+                    reading = Reading::Value;
+                    continue;
+                }
+                break;
+            case Reading::Label_Start:
+                if (isSpace(chr))
+                    continue;
+
+                if (chr != '"') {
+                    mLogger.error(expectMsg("label start quote", chr));
+                    return false;
+                }
+
+                mark = idx + 1;
+                reading = Reading::Label;
+                break;
+            case Reading::Label:
+                if (chr == '"') {
+                    reading = Reading::Label_End;
+                    mPending.label_ = line.substr(mark, idx - mark);
+                }
+
+                break;
+            case Reading::Label_End:
+                if (isSpace(chr))
+                    continue;
+
+                if (chr != ')') {
+                    mLogger.error(expectMsg("label end paren", chr));
+                    return false;
+                }
+
+                reading = Reading::Post_Label;
+                break;
+            case Reading::NLabel:
+                if (std::isdigit(static_cast<unsigned char>(chr)))
+                    continue;
+
+                if (chr == '}') {
+                    auto res{std::from_chars(
+                        line.data() + mark,
+                        line.data() + idx,
+                        mPending.labelNum_.emplace()
+                    )};
+
+                    if (res.ec != std::errc{}) {
+                        mLogger.error("Failed to parse label num (" + std::to_string(static_cast<size>(res.ec)) + ") on line " + std::to_string(lineNo));
+                        return false;
+                    }
+
+                    reading = Reading::Post_Label;
+                    continue;
+                }
+
+                mLogger.error(expectMsg("decimal digit for num label", chr));
+                return false;
+            case Reading::Post_Label:
+                if (isSpace(chr))
+                    continue;
+
+                if (chr == '{') {
+                    if (not atEnd) {
+                        mLogger.error(expectMsg("section-start to be at line end"));
+                        return false;
+                    }
+
+                    mPendingSection = true;
+                    // Loop will exit on continue
+                    continue;
+                }
+
+                if (chr != ':') {
+                    mLogger.error(expectMsg("value-separator", chr));
+                    return false;
+                }
+
+                // The presence of `:` means the value should be considered
+                // present, even if empty (and both single- and multi-line
+                // parsing relies on this).
+                mPending.value_.emplace();
+                // Setup mark for unquoted value
+                mark = idx + 1;
+                reading = Reading::Value;
+                break;
+            case Reading::Value:
+                if (chr == '{') {
+                    if (not atEnd) {
+                        mLogger.error(expectMsg("multiline-start to be at line end"));
+                        return false;
+                    }
+
+                    // The loop will exit on continue, and next reading
+                    // will be for multiline value.
+                    mType = LineType::Multiline;
+                    continue;
+                }
+
+                [[fallthrough]];
+            case Reading::Value_Out:
+                if (isSpace(chr) or chr == ',')
+                    continue;
+
+                if (chr == '"') {
+                    reading = Reading::Value_In;
+                    mark = idx + 1;
+                    continue;
+                }
+
+                if (reading != Reading::Value) {
+                    mLogger.error(expectMsg("value start quote", chr));
+                    return false;
+                }
+
+                [[fallthrough]];
+            case Reading::Value_Unquoted:
+                // The remainder of the line is the value, so there's no
+                // reason to keep walking it.
+                reading = Reading::Value_Unquoted;
+                idx = line.size() - 1;
+                break;
+            case Reading::Value_In:
+                if (chr == '"') {
+                    appendValue(line.substr(mark, idx - mark));
+                    reading = Reading::Value_Out;
+                }
+                break;
+        }
+    }
+
+    switch (reading) {
+        case Reading::Name:
+            // The line was already checked to not be empty.
+            mkEnt(line.size());
+            break;
+        case Reading::Label_Start:
+            mLogger.error(expectMsg("label start quote", "line end"));
+            return false;
+        case Reading::Label:
+            mLogger.error(expectMsg("label end quote", "line end"));
+            return false;
+        case Reading::Label_End:
+            mLogger.error(expectMsg("label end paren", "line end"));
+            return false;
+        case Reading::NLabel:
+            mLogger.error(expectMsg("num label end brace", "line end"));
+            return false;
+        case Reading::Value_In:
+            mLogger.error(expectMsg("value end quote", "line end"));
+            return false;
+        case Reading::Post_Label:
+        case Reading::Value:
+        case Reading::Value_Out:
+            // All of these are fine to end on, and ent has already been
+            // made, so nothing more to do.
+            break;
+        case Reading::Value_Unquoted:
+            mPending.value_ = line.substr(mark);
+            break;
+    }
+
+    // A multiline value continues onto following lines.
+    if (mType == LineType::Multiline) return true;
+
+    return sendPending();
+}
+
+void Parser::appendValue(std::string_view str) {
+    auto& value{*mPending.value_};
+
+    if (not mJoining) {
+        if (value.empty()) {
+            value = str;
+            return;
+        }
+
+        mJoined.assign(value);
+        mJoining = true;
+    }
+
+    mJoined += '\n';
+    mJoined += str;
+}
+
+bool Parser::sendPending() {
+    if (not mHasPending) return true;
+    mHasPending = false;
+
+    if (mJoining) {
+        mPending.value_ = mJoined;
+        mJoining = false;
+    }
+
+    bool ret{};
+    if (mPendingSection) {
+        mPendingSection = false;
+        ++mDepth;
+        ret = mHandler.onSectionBegin(mPending);
+    } else {
+        ret = mHandler.onEntry(mPending);
+    }
+
+    mJoined.clear();
+    return ret;
+}
+
+} // namespace
+
@@ -0,0 +1,99 @@
+#pragma once
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2026 Ryan Ogurek
+ *
+ * components/pconf/parse.hpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <memory>
+#include <optional>
+#include <stack>
+#include <string_view>
+
+#include "log/branch.hpp"
+#include "pconf/types.hpp"
+#include "utils/files.hpp"
+#include "utils/types.hpp"
+
+#include "pconf_export.h"
+
+namespace pconf {
+
+/**
+ * A complete entry or section header.
+ *
+ * Names and labels always point into the parsed buffer. Values point into the
+ * buffer unless they had to be joined (multiline or multiple quoted strings),
+ * in which case they're only valid for the duration of the callback.
+ */
+struct Event {
+    std::string_view name_;
+    std::optional<std::string_view> value_;
+    std::optional<std::string_view> label_;
+    std::optional<uint32> labelNum_;
+};
+
+/**
+ * Receives events in document order.
+ *
+ * Events are always balanced; sections left open at the end of the input are
+ * ended before parsing returns.
+ *
+ * Returning false from any callback stops parsing, and parse() returns false
+ * without logging anything further.
+ */
+struct PCONF_EXPORT Handler {
+    virtual ~Handler() = default;
+
+    virtual bool onSectionBegin(const Event&) { return true; }
+    virtual bool onEntry(const Event&) { return true; }
+    virtual bool onSectionEnd() { return true; }
+};
+
+/**
+ * Builds the owning pconf::Data tree from events.
+ */
+struct PCONF_EXPORT DataBuilder : Handler {
+    DataBuilder(Data& out);
+
+    bool onSectionBegin(const Event&) override;
+    bool onEntry(const Event&) override;
+    bool onSectionEnd() override;
+
+private:
+    std::stack<Data *> mStack;
+};
+
+PCONF_EXPORT bool parse(std::string_view, Handler&, logging::Branch *);
+
+/**
+ * Emit events for an already-built tree, as if it were being parsed.
+ */
+PCONF_EXPORT bool walk(const Data&, Handler&);
+
+/**
+ * Read a file into a single new buffer.
+ */
+PCONF_EXPORT bool readFile(
+    const fs::path&,
+    std::unique_ptr<char[]>& buffer,
+    size& length,
+    logging::Branch *
+);
+
+} // namespace pconf
+
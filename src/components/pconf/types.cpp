@@ -19,6 +19,9 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <mutex>
+#include <unordered_set>
+
 pconf::Entry::Entry(
     std::string name, 
     std::optional<std::string> value,
@@ -40,7 +43,9 @@ pconf::Section::Section(
         std::move(label),
         labelNum
     ),
-    entries_(std::move(entries)) {}
+    entries_(std::move(entries)) {
+    mType = Type::SECTION;
+}
 
 pconf::EntryPtr pconf::Entry::create(
     std::string name,
@@ -70,8 +75,52 @@ pconf::SectionPtr pconf::Section::create(
     ));
 }
 
+pconf::Symbol::Symbol(std::string_view str) : Symbol(Prehashed{str}) {}
+
+pconf::Symbol::Symbol(const Prehashed& key) {
+    struct Table {
+        struct Hash {
+            using is_transparent = void;
+
+            size operator()(const std::string& str) const {
+                return std::hash<std::string_view>{}(str);
+            }
+            size operator()(const Prehashed& key) const { return key.hash_; }
+        };
+
+        struct Equal {
+            using is_transparent = void;
+
+            bool operator()(const std::string& lhs, const std::string& rhs) const {
+                return lhs == rhs;
+            }
+            bool operator()(const std::string& lhs, const Prehashed& rhs) const {
+                return lhs == rhs.str_;
+            }
+            bool operator()(const Prehashed& lhs, const std::string& rhs) const {
+                return lhs.str_ == rhs;
+            }
+        };
+
+        std::mutex lock_;
+        // Node-based, so the strings never move once inserted.
+        std::unordered_set<std::string, Hash, Equal> strings_;
+    };
+    // Leaked deliberately so that Symbols in static storage stay valid
+    // through shutdown.
+    static auto *table{new Table};
+
+    std::lock_guard scopeLock{table->lock_};
+    auto iter{table->strings_.find(key)};
+    if (iter == table->strings_.end()) {
+        iter = table->strings_.emplace(key.str_).first;
+    }
+    mStr = *iter;
+    mHash = key.hash_;
+}
+
 void pconf::HashedData::erase(const EntryPtr& entry) {
-    auto vecIter{mMap.find(entry->name_)};
+    auto vecIter{mMap.find(std::string_view{entry->name_})};
     if (vecIter == mMap.end()) return;
 
     auto iter{vecIter->second.begin()};
@@ -88,7 +137,7 @@ void pconf::HashedData::erase(const EntryPtr& entry) {
     }
 }
 
-pconf::EntryPtr pconf::HashedData::find(const std::string& key) const {
+pconf::EntryPtr pconf::HashedData::find(std::string_view key) const {
     const auto vecIter{mMap.find(key)};
     if (vecIter == mMap.end()) return nullptr;
 
@@ -98,8 +147,15 @@ pconf::EntryPtr pconf::HashedData::find(const std::string& key) const {
     return vecIter->second[0];
 }
 
-std::vector<pconf::EntryPtr> pconf::HashedData::findAll(
-    const std::string& key
+pconf::EntryPtr pconf::HashedData::find(Symbol key) const {
+    const auto vecIter{mMap.find(key)};
+    if (vecIter == mMap.end()) return nullptr;
+
+    return vecIter->second[0];
+}
+
+std::span<const pconf::EntryPtr> pconf::HashedData::findAll(
+    std::string_view key
 ) const {
     const auto vecIter{mMap.find(key)};
     if (vecIter == mMap.end()) return {};
@@ -107,9 +163,26 @@ std::vector<pconf::EntryPtr> pconf::HashedData::findAll(
     return vecIter->second;
 }
 
-std::vector<pconf::EntryPtr>& pconf::HashedData::operator[](
-    const std::string& key
-) {
+std::span<const pconf::EntryPtr> pconf::HashedData::findAll(Symbol key) const {
+    const auto vecIter{mMap.find(key)};
+    if (vecIter == mMap.end()) return {};
+
+    return vecIter->second;
+}
+
+std::vector<pconf::EntryPtr>& pconf::HashedData::operator[](Symbol key) {
     return mMap[key];
 }
 
+std::vector<pconf::EntryPtr>& pconf::HashedData::operator[](
+    std::string_view key
+) {
+    // Most keys repeat, so don't take the interning lock unless it's new.
+    const Symbol::Prehashed prehashed{key};
+    auto iter{mMap.find(prehashed)};
+    if (iter == mMap.end()) {
+        iter = mMap.emplace(Symbol{prehashed}, std::vector<EntryPtr>{}).first;
+    }
+
+    return iter->second;
+}
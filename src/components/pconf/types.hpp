@@ -21,7 +21,9 @@
 
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -44,12 +46,53 @@ using SectionPtr = std::shared_ptr<Section>;
 struct PCONF_EXPORT EntryPtr : std::shared_ptr<Entry> {
     using shared_ptr::shared_ptr;
 
-    [[nodiscard]] SectionPtr section() const {
-        return std::dynamic_pointer_cast<Section>(*this);
-    }
+    /**
+     * @return If non-null and a section. Prefer this to section() when the
+     * SectionPtr itself isn't needed.
+     */
+    [[nodiscard]] inline bool isSection() const;
+    [[nodiscard]] inline SectionPtr section() const;
 };
 
 using Data = std::vector<EntryPtr>;
+
+/**
+ * Interned string, for keys.
+ *
+ * Every Symbol with the same text refers to the same storage, which is never
+ * freed, so comparison is by pointer and the hash is precomputed.
+ *
+ * Interning takes a global lock, so keys which are looked up often should be
+ * made once and reused.
+ */
+struct PCONF_EXPORT Symbol {
+    /**
+     * Text and its hash, so it's only hashed once however many times it's
+     * looked up or interned.
+     */
+    struct Prehashed {
+        explicit Prehashed(std::string_view str) :
+            str_{str}, hash_{std::hash<std::string_view>{}(str)} {}
+
+        std::string_view str_;
+        size hash_;
+    };
+
+    explicit Symbol(std::string_view);
+    explicit Symbol(const Prehashed&);
+
+    [[nodiscard]] std::string_view str() const { return mStr; }
+    [[nodiscard]] size hash() const { return mHash; }
+
+    bool operator==(const Symbol& other) const {
+        return mStr.data() == other.mStr.data();
+    }
+
+private:
+    std::string_view mStr;
+    size mHash;
+};
+
 /*
  * On Windows, the multimap stores equal-keyed items in reverse order, and
  * according to the C++ stdlib spec the order of all the items is not
@@ -60,13 +103,56 @@ using Data = std::vector<EntryPtr>;
 struct PCONF_EXPORT HashedData {
     void erase(const EntryPtr&);
 
-    [[nodiscard]] EntryPtr find(const std::string& key) const;
-    [[nodiscard]] std::vector<EntryPtr> findAll(const std::string& key) const;
+    [[nodiscard]] EntryPtr find(std::string_view key) const;
+    [[nodiscard]] EntryPtr find(Symbol key) const;
 
-    std::vector<EntryPtr>& operator[](const std::string& key);
+    /**
+     * @return View of the entries with key, valid until this is modified.
+     */
+    [[nodiscard]] std::span<const EntryPtr> findAll(std::string_view key) const;
+    [[nodiscard]] std::span<const EntryPtr> findAll(Symbol key) const;
+
+    std::vector<EntryPtr>& operator[](Symbol key);
+    /**
+     * Only interns key if it isn't already present.
+     */
+    std::vector<EntryPtr>& operator[](std::string_view key);
 
 private:
-    std::unordered_map<std::string, std::vector<EntryPtr>> mMap;
+    /**
+     * Lets string_views be looked up without interning them.
+     */
+    struct KeyHash {
+        using is_transparent = void;
+
+        size operator()(Symbol key) const { return key.hash(); }
+        size operator()(const Symbol::Prehashed& key) const {
+            return key.hash_;
+        }
+        size operator()(std::string_view key) const {
+            return std::hash<std::string_view>{}(key);
+        }
+    };
+
+    struct KeyEqual {
+        using is_transparent = void;
+
+        bool operator()(Symbol lhs, Symbol rhs) const { return lhs == rhs; }
+        bool operator()(Symbol lhs, std::string_view rhs) const {
+            return lhs.str() == rhs;
+        }
+        bool operator()(std::string_view lhs, Symbol rhs) const {
+            return lhs == rhs.str();
+        }
+        bool operator()(Symbol lhs, const Symbol::Prehashed& rhs) const {
+            return lhs.str() == rhs.str_;
+        }
+        bool operator()(const Symbol::Prehashed& lhs, Symbol rhs) const {
+            return lhs.str_ == rhs.str();
+        }
+    };
+
+    std::unordered_map<Symbol, std::vector<EntryPtr>, KeyHash, KeyEqual> mMap;
 };
 
 struct PCONF_EXPORT Entry {
@@ -83,6 +169,8 @@ struct PCONF_EXPORT Entry {
     std::optional<std::string> label_{std::nullopt};
     std::optional<uint32> labelNum_{std::nullopt};
 
+    [[nodiscard]] Type type() const { return mType; }
+
 private:
     friend Section;
     Entry(
@@ -91,6 +179,8 @@ private:
         std::optional<std::string> label,
         std::optional<uint32> labelNum
     );
+
+    Type mType{Type::ENTRY};
 };
 
 struct PCONF_EXPORT Section : Entry {
@@ -112,5 +202,15 @@ private:
    );
 };
 
+bool EntryPtr::isSection() const {
+    return *this and (*this)->type() == Type::SECTION;
+}
+
+SectionPtr EntryPtr::section() const {
+    // The type tag makes the RTTI check unnecessary.
+    if (not isSection()) return nullptr;
+    return std::static_pointer_cast<Section>(*this);
+}
+
 } // namespace pconf
 
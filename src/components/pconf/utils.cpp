@@ -34,8 +34,17 @@ std::vector<std::string> pconf::valueAsList(
     if (not optStr)
         return {};
 
+    return valueAsList(std::optional<std::string_view>{*optStr});
+}
+
+std::vector<std::string> pconf::valueAsList(
+    std::optional<std::string_view> optView
+) {
+    if (not optView)
+        return {};
+
     std::vector<std::string> ret;
-    std::string_view view{*optStr};
+    auto view{*optView};
 
     while (true) {
         const auto end{view.find('\n')};
@@ -22,6 +22,7 @@
 #include <optional>
 #include <vector>
 #include <string>
+#include <string_view>
 
 #include "pconf/types.hpp"
 
@@ -34,6 +35,9 @@ namespace pconf {
 [[nodiscard]] PCONF_EXPORT std::vector<std::string> valueAsList(
     const std::optional<std::string>&
 );
+[[nodiscard]] PCONF_EXPORT std::vector<std::string> valueAsList(
+    std::optional<std::string_view>
+);
 
 [[nodiscard]] PCONF_EXPORT std::optional<std::string> listAsValue(
     const std::vector<std::string>&
@@ -19,23 +19,23 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <array>
+#include <charconv>
+
 #include "log/logger.hpp"
 
 namespace {
 
-bool writeEntry(
-    std::ostream&,
-    const pconf::EntryPtr& entry,
-    int32 depth,
-    logging::Branch&
-);
-bool writeSection(
-    std::ostream&,
-    const pconf::SectionPtr& section,
-    int32 depth,
-    logging::Branch&
+void appendEntry(std::string&, const pconf::EntryPtr&, int32 depth);
+void appendHead(
+    std::string&,
+    std::string_view name,
+    const std::optional<std::string>& label,
+    std::optional<uint32> labelNum,
+    int32 depth
 );
-std::ostream& writeWithDepth(std::ostream& outStream, int32 depth);
+void appendValue(std::string&, std::string_view value, int32 depth);
+void appendDepth(std::string&, int32 depth);
 
 } // namespace
 
@@ -44,107 +44,208 @@ void pconf::write(
 ) {
     auto& logger{logging::Branch::optCreateLogger("pconf::write()", lBranch)};
 
+    std::string buffer;
+    write(buffer, pconfData);
+    outStream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+
+    if (not outStream.good()) logger.error("Failed to write data to stream.");
+}
+
+void pconf::write(std::string& buffer, const Data& pconfData) {
     for (const auto& entry : pconfData) {
-        if (entry.section()) {
-            writeSection(
-                outStream,
-                entry.section(),
-                0,
-                *logger.bverbose("Writing Section: " + entry->name_)
-            );
-        } else {
-            writeEntry(
-                outStream,
-                entry,
-                0,
-                *logger.bverbose("Writing entry: " + entry->name_)
-            );
-        }
+        appendEntry(buffer, entry, 0);
     }
 }
 
-namespace {
-
-bool writeEntry(
-    std::ostream& outStream,
-    const pconf::EntryPtr& entry,
-    int32 depth,
-    logging::Branch&
+bool pconf::Writer::set(
+    std::string_view name, std::optional<std::string_view> value
 ) {
-    // auto& logger{lBranch.createLogger("pconf::writeEntry()")};
-    
-    writeWithDepth(outStream, depth) << entry->name_;
-    if (entry->label_) outStream << "(\"" << entry->label_.value() << "\")";
-    if (entry->labelNum_) outStream << '{' << entry->labelNum_.value() << '}';
+    mScratch.clear();
+    appendHead(mScratch, name, std::nullopt, std::nullopt, 0);
+    if (value) {
+        appendValue(mScratch, *value, 0);
+    } else {
+        mScratch += '\n';
+    }
 
-    if (not entry->value_) {
-        outStream << '\n';
+    return splice(name);
+}
+
+bool pconf::Writer::set(const EntryPtr& entry) {
+    mScratch.clear();
+    appendEntry(mScratch, entry, 0);
+    return splice(entry->name_);
+}
+
+bool pconf::Writer::erase(std::string_view name) {
+    auto *slot{find(name)};
+    if (not slot) return false;
+
+    mImage.erase(slot->begin_, slot->length_);
+    for (auto *later{slot + 1}; later != mSlots.data() + mSlots.size(); ++later) {
+        later->begin_ -= slot->length_;
+    }
+    mSlots.erase(mSlots.begin() + (slot - mSlots.data()));
+    mDirty = true;
+
+    return true;
+}
+
+bool pconf::Writer::save(const fs::path& path, logging::Branch *lBranch) {
+    auto& logger{logging::Branch::optCreateLogger("pconf::Writer::save()", lBranch)};
+
+    std::error_code err;
+    if (not mDirty and fs::exists(path, err)) {
+        logger.verbose("Unchanged, skipping.");
         return true;
     }
 
-    const auto& valueStr{entry->value_.value()};
-    outStream << ": ";
+    auto tmpPath{path};
+    tmpPath += ".tmp";
+
+    {
+        auto file{files::openOutput(tmpPath)};
+        file.write(mImage.data(), static_cast<std::streamsize>(mImage.size()));
+        file.close();
 
-    size_t lineBegin{0};
-    size_t lineEnd{valueStr.find('\n')};
-    bool containsQuotes{valueStr.find('"') != std::string::npos};
-    if (lineEnd != std::string::npos or containsQuotes) {
-        outStream << "{\n";
-        writeWithDepth(outStream, depth + 1);
+        if (file.fail()) {
+            logger.error("Failed to write temporary file.");
+            fs::remove(tmpPath, err);
+            return false;
+        }
     }
 
-    while (lineEnd != std::string::npos) {
-        outStream << '"' << valueStr.substr(lineBegin, lineEnd - lineBegin) << "\"\n";
-        writeWithDepth(outStream, depth + 1);
-        lineBegin = lineEnd + 1;
-        lineEnd = valueStr.find('\n', lineBegin);
+    fs::rename(tmpPath, path, err);
+    if (err) {
+        logger.error("Failed to move file into place: " + err.message());
+        fs::remove(tmpPath, err);
+        return false;
+    }
+
+    mDirty = false;
+    return true;
+}
+
+pconf::Writer::Slot *pconf::Writer::find(std::string_view name) {
+    for (auto& slot : mSlots) {
+        if (slot.name_ == name) return &slot;
     }
 
-    outStream << '"' << valueStr.substr(lineBegin, lineEnd - lineBegin) << "\"\n";
-    if (lineBegin != 0 or containsQuotes) writeWithDepth(outStream, depth) << "}\n";
+    return nullptr;
+}
+
+bool pconf::Writer::splice(std::string_view name) {
+    auto *slot{find(name)};
+    if (not slot) {
+        mSlots.push_back({
+            .name_=std::string{name},
+            .begin_=mImage.size(),
+            .length_=mScratch.size(),
+        });
+        mImage += mScratch;
+        mDirty = true;
+        return true;
+    }
+
+    const std::string_view current{mImage.data() + slot->begin_, slot->length_};
+    if (current == mScratch) return false;
+
+    mImage.replace(slot->begin_, slot->length_, mScratch);
+    for (auto *later{slot + 1}; later != mSlots.data() + mSlots.size(); ++later) {
+        later->begin_ = later->begin_ - slot->length_ + mScratch.size();
+    }
+    slot->length_ = mScratch.size();
+    mDirty = true;
 
     return true;
 }
 
-bool writeSection(
-    std::ostream& outStream,
-    const pconf::SectionPtr& section,
-    int32 depth,
-    logging::Branch& lBranch
+namespace {
+
+void appendEntry(
+    std::string& out, const pconf::EntryPtr& entry, int32 depth
 ) {
-    auto& logger{lBranch.createLogger("pconf::writeSection()")};
-
-    writeWithDepth(outStream, depth) << section->name_;
-    if (section->label_) outStream << "(\"" << section->label_.value() << "\")";
-    if (section->labelNum_) outStream << '{' << section->labelNum_.value() << '}';
-    outStream << " {\n";
-
-    for (const auto& entry : section->entries_) {
-        if (entry.section()) {
-            writeSection(
-                outStream,
-                entry.section(),
-                depth + 1,
-                *logger.binfo("Writing Section: " + entry->name_)
-            );
-        } else {
-            writeEntry(
-                outStream,
-                entry,
-                depth + 1,
-                *logger.binfo("Writing entry: " + entry->name_)
-            );
+    appendHead(out, entry->name_, entry->label_, entry->labelNum_, depth);
+
+    if (entry.isSection()) {
+        out += " {\n";
+        for (const auto& child : entry.section()->entries_) {
+            appendEntry(out, child, depth + 1);
         }
+        appendDepth(out, depth);
+        out += "}\n";
+        return;
     }
 
-    writeWithDepth(outStream, depth) << "}\n";
+    if (not entry->value_) {
+        out += '\n';
+        return;
+    }
 
-    return true;
+    appendValue(out, *entry->value_, depth);
+}
+
+void appendHead(
+    std::string& out,
+    std::string_view name,
+    const std::optional<std::string>& label,
+    std::optional<uint32> labelNum,
+    int32 depth
+) {
+    appendDepth(out, depth);
+    out += name;
+
+    if (label) {
+        out += "(\"";
+        out += *label;
+        out += "\")";
+    }
+
+    if (labelNum) {
+        // Enough for any uint32
+        std::array<char, 10> numBuf;
+        auto res{std::to_chars(numBuf.begin(), numBuf.end(), *labelNum)};
+        out += '{';
+        out.append(numBuf.data(), res.ptr);
+        out += '}';
+    }
+}
+
+void appendValue(std::string& out, std::string_view value, int32 depth) {
+    out += ": ";
+
+    size lineBegin{0};
+    size lineEnd{value.find('\n')};
+    const bool multiline{
+        lineEnd != std::string_view::npos or
+        value.find('"') != std::string_view::npos
+    };
+    if (multiline) {
+        out += "{\n";
+        appendDepth(out, depth + 1);
+    }
+
+    while (lineEnd != std::string_view::npos) {
+        out += '"';
+        out += value.substr(lineBegin, lineEnd - lineBegin);
+        out += "\"\n";
+        appendDepth(out, depth + 1);
+        lineBegin = lineEnd + 1;
+        lineEnd = value.find('\n', lineBegin);
+    }
+
+    out += '"';
+    out += value.substr(lineBegin);
+    out += "\"\n";
+
+    if (multiline) {
+        appendDepth(out, depth);
+        out += "}\n";
+    }
 }
 
-std::ostream& writeWithDepth(std::ostream& outStream, int32 depth) {
-    for (auto i{0}; i < depth; i++) outStream << '\t';
-    return outStream;
+void appendDepth(std::string& out, int32 depth) {
+    out.append(static_cast<size>(depth), '\t');
 }
 
 } // namespace
@@ -19,10 +19,15 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <optional>
 #include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include "log/branch.hpp"
 #include "pconf/types.hpp"
+#include "utils/files.hpp"
 
 #include "pconf_export.h"
 
@@ -30,5 +35,66 @@ namespace pconf {
 
 PCONF_EXPORT void write(std::ostream&, const Data&, logging::Branch *); 
 
+/**
+ * Append the serialized data to buffer, which is not cleared first.
+ */
+PCONF_EXPORT void write(std::string& buffer, const Data&);
+
+/**
+ * Holds the serialized image of a set of top-level entries so that changing
+ * one only re-serializes that entry and splices it into the image.
+ *
+ * Entries are identified by name (top-level names must be unique) and are
+ * kept in the order they were first set.
+ */
+struct PCONF_EXPORT Writer {
+    /**
+     * Set a plain entry without building an Entry for it.
+     *
+     * @return If the image changed.
+     */
+    bool set(
+        std::string_view name,
+        std::optional<std::string_view> value = std::nullopt
+    );
+    /**
+     * @return If the image changed.
+     */
+    bool set(const EntryPtr&);
+
+    /**
+     * @return If there was an entry with name.
+     */
+    bool erase(std::string_view name);
+
+    [[nodiscard]] std::string_view image() const { return mImage; }
+
+    /**
+     * @return If the image changed since the last successful save.
+     */
+    [[nodiscard]] bool dirty() const { return mDirty; }
+
+    /**
+     * Write the image to path in one write to a temporary file, which is then
+     * moved into place. Does nothing if not dirty() and path exists.
+     */
+    bool save(const fs::path& path, logging::Branch *);
+
+private:
+    struct Slot {
+        std::string name_;
+        size begin_;
+        size length_;
+    };
+
+    Slot *find(std::string_view name);
+    bool splice(std::string_view name);
+
+    std::vector<Slot> mSlots;
+    std::string mImage;
+    std::string mScratch;
+    bool mDirty{false};
+};
+
 } // namespace pconf
 
@@ -0,0 +1,216 @@
+#include "sketch.hpp"
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2026 Ryan Ogurek
+ *
+ * components/sketch/sketch.cpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdlib>
+
+#include <wx/translation.h>
+
+#include "config/misc/injection.hpp"
+#include "config/priv/io.hpp"
+#include "data/context.hpp"
+#include "log/logger.hpp"
+#include "utils/files.hpp"
+#include "utils/paths.hpp"
+#include "versions/detail/boards.hpp"
+#include "versions/detail/strings.hpp"
+
+std::string sketch::configFileName(const std::string& name) {
+    // Use a prefix on the name, "ProffieConfig" so that the core config
+    // headers can't be overwritten. I could check for this elsewhere, but it's
+    // a lot easier to just prevent it this way.
+    return "ProffieConfig " + name + ".h";
+}
+
+std::optional<std::string> sketch::installDeps(
+    const config::Config& config,
+    const fs::path& sketchPath,
+    logging::Branch& lBranch
+) {
+    auto& logger{lBranch.createLogger("sketch::installDeps()")};
+    std::error_code err;
+
+    if (const auto *prop{config.prop()}; prop and not prop->filename_.empty()) {
+        logger.info("Installing prop file...");
+
+        const auto sourcePropHeader{
+            paths::propDir() / prop->installName_ /
+            versions::detail::HEADER_FILE_STR
+        };
+        if (not fs::exists(sourcePropHeader, err)) {
+            logger.error("Prop doesn't have a header.");
+            return wxTRANSLATE("Invalid Prop Selected");
+        }
+
+        const auto propHeaderDest{sketchPath / "props" / prop->filename_};
+        if (not files::copyOverwrite(sourcePropHeader, propHeaderDest, err)) {
+            logger.error("Failed to copy in prop header: " + err.message());
+            return wxTRANSLATE("OS FS Error");
+        }
+    }
+
+    const auto injectionsDest{
+        sketchPath / "config" / config::priv::INJECTION_STR
+    };
+
+    auto injections{data::context(config.injections_)};
+    if (not injections.children().empty()) {
+        logger.info("Installing injection files...");
+
+        fs::create_directories(injectionsDest, err);
+        if (err) {
+            logger.error("Failed to create injections dir: " + err.message());
+            return wxTRANSLATE("OS FS Error");
+        }
+    }
+
+    for (const auto& model : injections.children()) {
+        auto& injection{dynamic_cast<config::Injection&>(*model)};
+
+        const auto srcPath{paths::injectionDir() / injection.filename_};
+        const auto dstPath{injectionsDest / injection.filename_};
+
+        if (not files::copyOverwrite(srcPath, dstPath, err)) {
+            logger.error("Failed to copy injection file \"" + srcPath.string() + "\" to \"" + dstPath.string() + "\": " + err.message());
+            return wxTRANSLATE("OS FS Error");
+        }
+    }
+
+    return std::nullopt;
+}
+
+std::optional<std::string> sketch::updateIno(
+    const fs::path& sketchPath,
+    const std::string& configFile,
+    const config::Config& config,
+    logging::Branch& lBranch
+) {
+    auto& logger{lBranch.createLogger("sketch::updateIno()")};
+    const auto inoPath{sketchPath / "ProffieOS.ino"};
+
+    std::string content;
+    { auto ino{files::openInput(inoPath)};
+        if (ino.fail()) {
+            logger.error("Failed to open ProffieOS INO");
+            return wxTRANSLATE("OS Inaccessible or Corrupted");
+        }
+
+        // This one doesn't need to be replaced, but I've been doing it for
+        // a while now, no real reason to stop I guess.
+        constexpr std::string_view COMMENTED_LINE{
+            R"(// #define CONFIG_FILE "config/YOUR_CONFIG_FILE_NAME_HERE.h")"
+        };
+        constexpr std::string_view UNCOMMENTED_LINE{
+            R"(#define CONFIG_FILE)"
+        };
+        constexpr std::string_view VERSION_LINE{
+            R"(const char version[] = ")"
+        };
+
+        std::string line;
+        bool alreadyOutputConfigDefine{false};
+        while (std::getline(ino, line)) {
+            if (
+                    line.starts_with(COMMENTED_LINE) or
+                    line.starts_with(UNCOMMENTED_LINE)
+               ) {
+                if (not alreadyOutputConfigDefine) {
+                    content += "#define CONFIG_FILE \"config/";
+                    content += configFile;
+                    content += "\"\n";
+                    alreadyOutputConfigDefine = true;
+                }
+            } else if (line.starts_with(VERSION_LINE)) {
+                content += VERSION_LINE;
+                content += config.os()->version_.string();
+                content += "\";\n";
+            } else {
+                content += line;
+                content += '\n';
+            }
+        }
+    }
+
+    std::error_code err;
+    if (not files::writeAtomic(inoPath, content, err)) {
+        logger.error("Failed to write ProffieOS INO: " + err.message());
+        return wxTRANSLATE("Computer FS Error");
+    }
+
+    return std::nullopt;
+}
+
+std::vector<std::string> sketch::compileArgs(
+    const config::Config& config, const fs::path& sketchPath
+) {
+    const auto& board{*config.board()};
+
+    std::string options;
+    auto massStorage{data::context(config.settings_.massStorage_)};
+    auto webUSB{data::context(config.settings_.webUsb_)};
+
+    if (massStorage.val() and webUSB.val()) options = "usb=cdc_msc_webusb";
+    else if (webUSB.val()) options = "usb=cdc_webusb";
+    else if (massStorage.val()) options = "usb=cdc_msc";
+    else options = "usb=cdc";
+
+    using versions::detail::BOARDS;
+    using enum versions::detail::BoardIdx;
+    if (board.name_ == BOARDS[eBoard_Proffie_V3].name_) {
+        options += ",dosfs=sdmmc1";
+    }
+
+    return {
+        "compile",
+        "-b",
+        board.coreId_,
+        "--board-options",
+        std::move(options),
+        sketchPath.string(),
+    };
+}
+
+sketch::Usage sketch::parseUsage(std::string_view output) {
+    Usage ret;
+
+    constexpr std::string_view USED_PREFIX{"Sketch uses "};
+    constexpr std::string_view MAX_PREFIX{"Maximum is "};
+    const auto usedPrefixPos{output.find(USED_PREFIX)};
+    const auto maxPrefixPos{output.find(MAX_PREFIX)};
+    if (
+            usedPrefixPos == std::string_view::npos or
+            maxPrefixPos == std::string_view::npos
+       ) {
+        return ret;
+    }
+
+    const auto usedPos{usedPrefixPos + USED_PREFIX.length()};
+    const auto maxPos{maxPrefixPos + MAX_PREFIX.length()};
+
+    // Output is always NUL-terminated where it's come from, but a view
+    // needn't be, so don't read past it.
+    const std::string used{output.substr(usedPos, output.find(' ', usedPos) - usedPos)};
+    const std::string total{output.substr(maxPos, output.find(' ', maxPos) - maxPos)};
+
+    ret.used_ = static_cast<int32>(strtoul(used.c_str(), nullptr, 10));
+    ret.total_ = static_cast<int32>(strtoul(total.c_str(), nullptr, 10));
+    return ret;
+}
+
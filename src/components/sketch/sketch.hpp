@@ -0,0 +1,91 @@
+#pragma once
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2026 Ryan Ogurek
+ *
+ * components/sketch/sketch.hpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "config/config.hpp"
+#include "log/branch.hpp"
+#include "utils/types.hpp"
+
+#include "sketch_export.h"
+
+/**
+ * Preparing a ProffieOS sketch for a config and compiling it, without any UI.
+ *
+ * Errors are returned untranslated, for the caller to translate if it shows
+ * them, and the details are logged.
+ */
+namespace sketch {
+
+struct Usage {
+    // -1 if not found in the compiler output
+    int32 used_{-1};
+    int32 total_{-1};
+};
+
+/**
+ * @return Name for the config file in the sketch's config dir.
+ */
+SKETCH_EXPORT std::string configFileName(const std::string& name);
+
+/**
+ * Copy in everything the config needs besides itself: the prop header and
+ * injections.
+ *
+ * @return err or nullopt
+ */
+SKETCH_EXPORT std::optional<std::string> installDeps(
+    const config::Config&, const fs::path& sketchPath, logging::Branch&
+);
+
+/**
+ * Point the sketch's INO at the config file and set its version.
+ *
+ * @param configFile As from configFileName()
+ *
+ * @return err or nullopt
+ */
+SKETCH_EXPORT std::optional<std::string> updateIno(
+    const fs::path& sketchPath,
+    const std::string& configFile,
+    const config::Config&,
+    logging::Branch&
+);
+
+/**
+ * @return arduino-cli args to compile the sketch for the config's board,
+ *         without the output options.
+ */
+SKETCH_EXPORT std::vector<std::string> compileArgs(
+    const config::Config&, const fs::path& sketchPath
+);
+
+/**
+ * Read flash usage from arduino-cli compile output.
+ */
+SKETCH_EXPORT Usage parseUsage(std::string_view output);
+
+} // namespace sketch
+
@@ -19,6 +19,8 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <set>
+
 #include <wx/panel.h>
 #include <wx/wupdlock.h>
 
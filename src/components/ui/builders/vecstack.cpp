@@ -55,6 +55,7 @@ struct Layout : wxBoxSizer, data::Receiver {
             table.onInsert_ = data::map<&Layout::onInsert>();
             table.preRemove_ = data::map<&Layout::preRemove>();
             table.onSwap_ = data::map<&Layout::onSwap>();
+            table.onResized_ = data::map<&Layout::onResized>();
             return table;
         }()};
         observeWith(vec_, table);
@@ -73,6 +74,8 @@ struct Layout : wxBoxSizer, data::Receiver {
         auto children{ctxt.children()};
         for (auto idx{0}; idx < children.size(); ++idx)
             onInsert(idx);
+
+        onResized();
     }
 
     void onInsert(size pos) {
@@ -115,9 +118,6 @@ struct Layout : wxBoxSizer, data::Receiver {
             }
 
             Insert(sizerPos(pos), mapIter->second);
-
-            if (auto *win{GetContainingWindow()})
-                detail::layoutAndFitFor(win);
         });
     }
 
@@ -198,14 +198,22 @@ struct Layout : wxBoxSizer, data::Receiver {
                 Show(0UZ);
             }
 
-            if (auto *win{GetContainingWindow()})
-                detail::layoutAndFitFor(win);
-
             // This is the end of the model<->item lifecycle, remove from map.
             map_.erase(iter);
         });
     }
 
+    /**
+     * Lay out once for however many items were just inserted or removed,
+     * rather than once per item, which adds up quickly for big vectors.
+     */
+    void onResized() {
+        safeCall([this] {
+            if (auto *win{GetContainingWindow()})
+                detail::layoutAndFitFor(win);
+        });
+    }
+
     // TODO: On at least macOS, when things are swapped buttons don't trigger
     // again until the mouse is moved.
     void onSwap(size pos) {
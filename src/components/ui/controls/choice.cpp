@@ -19,6 +19,8 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <map>
+
 #include <wx/choice.h>
 #include <wx/event.h>
 #include <wx/listbox.h>
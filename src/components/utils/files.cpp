@@ -19,11 +19,16 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <cstdio>
+
 #ifdef _WIN32
+#include <io.h>
 #include <wx/dlimpexp.h>
 #include <errhandlingapi.h>
 // NOLINTNEXTLINE(readability-identifier-naming)
 extern "C" WXIMPORT int CopyFileA(const char *, const char *, int);
+#else
+#include <unistd.h>
 #endif
 
 bool files::copyOverwrite(
@@ -38,3 +43,39 @@ bool files::copyOverwrite(
 #   endif
 }
 
+bool files::writeAtomic(
+    const fs::path& path, std::string_view data, std::error_code& err
+) {
+    auto tmpPath{path};
+    tmpPath += ".tmp";
+
+#   ifdef _WIN32
+    auto *file{_wfopen(tmpPath.c_str(), L"wb")};
+#   else
+    auto *file{std::fopen(tmpPath.c_str(), "wb")};
+#   endif
+    if (not file) {
+        err = {errno, std::generic_category()};
+        return false;
+    }
+
+    bool good{std::fwrite(data.data(), 1, data.size(), file) == data.size()};
+    good = good and std::fflush(file) == 0;
+#   ifdef _WIN32
+    good = good and _commit(_fileno(file)) == 0;
+#   else
+    good = good and fsync(fileno(file)) == 0;
+#   endif
+    good = std::fclose(file) == 0 and good;
+
+    if (not good) {
+        err = {errno, std::generic_category()};
+    } else {
+        fs::rename(tmpPath, path, err);
+        if (not err) return true;
+    }
+
+    std::error_code removeErr;
+    fs::remove(tmpPath, removeErr);
+    return false;
+}
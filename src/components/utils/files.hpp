@@ -21,6 +21,7 @@
 
 #include <filesystem>
 #include <fstream>
+#include <string_view>
 
 #include "utils_export.h"
 
@@ -30,6 +31,18 @@ namespace files {
 
 UTILS_EXPORT bool copyOverwrite(const fs::path& src, const fs::path& dst, std::error_code& err);
 
+/**
+ * Replace the contents of path with data in a single write.
+ *
+ * data is written and synced to a temporary beside path, which is then
+ * renamed over it, so path only ever holds the old or the new contents.
+ *
+ * @return If path was replaced. On failure the temporary is removed.
+ */
+UTILS_EXPORT bool writeAtomic(
+    const fs::path& path, std::string_view data, std::error_code& err
+);
+
 // openInput and openOutput must be inline, otherwise things crash on Windows.
 // Who knows why on earth that is. I tried to debug it a bit and it's just not
 // worth it. Whatever, Microslop.
@@ -47,6 +47,21 @@ SHA256 SHA256::stream(std::istream& stream) {
     return ret;
 }
 
+SHA256 SHA256::buffer(std::string_view buffer) {
+    hash_state hashState;
+    sha256_init(&hashState);
+    sha256_process(
+        &hashState,
+        reinterpret_cast<const unsigned char *>(buffer.data()),
+        buffer.size()
+    );
+
+    std::array<uint8, 32> ret;
+    sha256_done(&hashState, ret.data());
+
+    return ret;
+}
+
 std::optional<SHA256> SHA256::parseString(const std::string& str) {
     // 32-bytes (256 bits / 8 bits per byte) * 2 chars per byte
     if (str.length() != 64) return std::nullopt;
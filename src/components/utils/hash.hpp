@@ -24,6 +24,7 @@
 #include <iostream>
 #include <optional>
 #include <string>
+#include <string_view>
 
 #include "utils/types.hpp"
 
@@ -46,6 +47,10 @@ struct UTILS_EXPORT SHA256 {
      * If a file, should be opened as binary.
      */
     static SHA256 stream(std::istream&);
+    /**
+     * Compute the hash of an in-memory buffer.
+     */
+    static SHA256 buffer(std::string_view);
 
     /**
      * Does not compute the hash of the string, but rather parses it as a
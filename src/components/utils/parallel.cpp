@@ -0,0 +1,148 @@
+#include "parallel.hpp"
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2026 Ryan Ogurek
+ *
+ * components/utils/parallel.cpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+// Set while running a job, so that nested calls don't wait on the pool
+// they're taking up a thread of.
+thread_local bool tInJob{false};
+
+struct Batch {
+    size count_;
+    utils::detail::ParallelJob job_;
+    const void *ctx_;
+
+    std::atomic<size> next_{0};
+    // Pool threads which may still join.
+    size open_;
+    // Pool threads working on it, guarded by the pool mutex.
+    size active_{0};
+
+    void run() {
+        tInJob = true;
+        size idx{};
+        while ((idx = next_.fetch_add(1, std::memory_order_relaxed)) < count_) {
+            job_(ctx_, idx);
+        }
+        tInJob = false;
+    }
+};
+
+struct Pool {
+    Pool() {
+        const auto numThreads{std::max<size>(
+            std::thread::hardware_concurrency(), 1
+        ) - 1};
+
+        for (size idx{0}; idx < numThreads; ++idx) {
+            std::thread{[this] { work(); }}.detach();
+        }
+        mThreads = numThreads;
+    }
+
+    [[nodiscard]] size threads() const { return mThreads; }
+
+    void run(Batch& batch) {
+        // Workers take from open_ as soon as the lock is let go, so wake them
+        // by what it was when queued, not by reading it after.
+        size open{};
+        {
+            std::lock_guard scopeLock(mMutex);
+            mQueue.push_back(&batch);
+            open = batch.open_;
+        }
+        for (size idx{0}; idx < open; ++idx) mWork.notify_one();
+
+        batch.run();
+
+        std::unique_lock scopeLock(mMutex);
+        // Whatever hasn't joined by now isn't needed.
+        std::erase(mQueue, &batch);
+        mDone.wait(scopeLock, [&batch] { return batch.active_ == 0; });
+    }
+
+private:
+    void work() {
+        std::unique_lock scopeLock(mMutex);
+        while (true) {
+            mWork.wait(scopeLock, [this] { return not mQueue.empty(); });
+
+            auto& batch{*mQueue.front()};
+            ++batch.active_;
+            if (--batch.open_ == 0) mQueue.pop_front();
+
+            scopeLock.unlock();
+            batch.run();
+            scopeLock.lock();
+
+            if (--batch.active_ == 0) mDone.notify_all();
+        }
+    }
+
+    std::mutex mMutex;
+    std::condition_variable mWork;
+    std::condition_variable mDone;
+    std::deque<Batch *> mQueue;
+    size mThreads;
+};
+
+Pool& pool() {
+    // Never destroyed, the threads are left to wait until exit rather than
+    // joined during static destruction.
+    static auto& pool{*new Pool};
+    return pool;
+}
+
+} // namespace
+
+void utils::detail::parallelFor(
+    size count, ParallelJob job, const void *ctx, size maxThreads
+) {
+    if (count == 0) return;
+
+    const auto runInline{[&] {
+        for (size idx{0}; idx < count; ++idx) job(ctx, idx);
+    }};
+
+    if (tInJob or maxThreads == 1 or count == 1) {
+        runInline();
+        return;
+    }
+
+    auto& threads{pool()};
+    auto open{std::min(count - 1, threads.threads())};
+    if (maxThreads != 0) open = std::min(open, maxThreads - 1);
+    if (open == 0) {
+        runInline();
+        return;
+    }
+
+    Batch batch{.count_=count, .job_=job, .ctx_=ctx, .open_=open};
+    threads.run(batch);
+}
+
@@ -0,0 +1,62 @@
+#pragma once
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2026 Ryan Ogurek
+ *
+ * components/utils/parallel.hpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/types.hpp"
+
+#include "utils_export.h"
+
+namespace utils {
+
+namespace detail {
+
+using ParallelJob = void (*)(const void *ctx, size idx);
+
+UTILS_EXPORT void parallelFor(
+    size count, ParallelJob, const void *ctx, size maxThreads
+);
+
+} // namespace detail
+
+/**
+ * Run job(idx) for each idx in [0, count) on the shared worker pool, the
+ * calling thread included, and return once all have finished.
+ *
+ * The pool is made once, with a thread per core (less the caller's), so
+ * however many calls there are at once, that's the most threads that run.
+ * Calls from inside a job run inline, on the thread which made them.
+ *
+ * Jobs are handed out in order but may run in any order, so they must be
+ * independent.
+ *
+ * @param maxThreads Limit on threads used, 0 for as many as the pool has.
+ */
+template <typename F>
+void parallelFor(size count, const F& job, size maxThreads = 0) {
+    detail::parallelFor(
+        count,
+        [](const void *ctx, size idx) { (*static_cast<const F *>(ctx))(idx); },
+        &job,
+        maxThreads
+    );
+}
+
+} // namespace utils
+
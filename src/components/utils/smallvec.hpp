@@ -0,0 +1,272 @@
+#pragma once
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2026 Ryan Ogurek
+ *
+ * components/utils/smallvec.hpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include "utils/types.hpp"
+
+namespace utils {
+
+/**
+ * Vector which keeps up to N elements inline, and only allocates past that.
+ *
+ * For the many small lists where the node/buffer allocation would otherwise
+ * cost more than the contents.
+ *
+ * Iterators are plain pointers, and are invalidated by any insertion or
+ * erasure, same as a std::vector which has to grow.
+ */
+template <typename T, size N>
+struct SmallVec {
+    using size_type = ::size;
+
+    static_assert(N > 0);
+
+    SmallVec() = default;
+
+    SmallVec(const SmallVec& other) {
+        reserve(other.mSize);
+        std::uninitialized_copy(other.begin(), other.end(), mData);
+        mSize = other.mSize;
+    }
+
+    SmallVec(SmallVec&& other) noexcept { take(std::move(other)); }
+
+    SmallVec& operator=(const SmallVec& other) {
+        if (this == &other) return *this;
+
+        clear();
+        reserve(other.mSize);
+        std::uninitialized_copy(other.begin(), other.end(), mData);
+        mSize = other.mSize;
+        return *this;
+    }
+
+    SmallVec& operator=(SmallVec&& other) noexcept {
+        if (this == &other) return *this;
+
+        clear();
+        release();
+        take(std::move(other));
+        return *this;
+    }
+
+    ~SmallVec() {
+        clear();
+        release();
+    }
+
+    [[nodiscard]] T *begin() { return mData; }
+    [[nodiscard]] T *end() { return mData + mSize; }
+    [[nodiscard]] const T *begin() const { return mData; }
+    [[nodiscard]] const T *end() const { return mData + mSize; }
+
+    [[nodiscard]] size_type size() const { return mSize; }
+    [[nodiscard]] size_type capacity() const { return mCapacity; }
+    [[nodiscard]] bool empty() const { return mSize == 0; }
+    [[nodiscard]] bool inlined() const { return mData == inlineData(); }
+
+    [[nodiscard]] T& operator[](size_type idx) { return mData[idx]; }
+    [[nodiscard]] const T& operator[](size_type idx) const {
+        return mData[idx];
+    }
+
+    [[nodiscard]] T& back() { return mData[mSize - 1]; }
+    [[nodiscard]] const T& back() const { return mData[mSize - 1]; }
+
+    void reserve(size_type cap) {
+        if (cap <= mCapacity) return;
+
+        std::allocator<T> alloc;
+        auto *data{alloc.allocate(cap)};
+        std::uninitialized_move(begin(), end(), data);
+        std::destroy(begin(), end());
+        release();
+
+        mData = data;
+        mCapacity = cap;
+    }
+
+    template <typename ...Args>
+    T& emplace(T *pos, Args&&... args) {
+        assert(pos >= begin() and pos <= end());
+        const auto idx{static_cast<size_type>(pos - begin())};
+
+        // Build it first, in case args reference an element.
+        T val(std::forward<Args>(args)...);
+        if (mSize == mCapacity) reserve(mCapacity * 2);
+
+        if (idx == mSize) {
+            std::construct_at(mData + mSize, std::move(val));
+        } else {
+            std::construct_at(mData + mSize, std::move(back()));
+            std::move_backward(mData + idx, mData + mSize - 1, mData + mSize);
+            mData[idx] = std::move(val);
+        }
+
+        ++mSize;
+        return mData[idx];
+    }
+
+    template <typename ...Args>
+    T& emplace_back(Args&&... args) {
+        return emplace(end(), std::forward<Args>(args)...);
+    }
+
+    void push_back(const T& val) { emplace_back(val); }
+    void push_back(T&& val) { emplace_back(std::move(val)); }
+
+    /**
+     * Remove the element, keeping the order of the rest.
+     *
+     * @return Iterator to the element which followed.
+     */
+    T *erase(T *pos) {
+        assert(pos >= begin() and pos < end());
+
+        std::move(pos + 1, end(), pos);
+        std::destroy_at(mData + mSize - 1);
+        --mSize;
+        return pos;
+    }
+
+    void clear() {
+        std::destroy(begin(), end());
+        mSize = 0;
+    }
+
+private:
+    [[nodiscard]] T *inlineData() {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return reinterpret_cast<T *>(mInline.data());
+    }
+    [[nodiscard]] const T *inlineData() const {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return reinterpret_cast<const T *>(mInline.data());
+    }
+
+    /**
+     * Give back the heap buffer, if there is one. Must be empty.
+     */
+    void release() {
+        if (not inlined()) std::allocator<T>{}.deallocate(mData, mCapacity);
+
+        mData = inlineData();
+        mCapacity = N;
+    }
+
+    /**
+     * Take other's contents. Must be empty and inline.
+     */
+    void take(SmallVec&& other) {
+        if (other.inlined()) {
+            std::uninitialized_move(other.begin(), other.end(), mData);
+            mSize = other.mSize;
+            other.clear();
+            return;
+        }
+
+        mData = other.mData;
+        mSize = other.mSize;
+        mCapacity = other.mCapacity;
+
+        other.mData = other.inlineData();
+        other.mSize = 0;
+        other.mCapacity = N;
+    }
+
+    alignas(T) std::array<std::byte, N * sizeof(T)> mInline;
+    T *mData{inlineData()};
+    size_type mSize{0};
+    size_type mCapacity{N};
+};
+
+/**
+ * Map kept sorted in a SmallVec.
+ *
+ * Lookup is a binary search, insertion and erasure shift what's after. Meant
+ * for maps which are usually tiny, but shouldn't fall over if they aren't.
+ */
+template <typename K, typename V, size N>
+struct SmallMap {
+    using size_type = ::size;
+    using value_type = std::pair<K, V>;
+
+    [[nodiscard]] value_type *begin() { return mVec.begin(); }
+    [[nodiscard]] value_type *end() { return mVec.end(); }
+    [[nodiscard]] const value_type *begin() const { return mVec.begin(); }
+    [[nodiscard]] const value_type *end() const { return mVec.end(); }
+
+    [[nodiscard]] size_type size() const { return mVec.size(); }
+    [[nodiscard]] bool empty() const { return mVec.empty(); }
+
+    [[nodiscard]] value_type *find(const K& key) {
+        auto *iter{lowerBound(key)};
+        return iter != end() and iter->first == key ? iter : end();
+    }
+    [[nodiscard]] const value_type *find(const K& key) const {
+        return const_cast<SmallMap *>(this)->find(key);
+    }
+
+    [[nodiscard]] bool contains(const K& key) const {
+        return find(key) != end();
+    }
+
+    V& operator[](const K& key) {
+        auto *iter{lowerBound(key)};
+        if (iter != end() and iter->first == key) return iter->second;
+
+        return mVec.emplace(iter, key, V{}).second;
+    }
+
+    /**
+     * @return If the key was found and erased.
+     */
+    bool erase(const K& key) {
+        auto *iter{find(key)};
+        if (iter == end()) return false;
+
+        mVec.erase(iter);
+        return true;
+    }
+
+    void clear() { mVec.clear(); }
+
+private:
+    [[nodiscard]] value_type *lowerBound(const K& key) {
+        return std::lower_bound(
+            begin(),
+            end(),
+            key,
+            [](const value_type& val, const K& key) { return val.first < key; }
+        );
+    }
+
+    SmallVec<value_type, N> mVec;
+};
+
+} // namespace utils
+
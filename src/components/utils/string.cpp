@@ -20,10 +20,15 @@
  */
 
 #include <algorithm>
+#include <array>
+#include <cassert>
 #include <cctype>
 #include <cmath>
+#include <deque>
 #include <iostream>
-#include <stack>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <utility>
 
 #include "utils/types.hpp"
@@ -177,6 +182,45 @@ void utils::trimForNumeric(
     }
 }
 
+namespace {
+
+/**
+ * Control chars are dropped by extractComments(), bar these.
+ */
+bool isDropped(int32 chr) {
+    return std::iscntrl(chr) and chr != '\n' and chr != '\t';
+}
+
+void trimBlockCommentLine(std::string& buf) {
+    // To handle comments like:
+    // /*
+    //  *
+    //  */
+    auto framePos{buf.find(" *")};
+    if (framePos != std::string::npos)
+        // + 3 to take care of " * "
+        buf.erase(0, framePos + 3);
+
+    // The inner loop relies on buf.size() >= 1
+    if (not buf.empty()) {
+        // Trim trailing whitespace
+        for (size idx{buf.size() - 1};; --idx) {
+            if (std::isgraph(buf[idx])) {
+                buf.erase(idx + 1);
+                break;
+            }
+
+            if (idx == 0) {
+                // All whitespace
+                buf.clear();
+                break;
+            }
+        }
+    }
+}
+
+} // namespace
+
 bool utils::extractComments(CommentData& data) {
     uint32 typesToRead{data.type_};
     uint32 reading{CommentData::eType_None};
@@ -194,11 +238,7 @@ bool utils::extractComments(CommentData& data) {
 
         // Don't skip over non-ASCII codes.
 
-        if (
-                std::iscntrl(chr) and
-                chr != '\n' and
-                chr != '\t'
-           ) continue;
+        if (isDropped(chr)) continue;
 
         if (reading == CommentData::eType_None) {
             if (not data.skipNewlines_ and chr == '\n') {
@@ -270,32 +310,7 @@ bool utils::extractComments(CommentData& data) {
             bool end{chr == '*' and data.stream_.peek() == '/'};
 
             if (chr == '\n' or end) {
-                // To handle comments like:
-                // /*
-                //  *
-                //  */
-                auto framePos{buf.find(" *")};
-                if (framePos != std::string::npos)
-                    // + 3 to take care of " * "
-                    buf.erase(0, framePos + 3);
-
-                // The inner loop relies on buf.size() >= 1
-                if (not buf.empty()) {
-                    // Trim trailing whitespace
-                    for (size idx{buf.size() - 1};; --idx) {
-                        if (std::isgraph(buf[idx])) {
-                            buf.erase(idx + 1);
-                            break;
-                        }
-
-                        if (idx == 0) {
-                            // All whitespace
-                            buf.clear();
-                            break;
-                        }
-                    }
-                }
-
+                trimBlockCommentLine(buf);
                 data.out_ += buf;
                 data.out_ += '\n';
                 buf.clear();
@@ -316,247 +331,470 @@ bool utils::extractComments(CommentData& data) {
     }
 }
 
-std::optional<float64> utils::doStringMath(std::string_view str) {
-    enum class Operator {
-        Add,
-        Sub,
-        Mul,
-        Div,
+bool utils::extractComments(BufferCommentData& data) {
+    const uint32 typesToRead{data.type_};
+    const auto buf{data.buf_};
+
+    data.spans_.clear();
+    data.type_ = CommentData::eType_None;
+
+    auto pos{data.pos_};
+    while (pos < buf.size()) {
+        const auto chr{static_cast<unsigned char>(buf[pos])};
+
+        if (isDropped(chr)) {
+            ++pos;
+            continue;
+        }
+
+        if (chr == '\n') {
+            if (not data.skipNewlines_) break;
+            ++pos;
+            continue;
+        }
+
+        if (std::isblank(chr)) {
+            if (not data.skipSpaces_) break;
+            ++pos;
+            continue;
+        }
+
+        if (not std::isgraph(chr)) {
+            ++pos;
+            continue;
+        }
+
+        if (chr != '/' or pos + 1 == buf.size()) break;
+
+        uint32 type{CommentData::eType_None};
+        if ((typesToRead & CommentData::eType_Block) and buf[pos + 1] == '*') {
+            type = CommentData::eType_Block;
+        } else if (
+                (typesToRead & CommentData::eType_Line) and
+                buf[pos + 1] == '/'
+                ) {
+            type = CommentData::eType_Line;
+        }
+
+        // Wasn't a comment
+        if (type == CommentData::eType_None) break;
+
+        // Whitespace after the single comment is still cleared.
+        if (data.single_ and not data.spans_.empty()) break;
+
+        data.type_ |= type;
+        auto& span{data.spans_.emplace_back()};
+        span.type_ = type;
+        span.begin_ = pos + 2;
+
+        // Both of these end up in memchr(), which is already vectorized for
+        // the platform.
+        const auto end{type == CommentData::eType_Line
+            ? buf.find('\n', span.begin_)
+            : buf.find("*/", span.begin_)
+        };
+        if (end == std::string_view::npos) {
+            span.end_ = buf.size();
+            span.unterminated_ = true;
+            pos = buf.size();
+            break;
+        }
+
+        span.end_ = end;
+        pos = end + (type == CommentData::eType_Line ? 1 : 2);
+    }
+
+    data.pos_ = pos;
+    return data.type_ != CommentData::eType_None;
+}
+
+void utils::formatComments(
+    std::string_view buf,
+    std::span<const CommentSpan> spans,
+    std::string& out
+) {
+    std::string line;
+    const auto takeLine{[&](std::string_view text) {
+        line.clear();
+        for (const auto chr : text) {
+            if (not isDropped(static_cast<unsigned char>(chr))) line += chr;
+        }
+    }};
+
+    for (const auto& span : spans) {
+        const auto body{buf.substr(span.begin_, span.end_ - span.begin_)};
+
+        if (span.type_ == CommentData::eType_Line) {
+            // A line comment is only taken once its newline is.
+            if (span.unterminated_) continue;
+
+            if (not out.empty())
+                out += '\n';
 
-        Neg,
+            takeLine(body);
+            trimSurroundingWhitespace(line);
+            out += line;
+            continue;
+        }
+
+        size lineBegin{0};
+        while (not false) {
+            const auto newline{body.find('\n', lineBegin)};
+            // The same goes for each line of a block comment.
+            if (newline == std::string_view::npos and span.unterminated_) {
+                break;
+            }
+
+            const auto lineEnd{newline == std::string_view::npos
+                ? body.size()
+                : newline
+            };
+            takeLine(body.substr(lineBegin, lineEnd - lineBegin));
+            trimBlockCommentLine(line);
+
+            out += line;
+            out += '\n';
+
+            if (newline == std::string_view::npos) {
+                trimSurroundingWhitespace(out);
+                break;
+            }
 
+            lineBegin = newline + 1;
+        }
+    }
+}
+
+struct utils::MathExpression::Compiler {
+    enum class Token {
+        End,
+        Number,
+        Identifier,
+        Plus,
+        Minus,
+        Star,
+        Slash,
         Paren_L,
         Paren_R,
+        Invalid,
     };
-    struct OpPair {
-        float64 val_;
-        std::optional<Operator> op_;
-    };
-    std::stack<std::vector<OpPair>> stack;
-
-    const auto solveLayer{[](std::vector<OpPair>& layer) -> bool {
-        // Can't solve without inputs
-        if (layer.empty()) return false;
-        // There can't be an operator at the back, e.g. 7 - (6 / 2 +), the plus
-        // is nonsense.
-        if (layer.back().op_) return false;
-
-        const auto opPrio{[](Operator op) -> int32 {
-            switch (op) {
-                using enum Operator;
-                case Add:
-                case Sub:
-                    return 1;
-                case Mul:
-                case Div:
-                    return 2;
-                case Neg:
-                    return 3;
-                case Paren_L:
-                case Paren_R:
-                    break;
-            }
 
-            std::unreachable();
-        }};
+    explicit Compiler(std::string_view str) : mStr{str} { next(); }
 
-        const auto apply{[](float64 a, Operator op, float64 b) -> float64 {
-            switch (op) {
-                using enum Operator;
-                case Add:
-                    return a + b;
-                case Neg:
-                case Sub:
-                    return a - b;
-                case Mul:
-                    return a * b;
-                case Div:
-                    return a / b;
-                case Paren_L:
-                case Paren_R:
-                    break;
-            }
+    std::optional<MathExpression> compile() {
+        if (not expression()) return std::nullopt;
+        // Anything left over is e.g. `5 (6)` or `5 6`, which isn't valid C++
+        if (mToken != Token::End) return std::nullopt;
 
-            std::unreachable();
+        mExpr.mDepth = mMaxDepth;
+        return std::move(mExpr);
+    }
+
+private:
+    void next() {
+        while (mPos < mStr.size() and std::isspace(mStr[mPos])) ++mPos;
+
+        if (mPos == mStr.size()) {
+            mToken = Token::End;
+            return;
+        }
+
+        const auto begin{mPos};
+        const auto isWordChar{[](char chr) {
+            return std::isalnum(chr) or chr == '_' or chr == '.';
         }};
 
-        while (layer.size() > 1) {
-            int32 highestPrio{-1};
-            auto highestIter{layer.end()};
-            
-            for (auto iter{layer.begin()}; iter->op_; ++iter) {
-                auto prio{opPrio(*iter->op_)};
-                if (prio > highestPrio) {
-                    highestPrio = prio;
-                    highestIter = iter;
-                }
+        const auto chr{mStr[mPos]};
+        if (std::isdigit(chr) or chr == '.') {
+            while (mPos < mStr.size() and isWordChar(mStr[mPos])) ++mPos;
+            mToken = Token::Number;
+        } else if (std::isalpha(chr) or chr == '_') {
+            while (mPos < mStr.size() and isWordChar(mStr[mPos])) ++mPos;
+            mToken = Token::Identifier;
+        } else {
+            ++mPos;
+            switch (chr) {
+                case '+': mToken = Token::Plus; break;
+                case '-': mToken = Token::Minus; break;
+                case '*': mToken = Token::Star; break;
+                case '/': mToken = Token::Slash; break;
+                case '(': mToken = Token::Paren_L; break;
+                case ')': mToken = Token::Paren_R; break;
+                default: mToken = Token::Invalid; break;
             }
+        }
 
-            auto nextIter{std::next(highestIter)};
-            assert(
-                highestIter != layer.end() and 
-                nextIter != layer.end()
-            );
+        mText = mStr.substr(begin, mPos - begin);
+    }
+
+    void emit(Op op, uint32 idx = 0) {
+        switch (op) {
+            using enum Op;
+            case Value:
+            case Constant:
+                mMaxDepth = std::max(mMaxDepth, ++mDepth);
+                break;
+            case Add:
+            case Sub:
+            case Mul:
+            case Div:
+                --mDepth;
+                break;
+            case Neg:
+                break;
+        }
+
+        mExpr.mCode.push_back({.op_=op, .idx_=idx});
+    }
 
-            auto val{apply(
-                highestIter->val_, *highestIter->op_, nextIter->val_
-            )};
-            nextIter->val_ = val;
+    // expression := term (('+' | '-') term)*
+    bool expression() {
+        if (not term()) return false;
 
-            layer.erase(highestIter);
+        while (mToken == Token::Plus or mToken == Token::Minus) {
+            const auto op{mToken == Token::Plus ? Op::Add : Op::Sub};
+            next();
+            if (not term()) return false;
+            emit(op);
         }
 
-        assert(not layer.back().op_);
         return true;
-    }};
+    }
 
-    const auto parseOp{[](char c) -> std::optional<Operator> {
-        switch (c) {
-            using enum Operator;
-            case '+': return Add;
-            case '-': return Sub;
-            case '*': return Mul;
-            case '/': return Div;
-            case '(': return Paren_L;
-            case ')': return Paren_R;
-            default: return std::nullopt;
-        }
-    }};
+    // term := unary (('*' | '/') unary)*
+    bool term() {
+        if (not unary()) return false;
 
-    const auto parseNum{[](std::string& numStr) -> std::optional<float64> {
-        char *end{nullptr};
-        auto num{strtod(numStr.c_str(), &end)};
-        if (num == HUGE_VAL) return std::nullopt;
-        if (end != &numStr[numStr.size()]) return std::nullopt;
+        while (mToken == Token::Star or mToken == Token::Slash) {
+            const auto op{mToken == Token::Star ? Op::Mul : Op::Div};
+            next();
+            if (not unary()) return false;
+            emit(op);
+        }
 
-        numStr.clear();
-        return num;
-    }};
+        return true;
+    }
 
-    const auto pushNum{[&](float64 num) -> bool {
-        auto& layer{stack.top()};
+    // unary := ('+' | '-') unary | primary
+    bool unary() {
+        if (mToken == Token::Plus) {
+            // E.g. 7 - +6, add is noop
+            next();
+            return unary();
+        }
 
-        if (not layer.empty()) {
-            // Another number cannot be pushed without an operator.
-            if (not layer.back().op_) return false;
+        if (mToken == Token::Minus) {
+            next();
+            if (not unary()) return false;
+            emit(Op::Neg);
+            return true;
         }
 
-        auto& opPair{layer.emplace_back()};
-        opPair.val_ = num;
+        return primary();
+    }
 
-        return true;
-    }};
+    // primary := number | identifier | '(' expression ')'
+    bool primary() {
+        if (mToken == Token::Number) {
+            // strtod needs the terminator.
+            const std::string numStr{mText};
+            char *end{nullptr};
+            const auto num{strtod(numStr.c_str(), &end)};
+            if (num == HUGE_VAL) return false;
+            if (end != numStr.data() + numStr.size()) return false;
+
+            emit(Op::Value, static_cast<uint32>(mExpr.mValues.size()));
+            mExpr.mValues.push_back(num);
+            next();
+            return true;
+        }
 
-    const auto pushOp{[&](Operator op) -> bool {
-        auto& layer{stack.top()};
-
-        if (op == Operator::Paren_L) {
-            if (not stack.top().empty() and not stack.top().back().op_) {
-                // If this isn't the start, or there's no operator preceeding
-                // the paren, then we have a situation like `5 (smth)` which,
-                // while valid math notation, is not valid C++.
-                //
-                // Cannot start new layer/parens 
-                return false;
-            }
+        if (mToken == Token::Identifier) {
+            emit(Op::Constant, static_cast<uint32>(mExpr.mNames.size()));
+            mExpr.mNames.emplace_back(mText);
+            next();
+            return true;
+        }
 
-            // New layer
-            stack.emplace();
+        if (mToken == Token::Paren_L) {
+            next();
+            if (not expression()) return false;
+            if (mToken != Token::Paren_R) return false;
+            next();
             return true;
         }
 
-        if (op == Operator::Paren_R) {
-            // There isn't an extra layer started by a previous '('
-            if (stack.size() == 1) return false;
+        return false;
+    }
 
-            if (not solveLayer(stack.top())) return false;
+    std::string_view mStr;
+    size mPos{0};
 
-            auto val{stack.top().back().val_};
-            stack.pop();
+    Token mToken{Token::End};
+    std::string_view mText;
 
-            auto opPair{stack.top().emplace_back()};
-            opPair.val_ = val;
+    MathExpression mExpr;
+    uint32 mDepth{0};
+    uint32 mMaxDepth{0};
+};
 
-            return true;
-        }
+auto utils::MathExpression::compile(
+    std::string_view str
+) -> std::optional<MathExpression> {
+    return Compiler{str}.compile();
+}
 
-        // If there's nowhere to place the op.
-        if (layer.empty() or layer.back().op_) {
-            switch (op) {
-                using enum Operator;
-                case Add:
-                    // E.g. 7 - +6, add is noop
-                    return true;
-                case Sub:
-                {
-                    // Push new pair for high-priority negation op.
-                    auto& opPair{layer.emplace_back()};
-                    opPair.val_ = 0;
-                    opPair.op_ = Neg;
-                    return true;
-                }
-                case Mul:
-                case Div:
-                    // Mul and DIV cannot appear before a num.
-                    return false;
-                case Neg:
-                    // Cannot push a neg, it is synthesized automatically.
-                case Paren_L:
-                case Paren_R:
-                    // Parens should've been handled above.
-                    break;
-            }
+std::optional<float64> utils::MathExpression::evaluate(
+    std::span<const MathConstant> constants
+) const {
+    // Expressions from configs are shallow, only spill to the heap if not.
+    std::array<float64, 16> localStack;
+    std::vector<float64> heapStack;
+    float64 *stack{localStack.data()};
+    if (mDepth > localStack.size()) {
+        heapStack.resize(mDepth);
+        stack = heapStack.data();
+    }
 
-            std::unreachable();
+    size top{0};
+    for (const auto& instr : mCode) {
+        switch (instr.op_) {
+            using enum Op;
+            case Value:
+                stack[top++] = mValues[instr.idx_];
+                break;
+            case Constant:
+            {
+                const auto& name{mNames[instr.idx_]};
+                const auto iter{std::ranges::find(
+                    constants, std::string_view{name}, &MathConstant::name_
+                )};
+                if (iter == constants.end()) return std::nullopt;
+
+                stack[top++] = iter->value_;
+                break;
+            }
+            case Add:
+                --top;
+                stack[top - 1] += stack[top];
+                break;
+            case Sub:
+                --top;
+                stack[top - 1] -= stack[top];
+                break;
+            case Mul:
+                --top;
+                stack[top - 1] *= stack[top];
+                break;
+            case Div:
+                --top;
+                stack[top - 1] /= stack[top];
+                break;
+            case Neg:
+                stack[top - 1] = -stack[top - 1];
+                break;
         }
+    }
 
-        layer.back().op_ = op;
-        return true;
-    }};
+    assert(top == 1);
+    return stack[0];
+}
 
-    // Create base operations layer;
-    stack.emplace();
+namespace {
 
-    std::string buf;
-    int chr{};
-    for (auto chr : str) {
-        if (std::isspace(chr)) {
-            if (buf.empty()) continue;
+// Strings in a config are few and highly repetitive, so it rarely fills, but
+// when it does the oldest entry is dropped to make room.
+constexpr size MATH_CACHE_MAX{1024};
 
-            auto num{parseNum(buf)};
-            if (not num or not pushNum(*num)) return std::nullopt;
+struct MathCacheHash {
+    using is_transparent = void;
+    size operator()(std::string_view str) const {
+        return std::hash<std::string_view>{}(str);
+    }
+};
+
+// Shared so an expression can be evaluated after the lock is released, even
+// if it's evicted in the meantime.
+using CachedMath = std::shared_ptr<const std::optional<utils::MathExpression>>;
+
+std::mutex mathCacheLock;
+std::unordered_map<
+    std::string,
+    CachedMath,
+    MathCacheHash,
+    std::equal_to<>
+> mathCache;
+// Keys of mathCache, oldest first. Node keys don't move, so these stay valid
+// until erased.
+std::deque<std::string_view> mathCacheOrder;
+
+/**
+ * Strip whitespace which doesn't separate two words, so `1 + 2` and `1+2`
+ * share a cache entry but `1 2` and `12` don't.
+ */
+void normalizeMath(std::string_view str, std::string& out) {
+    const auto isWordChar{[](char chr) {
+        return std::isalnum(chr) or chr == '_' or chr == '.';
+    }};
 
+    out.clear();
+    bool pendingSpace{false};
+    for (const auto chr : str) {
+        if (std::isspace(chr)) {
+            pendingSpace = true;
             continue;
         }
 
-        if (std::isdigit(chr) or chr == '.' or chr == 'x' or chr == 'X') {
-            // See https://en.cppreference.com/w/cpp/language/floating_literal.html
-            // if I want to make this very ~~correct~~ dumb.
-            buf += static_cast<char>(chr);
-        } else if (auto op{parseOp(static_cast<char>(chr))}) {
-            // Make sure number is parsed and pushed before processing op.
-            if (not buf.empty()) {
-                auto num{parseNum(buf)};
-                if (not num or not pushNum(*num)) return std::nullopt;
-            }
+        if (
+                pendingSpace and
+                not out.empty() and
+                isWordChar(out.back()) and
+                isWordChar(chr)
+           ) {
+            out += ' ';
+        }
 
-            if (not pushOp(*op)) return std::nullopt;
-        } else return std::nullopt;
+        pendingSpace = false;
+        out += chr;
     }
+}
 
-    // Ensure any final number is processed.
-    if (not buf.empty()) {
-        auto num{parseNum(buf)};
-        if (not num or not pushNum(*num)) return std::nullopt;
+} // namespace
+
+std::optional<float64> utils::doStringMath(
+    std::string_view str,
+    std::span<const MathConstant> constants
+) {
+    thread_local std::string key;
+    normalizeMath(str, key);
+
+    CachedMath expr;
+    {
+        std::scoped_lock scopeLock{mathCacheLock};
+        auto iter{mathCache.find(std::string_view{key})};
+        if (iter != mathCache.end()) expr = iter->second;
     }
 
-    // Should have a single layer when all is said and done, so long as parens
-    // were properly matched in the string.
-    if (stack.size() != 1) return std::nullopt;
+    if (not expr) {
+        // Compiled w/o the lock, if another thread got there first, theirs
+        // is kept and this one's is just used this once.
+        expr = std::make_shared<const std::optional<MathExpression>>(
+            MathExpression::compile(key)
+        );
+
+        std::scoped_lock scopeLock{mathCacheLock};
+        if (not mathCache.contains(std::string_view{key})) {
+            if (mathCache.size() >= MATH_CACHE_MAX) {
+                mathCache.erase(mathCache.find(mathCacheOrder.front()));
+                mathCacheOrder.pop_front();
+            }
 
-    // Condense to a single pair w/ value and null op.
-    if (not solveLayer(stack.top())) return std::nullopt;
+            auto iter{mathCache.emplace(key, expr).first};
+            mathCacheOrder.emplace_back(iter->first);
+        }
+    }
 
-    return stack.top().back().val_;
+    if (not *expr) return std::nullopt;
+    return (*expr)->evaluate(constants);
 }
 
@@ -21,8 +21,10 @@
 
 #include <cctype>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include <wx/string.h>
 
@@ -140,13 +142,154 @@ struct CommentData {
  */
 [[nodiscard]] UTILS_EXPORT bool extractComments(CommentData&);
 
+/**
+ * A comment read from a buffer, as offsets of its body, between the markers.
+ */
+struct CommentSpan {
+    size begin_;
+    size end_;
+    uint32 type_;
+
+    /**
+     * The comment ran into the end of the buffer without being closed.
+     */
+    bool unterminated_{false};
+};
+
+/**
+ * As CommentData, but for a contiguous buffer. Comments are found with
+ * memchr() rather than char by char, and are reported as spans instead of
+ * copied out. formatComments() can build the text if it's wanted.
+ */
+struct BufferCommentData {
+    std::string_view buf_;
+
+    /**
+     * As an input, where to start reading.
+     *
+     * As an output, the first char after comments and whitespace, or
+     * buf_.size() if the end was reached.
+     */
+    size pos_{0};
+
+    /**
+     * Output for comments read, in order.
+     */
+    std::vector<CommentSpan> spans_;
+
+    /**
+     * As an input, which types of comments to read (none clears whitespace)
+     *
+     * As an output, which types were read.
+     */
+    uint32 type_{CommentData::eType_Line | CommentData::eType_Block};
+
+    /**
+     * Only extract a single comment
+     */
+    bool single_{false};
+
+    /**
+     * Skip over newlines.
+     */
+    bool skipNewlines_{true};
+
+    /**
+     * Skip over spaces.
+     */
+    bool skipSpaces_{true};
+};
+
+/**
+ * Same as extractComments(CommentData&), over a buffer.
+ *
+ * @return If a comment was parsed.
+ */
+[[nodiscard]] UTILS_EXPORT bool extractComments(BufferCommentData&);
+
+/**
+ * Append the text of spans read from buf to out, exactly as
+ * extractComments(CommentData&) would've built its out_.
+ */
+UTILS_EXPORT void formatComments(
+    std::string_view buf,
+    std::span<const CommentSpan> spans,
+    std::string& out
+);
+
+/**
+ * A named value which may appear in math strings, e.g. NO_BLADE
+ */
+struct MathConstant {
+    std::string_view name_;
+    float64 value_;
+};
+
+/**
+ * A math string compiled to a postfix program, which can be evaluated
+ * repeatedly without reparsing.
+ *
+ * Supports + - * / (with unary + -), parens, numbers as strtod reads them,
+ * and identifiers, which are looked up in the constants given at evaluation.
+ */
+class UTILS_EXPORT MathExpression {
+public:
+    /**
+     * @return The compiled expression, nullopt if str is malformed.
+     */
+    [[nodiscard]] static std::optional<MathExpression> compile(
+        std::string_view str
+    );
+
+    /**
+     * @return The value, nullopt if an identifier isn't in constants.
+     */
+    [[nodiscard]] std::optional<float64> evaluate(
+        std::span<const MathConstant> constants = {}
+    ) const;
+
+private:
+    MathExpression() = default;
+
+    struct Compiler;
+
+    enum class Op : uint8 {
+        Value,
+        Constant,
+        Add,
+        Sub,
+        Mul,
+        Div,
+        Neg,
+    };
+
+    struct Instruction {
+        Op op_;
+        // Index into mValues for Value, mNames for Constant
+        uint32 idx_{};
+    };
+
+    std::vector<Instruction> mCode;
+    std::vector<float64> mValues;
+    std::vector<std::string> mNames;
+    // Deepest the evaluation stack gets
+    uint32 mDepth{};
+};
+
 /**
  * Evaluate the string for math operations
  *
+ * Compiled expressions are kept in a bounded cache keyed by the string with
+ * insignificant whitespace removed, so repeated strings aren't reparsed.
+ *
+ * @param constants Values for identifiers in the string.
+ *
  * @return Evaluated value
  */
-[[nodiscard]] UTILS_EXPORT
-std::optional<float64> doStringMath(std::string_view);
+[[nodiscard]] UTILS_EXPORT std::optional<float64> doStringMath(
+    std::string_view,
+    std::span<const MathConstant> constants = {}
+);
 
 } // namespace utils
 
@@ -0,0 +1,42 @@
+#pragma once
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2026 Ryan Ogurek
+ *
+ * components/utils/timing.hpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+
+#include "utils/types.hpp"
+
+namespace utils {
+
+/**
+ * @return Wall time func took to run, in milliseconds
+ */
+template <typename F>
+float64 timeMs(const F& func) {
+    const auto start{std::chrono::steady_clock::now()};
+    func();
+    const std::chrono::duration<float64, std::milli> elapsed{
+        std::chrono::steady_clock::now() - start
+    };
+    return elapsed.count();
+}
+
+} // namespace utils
+
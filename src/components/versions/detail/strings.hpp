@@ -37,6 +37,7 @@ constexpr cstring SUPPORTED_VERSIONS_STR{"SUPPORTED_VERSIONS"};
 
 constexpr cstring INFO_FILE_STR{"info.pconf"};
 constexpr cstring DATA_FILE_STR{"data.pconf"};
+constexpr cstring DATA_CACHE_FILE_STR{"data.cache"};
 constexpr cstring HEADER_FILE_STR{"header.h"};
 
 } // namespace versions::detail
@@ -0,0 +1,692 @@
+#include "cache.hpp"
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2026 Ryan Ogurek
+ *
+ * components/versions/priv/cache.cpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <array>
+#include <cstring>
+#include <map>
+#include <type_traits>
+#include <unordered_map>
+
+#include <wx/string.h>
+
+#include "log/logger.hpp"
+#include "pconf/parse.hpp"
+#include "utils/hash.hpp"
+#include "versions/detail/strings.hpp"
+
+using namespace versions;
+using namespace versions::props;
+
+namespace {
+
+constexpr std::array<char, 4> MAGIC{'P', 'C', 'P', 'D'};
+
+/**
+ * For the layout of the header. Changes to PropData or how it's parsed are
+ * caught by PARSER_BUILD instead.
+ */
+constexpr uint32 FORMAT_VERSION{2};
+
+/**
+ * Written in native byte order, the cache is never meant to leave the machine
+ * that made it.
+ */
+struct Header {
+    std::array<char, 4> magic_;
+    uint32 version_;
+    std::array<uint8, 32> parserHash_;
+
+    uint64 sourceSize_;
+    std::array<uint8, 32> sourceHash_;
+
+    uint64 payloadSize_;
+    std::array<uint8, 32> payloadHash_;
+};
+static_assert(std::is_trivially_copyable_v<Header>);
+
+enum class SettingType : uint8 {
+    Toggle,
+    Selection,
+    Option,
+    Integer,
+    Decimal,
+};
+
+enum class LayoutChild : uint8 {
+    Setting,
+    Divider,
+    Layout,
+};
+
+class Writer {
+public:
+    template <typename T> requires std::is_arithmetic_v<T> or std::is_enum_v<T>
+    void write(T val) {
+        mBuffer.append(reinterpret_cast<const char *>(&val), sizeof val);
+    }
+
+    void write(std::string_view str) {
+        write(static_cast<uint32>(str.size()));
+        mBuffer.append(str);
+    }
+
+    void write(const Require& req) {
+        write(static_cast<uint8>(req.external_));
+        write(static_cast<uint8>(req.inverted_));
+        write(req.key_);
+    }
+
+    template <typename T>
+    void write(const std::optional<T>& opt) {
+        write(static_cast<uint8>(opt.has_value()));
+        if (opt) write(*opt);
+    }
+
+    template <typename A, typename B>
+    void write(const std::pair<A, B>& pair) {
+        write(pair.first);
+        write(pair.second);
+    }
+
+    template <typename T>
+    void write(const std::vector<T>& vec) {
+        write(static_cast<uint32>(vec.size()));
+        for (const auto& item : vec) write(item);
+    }
+
+    [[nodiscard]] const std::string& buffer() const { return mBuffer; }
+
+private:
+    std::string mBuffer;
+};
+
+/**
+ * Every read is bounds-checked, and once anything fails all further reads
+ * return default values, so callers only need to check failed() at the end.
+ */
+class Reader {
+public:
+    Reader(std::string_view buffer) : mRemaining{buffer} {}
+
+    template <typename T> requires std::is_arithmetic_v<T> or std::is_enum_v<T>
+    void read(T& val) {
+        val = {};
+        if (not take(sizeof val)) return;
+        std::memcpy(&val, mTaken.data(), sizeof val);
+    }
+
+    void read(std::string& str) {
+        uint32 length{};
+        read(length);
+        str.assign(take(length) ? mTaken : std::string_view{});
+    }
+
+    void read(bool& val) {
+        uint8 raw{};
+        read(raw);
+        val = raw;
+    }
+
+    void read(Require& req) {
+        read(req.external_);
+        read(req.inverted_);
+        read(req.key_);
+    }
+
+    template <typename T>
+    void read(std::optional<T>& opt) {
+        bool hasValue{};
+        read(hasValue);
+        opt.reset();
+        if (hasValue) read(opt.emplace());
+    }
+
+    template <typename A, typename B>
+    void read(std::pair<A, B>& pair) {
+        read(pair.first);
+        read(pair.second);
+    }
+
+    template <typename T>
+    void read(std::vector<T>& vec) {
+        vec.clear();
+        vec.resize(count());
+        for (auto& item : vec) read(item);
+    }
+
+    /**
+     * Read an element count.
+     *
+     * Every element is at least a byte, so this also makes sure corrupt data
+     * can't cause a huge allocation.
+     */
+    [[nodiscard]] uint32 count() {
+        const auto ret{get<uint32>()};
+        if (ret > mRemaining.size()) {
+            mFailed = true;
+            return 0;
+        }
+
+        return ret;
+    }
+
+    template <typename T>
+    [[nodiscard]] T get() {
+        T ret{};
+        read(ret);
+        return ret;
+    }
+
+    void fail() { mFailed = true; }
+    [[nodiscard]] bool failed() const { return mFailed; }
+    [[nodiscard]] bool done() const { return mRemaining.empty(); }
+
+private:
+    bool take(size bytes) {
+        if (mFailed or bytes > mRemaining.size()) {
+            mFailed = true;
+            return false;
+        }
+
+        mTaken = mRemaining.substr(0, bytes);
+        mRemaining.remove_prefix(bytes);
+        return true;
+    }
+
+    std::string_view mRemaining;
+    std::string_view mTaken;
+    bool mFailed{false};
+};
+
+fs::path cachePath(const fs::path& source) {
+    auto ret{source};
+    ret.replace_filename(versions::detail::DATA_CACHE_FILE_STR);
+    return ret;
+}
+
+std::array<uint8, 32> parserHash() {
+    static const auto hash{
+        utils::hash::SHA256::buffer(priv::PARSER_BUILD).value()
+    };
+    return hash;
+}
+
+void writeCommon(Writer& writer, const props::detail::Data& data) {
+    writer.write(data.name_);
+    writer.write(data.define_);
+    writer.write(data.description_);
+    writer.write(data.required_);
+    writer.write(data.requireAny_);
+}
+
+props::detail::Data readCommon(Reader& reader) {
+    auto name{reader.get<std::string>()};
+    auto define{reader.get<std::string>()};
+    auto description{reader.get<std::string>()};
+    auto required{reader.get<std::vector<Require>>()};
+    auto requireAny{reader.get<std::vector<Require>>()};
+
+    return {
+        std::move(name),
+        std::move(define),
+        std::move(description),
+        std::move(required),
+        std::move(requireAny)
+    };
+}
+
+template <typename Params>
+void writeParams(Writer& writer, const Params& params) {
+    writer.write(params.min_);
+    writer.write(params.max_);
+    writer.write(params.inc_);
+    writer.write(params.off_);
+}
+
+template <typename Params>
+Params readParams(Reader& reader) {
+    Params ret;
+    reader.read(ret.min_);
+    reader.read(ret.max_);
+    reader.read(ret.inc_);
+    reader.read(ret.off_);
+    return ret;
+}
+
+bool writeSettings(
+    Writer& writer,
+    const std::vector<std::unique_ptr<props::detail::Data>>& settings
+) {
+    // Options refer to their selections, which always come before them.
+    std::unordered_map<const props::detail::Data *, uint32> indices;
+
+    writer.write(static_cast<uint32>(settings.size()));
+    for (const auto& setting : settings) {
+        indices.emplace(setting.get(), indices.size());
+
+        if (const auto *ptr{dynamic_cast<const ToggleData *>(setting.get())}) {
+            writer.write(SettingType::Toggle);
+            writeCommon(writer, *ptr);
+            writer.write(ptr->disables_);
+            writer.write(ptr->recommends_);
+        } else if (const auto *ptr{dynamic_cast<const OptionData::SelectionData *>(setting.get())}) {
+            writer.write(SettingType::Selection);
+            writeCommon(writer, *ptr);
+            writer.write(ptr->disables_);
+            writer.write(ptr->recommends_);
+        } else if (const auto *ptr{dynamic_cast<const OptionData *>(setting.get())}) {
+            writer.write(SettingType::Option);
+            writeCommon(writer, *ptr);
+
+            writer.write(static_cast<uint32>(ptr->selections_.size()));
+            for (const auto *selection : ptr->selections_) {
+                const auto iter{indices.find(selection)};
+                if (iter == indices.end()) return false;
+
+                writer.write(iter->second);
+            }
+        } else if (const auto *ptr{dynamic_cast<const IntegerData *>(setting.get())}) {
+            writer.write(SettingType::Integer);
+            writeCommon(writer, *ptr);
+            writeParams(writer, ptr->params_);
+            writer.write(ptr->defaultVal_);
+        } else if (const auto *ptr{dynamic_cast<const DecimalData *>(setting.get())}) {
+            writer.write(SettingType::Decimal);
+            writeCommon(writer, *ptr);
+            writeParams(writer, ptr->params_);
+            writer.write(ptr->defaultVal_);
+        } else {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::vector<std::unique_ptr<props::detail::Data>> readSettings(Reader& reader) {
+    std::vector<std::unique_ptr<props::detail::Data>> ret;
+
+    const auto count{reader.count()};
+    for (uint32 idx{0}; idx < count and not reader.failed(); ++idx) {
+        const auto type{reader.get<SettingType>()};
+        auto common{readCommon(reader)};
+
+        switch (type) {
+            case SettingType::Toggle: {
+                auto disables{reader.get<props::detail::Disables>()};
+                auto recommends{reader.get<props::detail::Recommends>()};
+                ret.push_back(std::make_unique<ToggleData>(
+                    std::move(common), std::move(disables), std::move(recommends)
+                ));
+                break;
+            }
+            case SettingType::Selection: {
+                auto disables{reader.get<props::detail::Disables>()};
+                auto recommends{reader.get<props::detail::Recommends>()};
+                ret.push_back(std::make_unique<OptionData::SelectionData>(
+                    std::move(common), std::move(disables), std::move(recommends)
+                ));
+                break;
+            }
+            case SettingType::Option: {
+                std::vector<OptionData::SelectionData *> selections;
+                const auto numSelections{reader.count()};
+                for (uint32 selIdx{0}; selIdx < numSelections; ++selIdx) {
+                    const auto index{reader.get<uint32>()};
+                    auto *selection{index < ret.size()
+                        ? dynamic_cast<OptionData::SelectionData *>(ret[index].get())
+                        : nullptr
+                    };
+                    if (not selection) {
+                        reader.fail();
+                        return {};
+                    }
+
+                    selections.push_back(selection);
+                }
+
+                ret.push_back(std::make_unique<OptionData>(
+                    std::move(common), std::move(selections)
+                ));
+                break;
+            }
+            case SettingType::Integer: {
+                auto params{readParams<data::base::Integer::Params>(reader)};
+                auto defaultVal{reader.get<std::optional<int32>>()};
+                ret.push_back(std::make_unique<IntegerData>(
+                    std::move(common), params, defaultVal
+                ));
+                break;
+            }
+            case SettingType::Decimal: {
+                auto params{readParams<data::base::Decimal::Params>(reader)};
+                auto defaultVal{reader.get<std::optional<float64>>()};
+                ret.push_back(std::make_unique<DecimalData>(
+                    std::move(common), params, defaultVal
+                ));
+                break;
+            }
+            default:
+                reader.fail();
+                return {};
+        }
+    }
+
+    return ret;
+}
+
+void writeLayout(Writer& writer, const Layout& layout) {
+    writer.write(static_cast<int32>(layout.orient_));
+    writer.write(std::string_view{layout.label_.utf8_string()});
+
+    writer.write(static_cast<uint32>(layout.children_.size()));
+    for (const auto& child : layout.children_) {
+        if (const auto *ptr{std::get_if<std::string>(&child)}) {
+            writer.write(LayoutChild::Setting);
+            writer.write(*ptr);
+        } else if (std::holds_alternative<Layout::Divider>(child)) {
+            writer.write(LayoutChild::Divider);
+        } else {
+            writer.write(LayoutChild::Layout);
+            writeLayout(writer, std::get<Layout>(child));
+        }
+    }
+}
+
+void readLayout(Reader& reader, Layout& layout) {
+    layout.orient_ = static_cast<wxOrientation>(reader.get<int32>());
+    layout.label_ = wxString::FromUTF8(reader.get<std::string>());
+
+    const auto count{reader.count()};
+    for (uint32 idx{0}; idx < count and not reader.failed(); ++idx) {
+        switch (reader.get<LayoutChild>()) {
+            case LayoutChild::Setting:
+                layout.children_.emplace_back(reader.get<std::string>());
+                break;
+            case LayoutChild::Divider:
+                layout.children_.emplace_back(Layout::Divider{});
+                break;
+            case LayoutChild::Layout:
+                readLayout(reader, std::get<Layout>(
+                    layout.children_.emplace_back(Layout{})
+                ));
+                break;
+            default:
+                reader.fail();
+                return;
+        }
+    }
+}
+
+void writeButtons(Writer& writer, const std::map<uint32, Buttons>& buttons) {
+    writer.write(static_cast<uint32>(buttons.size()));
+    for (const auto& [numButtons, states] : buttons) {
+        writer.write(numButtons);
+
+        writer.write(static_cast<uint32>(states.size()));
+        for (const auto& state : states) {
+            writer.write(state.stateName_);
+
+            writer.write(static_cast<uint32>(state.buttons_.size()));
+            for (const auto& button : state.buttons_) {
+                writer.write(button.name_);
+                writer.write(button.descriptions_);
+            }
+        }
+    }
+}
+
+std::map<uint32, Buttons> readButtons(Reader& reader) {
+    std::map<uint32, Buttons> ret;
+
+    const auto count{reader.count()};
+    for (uint32 idx{0}; idx < count and not reader.failed(); ++idx) {
+        auto& states{ret[reader.get<uint32>()]};
+
+        states.resize(reader.count());
+        for (auto& state : states) {
+            reader.read(state.stateName_);
+
+            state.buttons_.resize(reader.count());
+            for (auto& button : state.buttons_) {
+                reader.read(button.name_);
+                reader.read(button.descriptions_);
+            }
+
+            if (reader.failed()) return {};
+        }
+    }
+
+    return ret;
+}
+
+std::optional<PropData> readPropData(Reader& reader) {
+    auto name{reader.get<std::string>()};
+    auto filename{reader.get<std::string>()};
+    auto info{reader.get<std::string>()};
+
+    std::optional<MenuSupport> menuSupport;
+    if (reader.get<bool>()) {
+        menuSupport = MenuSupport{reader.get<std::string>()};
+    }
+
+    auto settings{readSettings(reader)};
+    auto buttons{readButtons(reader)};
+
+    Layout layout;
+    readLayout(reader, layout);
+
+    Errors errors;
+    const auto numErrors{reader.count()};
+    for (uint32 idx{0}; idx < numErrors and not reader.failed(); ++idx) {
+        auto arduinoError{reader.get<std::string>()};
+        auto displayError{reader.get<std::string>()};
+        errors.push_back({
+            .arduinoError_=std::move(arduinoError),
+            .displayError_=std::move(displayError),
+        });
+    }
+
+    if (reader.failed() or not reader.done()) return std::nullopt;
+
+    return std::make_optional<PropData>(
+        std::move(name),
+        std::move(filename),
+        std::move(info),
+        std::move(menuSupport),
+        std::move(settings),
+        std::move(buttons),
+        std::move(layout),
+        std::move(errors)
+    );
+}
+
+bool writePropData(Writer& writer, const PropData& data) {
+    writer.write(data.name_);
+    writer.write(data.filename_);
+    writer.write(data.info_);
+
+    writer.write(static_cast<uint8>(data.menuSupport_.has_value()));
+    if (data.menuSupport_) {
+        writer.write(data.menuSupport_->defaultSpecTemplate_);
+    }
+
+    if (not writeSettings(writer, data.settings_)) return false;
+    writeButtons(writer, data.buttons_);
+    writeLayout(writer, data.layout_);
+
+    writer.write(static_cast<uint32>(data.errors_.size()));
+    for (const auto& error : data.errors_) {
+        writer.write(error.arduinoError_);
+        writer.write(error.displayError_);
+    }
+
+    return true;
+}
+
+} // namespace
+
+std::optional<PropData> priv::loadPropCache(
+    const fs::path& source, logging::Branch *lBranch
+) {
+    auto& logger{logging::Branch::optCreateLogger("versions::priv::loadPropCache()", lBranch)};
+
+    const auto path{cachePath(source)};
+
+    std::error_code ec;
+    if (not fs::exists(path, ec)) {
+        logger.debug("No cache.");
+        return std::nullopt;
+    }
+
+    const auto sourceSize{fs::file_size(source, ec)};
+    if (ec) {
+        logger.warn("Could not stat source: " + ec.message());
+        return std::nullopt;
+    }
+
+    std::unique_ptr<char[]> buffer;
+    size length{};
+    if (not pconf::readFile(path, buffer, length, logger.bverbose("Reading cache..."))) {
+        return std::nullopt;
+    }
+
+    Header header;
+    if (length < sizeof header) {
+        logger.warn("Cache is truncated.");
+        return std::nullopt;
+    }
+    std::memcpy(&header, buffer.get(), sizeof header);
+
+    if (
+            header.magic_ != MAGIC or
+            header.version_ != FORMAT_VERSION or
+            header.parserHash_ != parserHash()
+       ) {
+        logger.info("Cache is from a different version.");
+        return std::nullopt;
+    }
+
+    if (header.sourceSize_ != sourceSize) {
+        logger.info("Cache is stale.");
+        return std::nullopt;
+    }
+
+    // mtime isn't reliable (the file could've been edited within its
+    // granularity, or copied over with its time kept), so always check the
+    // content. Still far cheaper than parsing it.
+    std::unique_ptr<char[]> sourceBuffer;
+    size sourceLength{};
+    if (not pconf::readFile(source, sourceBuffer, sourceLength, logger.bverbose("Reading source..."))) {
+        return std::nullopt;
+    }
+
+    const auto sourceHash{utils::hash::SHA256::buffer(
+        {sourceBuffer.get(), sourceLength}
+    )};
+    if (sourceHash.value() != header.sourceHash_) {
+        logger.info("Cache is stale.");
+        return std::nullopt;
+    }
+
+    const std::string_view payload{
+        buffer.get() + sizeof header, length - sizeof header
+    };
+    if (
+            header.payloadSize_ != payload.size() or
+            utils::hash::SHA256::buffer(payload).value() != header.payloadHash_
+        ) {
+        logger.warn("Cache is corrupt.");
+        return std::nullopt;
+    }
+
+    Reader reader{payload};
+    auto ret{readPropData(reader)};
+    if (not ret) {
+        logger.warn("Cache could not be decoded.");
+        return std::nullopt;
+    }
+
+    return ret;
+}
+
+void priv::savePropCache(
+    const fs::path& source,
+    std::string_view content,
+    const PropData& data,
+    logging::Branch *lBranch
+) {
+    auto& logger{logging::Branch::optCreateLogger("versions::priv::savePropCache()", lBranch)};
+
+    Writer writer;
+    if (not writePropData(writer, data)) {
+        logger.error("Prop data could not be encoded.");
+        return;
+    }
+    const auto& payload{writer.buffer()};
+
+    const Header header{
+        .magic_=MAGIC,
+        .version_=FORMAT_VERSION,
+        .parserHash_=parserHash(),
+        .sourceSize_=static_cast<uint64>(content.size()),
+        .sourceHash_=utils::hash::SHA256::buffer(content).value(),
+        .payloadSize_=static_cast<uint64>(payload.size()),
+        .payloadHash_=utils::hash::SHA256::buffer(payload).value(),
+    };
+
+    // Written to the side and moved into place so a reader never sees a
+    // partial cache.
+    std::error_code ec;
+    const auto path{cachePath(source)};
+    auto tmpPath{path};
+    tmpPath += ".tmp";
+
+    {
+        auto file{files::openOutput(tmpPath)};
+        file.write(reinterpret_cast<const char *>(&header), sizeof header);
+        file.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+
+        if (not file.good()) {
+            logger.warn("Failed to write cache.");
+            file.close();
+            fs::remove(tmpPath, ec);
+            return;
+        }
+    }
+
+    fs::rename(tmpPath, path, ec);
+    if (ec) {
+        logger.warn("Failed to move cache into place: " + ec.message());
+        fs::remove(tmpPath, ec);
+        return;
+    }
+
+    logger.debug("Wrote cache.");
+}
+
+std::optional<std::string> priv::encodePropData(const PropData& data) {
+    Writer writer;
+    if (not writePropData(writer, data)) return std::nullopt;
+
+    return writer.buffer();
+}
+
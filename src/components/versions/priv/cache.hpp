@@ -0,0 +1,73 @@
+#pragma once
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2026 Ryan Ogurek
+ *
+ * components/versions/priv/cache.hpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <optional>
+#include <string_view>
+
+#include "log/branch.hpp"
+#include "utils/files.hpp"
+#include "versions/prop.hpp"
+
+namespace versions::priv {
+
+/**
+ * Identifies the build of the prop parser, so caches from any other are
+ * never trusted.
+ *
+ * Defined alongside the parser, which is rebuilt whenever it or PropData
+ * changes.
+ */
+extern const std::string_view PARSER_BUILD;
+
+/**
+ * Load the binary image of a PropData stored next to its data.pconf.
+ *
+ * The cache is only used if it was written by this build of the parser, and
+ * the source has the same size and content hash as when it was.
+ *
+ * @param source Path to the data.pconf
+ *
+ * @return The cached PropData, nullopt if there is no valid cache.
+ */
+std::optional<props::PropData> loadPropCache(
+    const fs::path& source, logging::Branch *
+);
+
+/**
+ * Write the cache for source. Failure is logged, but is otherwise harmless.
+ *
+ * @param content The content of source which data was generated from.
+ */
+void savePropCache(
+    const fs::path& source,
+    std::string_view content,
+    const props::PropData& data,
+    logging::Branch *
+);
+
+/**
+ * @return The binary image of data as it's cached, or nullopt if it can't be
+ *         encoded. Equal images mean equal PropData.
+ */
+std::optional<std::string> encodePropData(const props::PropData&);
+
+} // namespace versions::priv
+
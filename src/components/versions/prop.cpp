@@ -19,8 +19,10 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <array>
 #include <memory>
 #include <optional>
+#include <string_view>
 #include <unordered_set>
 #include <utility>
 #include <variant>
@@ -30,6 +32,7 @@
 #include "log/branch.hpp"
 #include "log/context.hpp"
 #include "log/logger.hpp"
+#include "pconf/parse.hpp"
 #include "pconf/utils.hpp"
 #include "ui/controls/checkbox.hpp"
 #include "ui/controls/radios.hpp"
@@ -42,28 +45,136 @@
 #include "ui/types.hpp"
 #include "ui/values.hpp"
 #include "utils/string.hpp"
+#include "versions/priv/cache.hpp"
 #include "versions/priv/data.hpp"
 
 using namespace versions::props;
 
+// Stamped into prop caches. Any change here, or to PropData, rebuilds this,
+// and so rules out every cache the old build wrote.
+const std::string_view versions::priv::PARSER_BUILD{
+    wxSTRINGIZE(BIN_VERSION) " " __DATE__ " " __TIME__
+};
+
 namespace {
 
-std::vector<std::unique_ptr<detail::Data>> parseSettings(
-    const pconf::Data&, logging::Branch&
-);
+/**
+ * Collects the contents of a SETTINGS section in a single pass.
+ *
+ * Only what's actually used from each setting is kept, and nothing is
+ * validated or logged until finish(), so that output matches (and is ordered
+ * the same as) looking everything up in the parsed tree.
+ */
+class SettingsReader : public pconf::Handler {
+public:
+    bool onSectionBegin(const pconf::Event&) override;
+    bool onEntry(const pconf::Event&) override;
+    bool onSectionEnd() override;
+
+    std::vector<std::unique_ptr<detail::Data>> finish(logging::Branch&);
+
+private:
+    enum Key {
+        NAME,
+        DESCRIPTION,
+        REQUIRE,
+        REQUIREANY,
+        DISABLE,
+        MIN,
+        MAX,
+        INCREMENT,
+        DEFAULT,
+        NUM_KEYS,
+    };
+
+    /**
+     * Only the first entry for any key is used.
+     */
+    struct Field {
+        bool seen_{false};
+        std::optional<std::string> value_;
+    };
+
+    struct Pending {
+        std::string type_;
+        std::optional<std::string> label_;
+        bool isSection_{false};
+
+        std::array<Field, NUM_KEYS> fields_;
+        bool recommendsSeen_{false};
+        detail::Recommends recommends_;
+        std::vector<Pending> selections_;
+    };
+
+    enum class Frame {
+        Skip,
+        Setting,
+        Recommends,
+    };
+
+    static Pending pending(const pconf::Event&, bool isSection);
+    static bool record(Pending&, const pconf::Event&);
+
+    /**
+     * Parse entries that are somewhat common across setting/data sections,
+     * and verify that a label is present for the section (see requireLabel).
+     *
+     * @param requireLabel If the label is actually required for this section
+     * @param requireName If the NAME entry is required for this section
+     */
+    static std::optional<detail::Data> parseSettingCommon(
+        const Pending&,
+        logging::Logger&,
+        bool requireLabel,
+        bool requireName
+    );
+
+    std::vector<Pending> mToggles;
+    std::vector<Pending> mOptions;
+    std::vector<Pending> mNumerics;
+    std::vector<Pending> mDecimals;
+
+    std::vector<std::pair<Frame, Pending *>> mStack;
+};
+
+/**
+ * Routes the first SETTINGS section to a SettingsReader, and builds
+ * everything else as a (much smaller) pconf::Data.
+ */
+class PropReader : public pconf::Handler {
+public:
+    PropReader(pconf::Data& rest) : mRest{rest} {}
+
+    bool onSectionBegin(const pconf::Event&) override;
+    bool onEntry(const pconf::Event&) override;
+    bool onSectionEnd() override;
+
+    /**
+     * @return Reader for SETTINGS, if it was present and a section.
+     */
+    SettingsReader *settings() {
+        return mSettingsSection ? &mSettings : nullptr;
+    }
+
+private:
+    pconf::DataBuilder mRest;
+    SettingsReader mSettings;
+
+    bool mSettingsSeen{false};
+    bool mSettingsSection{false};
+    size mDepth{0};
+    size mSettingsDepth{0};
+};
 
 /**
- * Parse entries that are somewhat common across setting/data sections,
- * and verify that a label is present for the section (see requireLabel).
+ * Everything in a PropData except settings comes from data.
  *
- * @param requireLabel If the label is actually required for this section
- * @param requireName If the NAME entry is required for this section
+ * @param settings nullptr if there's no SETTINGS section
  */
-std::optional<std::pair<detail::Data, pconf::HashedData>> parseSettingCommon(
-    const pconf::EntryPtr&,
-    logging::Logger&,
-    bool requireLabel,
-    bool requireName
+std::optional<PropData> assemble(
+    const pconf::HashedData& data,
+    SettingsReader *settings,
+    logging::Logger&
 );
 
 Layout parseLayout(
@@ -296,173 +407,31 @@ std::optional<PropData> PropData::generate(
 ) {
     auto& logger{logging::Branch::optCreateLogger("versions::Prop::generate()", lBranch)};
 
-    const auto nameEntry{data.find("NAME")};
-    if (not nameEntry or not nameEntry->value_) {
-        logger.error("Missing name.");
-        return std::nullopt;
-    }
-    auto name{*nameEntry->value_};
-
-    const auto filenameEntry{data.find("FILENAME")};
-    if (not filenameEntry or not filenameEntry->value_) {
-        logger.error("Missing filename.");
-        return std::nullopt;
-    }
-    auto filename{*filenameEntry->value_};
-
-    std::string info;
-    const auto infoEntry{data.find("INFO")};
-    if (not infoEntry or not infoEntry->value_) {
-        logger.info("No info...");
-        info = "Prop has no additional info.";
-    } else {
-        info = *infoEntry->value_;
-    }
-
-    std::vector<std::unique_ptr<detail::Data>> settings;
+    SettingsReader settings;
 
     const auto settingsEntry{data.find("SETTINGS")};
-    if (not settingsEntry or not settingsEntry.section()) {
-        logger.info("No settings section...");
-    } else {
-        settings = parseSettings(
-            settingsEntry.section()->entries_,
-            *logger.bdebug("Parsing SETTINGS...")
-        );
+    const auto hasSettings{settingsEntry and settingsEntry.isSection()};
+    if (hasSettings) {
+        pconf::walk(settingsEntry.section()->entries_, settings);
     }
 
-    Layout layout;
-
-    const auto layoutEntry{data.find("LAYOUT")};
-    if (not layoutEntry or not layoutEntry.section()) {
-        logger.info("No layout section...");
-    } else {
-        layout = parseLayout(
-            layoutEntry.section()->entries_,
-            *logger.bdebug("Parsing LAYOUT...")
-        );
-    }
-
-    // Warn on duplicate and unused settings/those not in layout.
-    {
-        std::unordered_set<std::string> settingStrings;
-        for (auto& setting : settings) {
-            if (dynamic_cast<Option::SelectionData *>(setting.get()))
-                continue;
-
-            auto [iter, inserted]{settingStrings.insert(setting->define_)};
-            if (not inserted) {
-                logger.warn("Duplicate settings for " + setting->define_);
-            }
-        }
-
-        const auto processLayout{[&](auto self, const Layout& layout) -> void {
-            for (const auto& child : layout.children_) {
-                if (const auto *ptr{std::get_if<std::string>(&child)}) {
-                    settingStrings.erase(*ptr);
-                } else if (const auto *ptr{std::get_if<Layout>(&child)}) {
-                    self(self, *ptr);
-                }
-            }
-        }};
-        processLayout(processLayout, layout);
-
-        for (const auto& str : settingStrings) {
-            logger.warn("Unused setting " + str);
-        }
-    }
-
-    std::map<uint32, Buttons> buttons;
-
-    const auto buttonEntries{data.findAll("BUTTONS")};
-    for (const auto& buttonEntry : buttonEntries) {
-        if (not buttonEntry.section()) {
-            logger.warn("Skipping non-section BUTTONS...");
-            continue;
-        }
-
-        if (not buttonEntry->labelNum_) {
-            logger.warn("Skipping BUTTONS w/o num label...");
-            continue;
-        }
-
-        const auto numButtons{*buttonEntry->labelNum_};
-        if (buttons.contains(numButtons)) {
-            logger.warn("Skipping duplicate BUTTONS{" + std::to_string(numButtons) + "}...");
-            continue;
-        }
-
-        buttons[numButtons] = parseButtons(
-            buttonEntry.section()->entries_,
-            buttons,
-            *logger.bdebug("Parsing BUTTONS " + std::to_string(numButtons) + "...")
-        );
-
-        // Build a temp lookup set
-        std::unordered_set<std::string> settingLookup;
-        for (auto& data : settings) {
-            settingLookup.insert(data->define_);
-
-            if (auto *ptr{dynamic_cast<OptionData *>(data.get())}) {
-                for (auto *selData : ptr->selections_)
-                    settingLookup.insert(selData->define_);
-            }
-        }
-
-        // Then check to warn if there's any non-existent predicates.
-        for (auto& state : buttons[numButtons]) {
-            for (auto& button : state.buttons_) {
-                for (auto& [pred, description] : button.descriptions_) {
-                    if (pred.external_)
-                        // TODO: No way to warn about this.
-                        continue;
-
-                    if (pred.key_.empty())
-                        continue;
-
-                    if (not settingLookup.contains(pred.key_))
-                        logger.warn("Button " + button.name_ + " has description with non-existent predicate " + pred.key_);
-                }
-            }
-        }
-    }
-    if (buttonEntries.empty()) {
-        logger.info("No buttons entries...");
-    }
-
-    Errors errors;
+    return assemble(data, hasSettings ? &settings : nullptr, logger);
+}
 
-    const auto errorsEntry{data.find("ERRORS")};
-    if (not errorsEntry or not errorsEntry.section()) {
-        logger.info("No errors section...");
-    } else {
-        errors = parseErrors(
-            errorsEntry.section()->entries_,
-            *logger.bdebug("Parsing errors...")
-        );
-    }
+std::optional<PropData> PropData::generate(
+    std::string_view source,
+    logging::Branch *lBranch
+) {
+    auto& logger{logging::Branch::optCreateLogger("versions::Prop::generate()", lBranch)};
 
-    std::optional<MenuSupport> menuSupport;
-    const auto menuSupportEntry{data.find("MENU_SUPPORT")};
-    if (menuSupportEntry and menuSupportEntry.section()) {
-        menuSupport = parseMenuSupport(
-            menuSupportEntry.section()->entries_,
-            *logger.bdebug("Parsing menu support...")
-        );
-    } else {
-        logger.info("No menu support section...");
+    pconf::Data rest;
+    PropReader reader{rest};
+    if (not pconf::parse(source, reader, logger.bverbose("Parsing..."))) {
+        logger.error("Failed to parse prop data.");
+        return std::nullopt;
     }
 
-    return std::make_optional<PropData>(
-        std::move(name),
-        std::move(filename),
-        std::move(info),
-        std::move(menuSupport),
-        std::move(settings),
-        std::move(buttons),
-        std::move(layout),
-        std::move(errors)
-    );
+    return assemble(pconf::hash(rest), reader.settings(), logger);
 }
 
 auto Prop::buttons(uint32 numButtons) const -> const Buttons * {
@@ -1027,81 +996,334 @@ std::vector<std::unique_ptr<Prop>> versions::props::forVersion(
 
 namespace {
 
-std::vector<std::unique_ptr<detail::Data>> parseSettings(
-    const pconf::Data& data, logging::Branch& lBranch
+std::optional<PropData> assemble(
+    const pconf::HashedData& data,
+    SettingsReader *settingsReader,
+    logging::Logger& logger
 ) {
-    auto& logger{lBranch.createLogger("PropFile::readSettings()")};
+    const auto nameEntry{data.find("NAME")};
+    if (not nameEntry or not nameEntry->value_) {
+        logger.error("Missing name.");
+        return std::nullopt;
+    }
+    auto name{*nameEntry->value_};
 
-    std::vector<std::unique_ptr<detail::Data>> ret;
-    const auto hashedData{pconf::hash(data)};
+    const auto filenameEntry{data.find("FILENAME")};
+    if (not filenameEntry or not filenameEntry->value_) {
+        logger.error("Missing filename.");
+        return std::nullopt;
+    }
+    auto filename{*filenameEntry->value_};
 
-    const auto parseDisables{[](
-        const pconf::HashedData& data
-    ) -> std::vector<std::string> {
-        const auto disableEntry{data.find("DISABLE")};
-        if (not disableEntry or not disableEntry->value_) return {};
+    std::string info;
+    const auto infoEntry{data.find("INFO")};
+    if (not infoEntry or not infoEntry->value_) {
+        logger.info("No info...");
+        info = "Prop has no additional info.";
+    } else {
+        info = *infoEntry->value_;
+    }
 
-        return pconf::valueAsList(disableEntry->value_);
-    }};
+    std::vector<std::unique_ptr<detail::Data>> settings;
+
+    if (not settingsReader) {
+        logger.info("No settings section...");
+    } else {
+        settings = settingsReader->finish(
+            *logger.bdebug("Parsing SETTINGS...")
+        );
+    }
+
+    Layout layout;
+
+    const auto layoutEntry{data.find("LAYOUT")};
+    if (not layoutEntry or not layoutEntry.isSection()) {
+        logger.info("No layout section...");
+    } else {
+        layout = parseLayout(
+            layoutEntry.section()->entries_,
+            *logger.bdebug("Parsing LAYOUT...")
+        );
+    }
 
-    const auto parseRec{[](const pconf::HashedData& data) {
-        std::vector<std::pair<std::string, std::string>> ret;
+    // Warn on duplicate and unused settings/those not in layout.
+    {
+        std::unordered_set<std::string> settingStrings;
+        for (auto& setting : settings) {
+            if (dynamic_cast<Option::SelectionData *>(setting.get()))
+                continue;
 
-        const auto setEntry{data.find("RECOMMENDS")};
-        if (auto sect{setEntry.section()}) {
-            for (auto& entry : sect->entries_)
-                ret.emplace_back(entry->name_, entry->value_.value_or(""));
+            auto [iter, inserted]{settingStrings.insert(setting->define_)};
+            if (not inserted) {
+                logger.warn("Duplicate settings for " + setting->define_);
+            }
         }
 
-        return ret;
-    }};
+        const auto processLayout{[&](auto self, const Layout& layout) -> void {
+            for (const auto& child : layout.children_) {
+                if (const auto *ptr{std::get_if<std::string>(&child)}) {
+                    settingStrings.erase(*ptr);
+                } else if (const auto *ptr{std::get_if<Layout>(&child)}) {
+                    self(self, *ptr);
+                }
+            }
+        }};
+        processLayout(processLayout, layout);
+
+        for (const auto& str : settingStrings) {
+            logger.warn("Unused setting " + str);
+        }
+    }
+
+    std::map<uint32, Buttons> buttons;
 
-    const auto toggleEntries{hashedData.findAll("TOGGLE")};
-    for (const auto& toggleEntry : toggleEntries) {
-        auto commonData{parseSettingCommon(
-            toggleEntry,
-            logger,
-            true,
-            true
-        )};
-        if (not commonData) continue;
-        auto& [settingData, entryMap]{*commonData};
+    const auto buttonEntries{data.findAll("BUTTONS")};
+    for (const auto& buttonEntry : buttonEntries) {
+        if (not buttonEntry.isSection()) {
+            logger.warn("Skipping non-section BUTTONS...");
+            continue;
+        }
+
+        if (not buttonEntry->labelNum_) {
+            logger.warn("Skipping BUTTONS w/o num label...");
+            continue;
+        }
+
+        const auto numButtons{*buttonEntry->labelNum_};
+        if (buttons.contains(numButtons)) {
+            logger.warn("Skipping duplicate BUTTONS{" + std::to_string(numButtons) + "}...");
+            continue;
+        }
+
+        buttons[numButtons] = parseButtons(
+            buttonEntry.section()->entries_,
+            buttons,
+            *logger.bdebug("Parsing BUTTONS " + std::to_string(numButtons) + "...")
+        );
+
+        // Build a temp lookup set
+        std::unordered_set<std::string> settingLookup;
+        for (auto& data : settings) {
+            settingLookup.insert(data->define_);
+
+            if (auto *ptr{dynamic_cast<OptionData *>(data.get())}) {
+                for (auto *selData : ptr->selections_)
+                    settingLookup.insert(selData->define_);
+            }
+        }
+
+        // Then check to warn if there's any non-existent predicates.
+        for (auto& state : buttons[numButtons]) {
+            for (auto& button : state.buttons_) {
+                for (auto& [pred, description] : button.descriptions_) {
+                    if (pred.external_)
+                        // TODO: No way to warn about this.
+                        continue;
+
+                    if (pred.key_.empty())
+                        continue;
+
+                    if (not settingLookup.contains(pred.key_))
+                        logger.warn("Button " + button.name_ + " has description with non-existent predicate " + pred.key_);
+                }
+            }
+        }
+    }
+    if (buttonEntries.empty()) {
+        logger.info("No buttons entries...");
+    }
+
+    Errors errors;
+
+    const auto errorsEntry{data.find("ERRORS")};
+    if (not errorsEntry or not errorsEntry.isSection()) {
+        logger.info("No errors section...");
+    } else {
+        errors = parseErrors(
+            errorsEntry.section()->entries_,
+            *logger.bdebug("Parsing errors...")
+        );
+    }
+
+    std::optional<MenuSupport> menuSupport;
+    const auto menuSupportEntry{data.find("MENU_SUPPORT")};
+    if (menuSupportEntry and menuSupportEntry.isSection()) {
+        menuSupport = parseMenuSupport(
+            menuSupportEntry.section()->entries_,
+            *logger.bdebug("Parsing menu support...")
+        );
+    } else {
+        logger.info("No menu support section...");
+    }
+
+    return std::make_optional<PropData>(
+        std::move(name),
+        std::move(filename),
+        std::move(info),
+        std::move(menuSupport),
+        std::move(settings),
+        std::move(buttons),
+        std::move(layout),
+        std::move(errors)
+    );
+}
+
+
+SettingsReader::Pending SettingsReader::pending(
+    const pconf::Event& event, bool isSection
+) {
+    Pending ret;
+    ret.type_ = event.name_;
+    if (event.label_) ret.label_.emplace(*event.label_);
+    ret.isSection_ = isSection;
+    return ret;
+}
+
+bool SettingsReader::record(Pending& setting, const pconf::Event& event) {
+    static constexpr std::array<std::string_view, NUM_KEYS> KEY_STRS{
+        "NAME",
+        "DESCRIPTION",
+        "REQUIRE",
+        "REQUIREANY",
+        "DISABLE",
+        "MIN",
+        "MAX",
+        "INCREMENT",
+        "DEFAULT",
+    };
+
+    for (size idx{0}; idx < NUM_KEYS; ++idx) {
+        if (event.name_ != KEY_STRS[idx]) continue;
+
+        auto& field{setting.fields_[idx]};
+        if (not field.seen_) {
+            field.seen_ = true;
+            if (event.value_) field.value_.emplace(*event.value_);
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+bool SettingsReader::onSectionBegin(const pconf::Event& event) {
+    if (mStack.empty()) {
+        std::vector<Pending> *bucket{nullptr};
+        if (event.name_ == "TOGGLE") bucket = &mToggles;
+        else if (event.name_ == "OPTION") bucket = &mOptions;
+        else if (event.name_ == "NUMERIC") bucket = &mNumerics;
+        else if (event.name_ == "DECIMAL") bucket = &mDecimals;
+
+        if (not bucket) {
+            mStack.emplace_back(Frame::Skip, nullptr);
+            return true;
+        }
+
+        bucket->push_back(pending(event, true));
+        mStack.emplace_back(Frame::Setting, &bucket->back());
+        return true;
+    }
+
+    auto [frame, setting]{mStack.back()};
+    switch (frame) {
+        case Frame::Skip:
+            break;
+        case Frame::Recommends:
+            setting->recommends_.emplace_back(event.name_, "");
+            break;
+        case Frame::Setting:
+            if (record(*setting, event)) break;
+
+            if (event.name_ == "RECOMMENDS" and not setting->recommendsSeen_) {
+                setting->recommendsSeen_ = true;
+                mStack.emplace_back(Frame::Recommends, setting);
+                return true;
+            }
+
+            if (event.name_ == "SELECTION" and setting->type_ == "OPTION") {
+                setting->selections_.push_back(pending(event, true));
+                mStack.emplace_back(Frame::Setting, &setting->selections_.back());
+                return true;
+            }
+            break;
+    }
+
+    mStack.emplace_back(Frame::Skip, nullptr);
+    return true;
+}
+
+bool SettingsReader::onEntry(const pconf::Event& event) {
+    if (mStack.empty()) {
+        if (event.name_ == "TOGGLE") mToggles.push_back(pending(event, false));
+        else if (event.name_ == "OPTION") mOptions.push_back(pending(event, false));
+        else if (event.name_ == "NUMERIC") mNumerics.push_back(pending(event, false));
+        else if (event.name_ == "DECIMAL") mDecimals.push_back(pending(event, false));
+        return true;
+    }
+
+    auto [frame, setting]{mStack.back()};
+    switch (frame) {
+        case Frame::Skip:
+            break;
+        case Frame::Recommends:
+            setting->recommends_.emplace_back(
+                event.name_, event.value_.value_or("")
+            );
+            break;
+        case Frame::Setting:
+            if (record(*setting, event)) break;
+
+            if (event.name_ == "RECOMMENDS") {
+                setting->recommendsSeen_ = true;
+            } else if (event.name_ == "SELECTION" and setting->type_ == "OPTION") {
+                setting->selections_.push_back(pending(event, false));
+            }
+            break;
+    }
+
+    return true;
+}
+
+bool SettingsReader::onSectionEnd() {
+    mStack.pop_back();
+    return true;
+}
+
+std::vector<std::unique_ptr<detail::Data>> SettingsReader::finish(
+    logging::Branch& lBranch
+) {
+    auto& logger{lBranch.createLogger("PropFile::readSettings()")};
+
+    std::vector<std::unique_ptr<detail::Data>> ret;
+
+    for (auto& toggle : mToggles) {
+        auto settingData{parseSettingCommon(toggle, logger, true, true)};
+        if (not settingData) continue;
 
         ret.push_back(std::make_unique<ToggleData>(
-            std::move(settingData),
-            parseDisables(entryMap),
-            parseRec(entryMap)
+            std::move(*settingData),
+            pconf::valueAsList(toggle.fields_[DISABLE].value_),
+            std::move(toggle.recommends_)
         ));
     }
 
-    const auto optionEntries{hashedData.findAll("OPTION")};
-    for (const auto& optionEntry : optionEntries) {
-        auto commonData{parseSettingCommon(
-            optionEntry,
-            logger,
-            true,
-            false
-        )};
-        if (not commonData) continue;
-        auto& [settingData, entryMap]{*commonData};
+    for (auto& option : mOptions) {
+        auto settingData{parseSettingCommon(option, logger, true, false)};
+        if (not settingData) continue;
 
         std::vector<OptionData::SelectionData *> selections;
 
-        const auto selectionEntries{entryMap.findAll("SELECTION")};
-        for (const auto& selectionEntry : selectionEntries) {
-            auto commonData{parseSettingCommon(
-                selectionEntry,
-                logger,
-                false,
-                true 
+        for (auto& selection : option.selections_) {
+            auto selSettingData{parseSettingCommon(
+                selection, logger, false, true
             )};
-            if (not commonData) continue;
-            auto& [settingData, entryMap]{*commonData};
+            if (not selSettingData) continue;
 
             auto selData{std::make_unique<Option::SelectionData>(
-                std::move(settingData),
-                parseDisables(entryMap),
-                parseRec(entryMap)
+                std::move(*selSettingData),
+                pconf::valueAsList(selection.fields_[DISABLE].value_),
+                std::move(selection.recommends_)
             )};
             selections.push_back(selData.get());
             ret.push_back(std::move(selData));
@@ -1109,198 +1331,179 @@ std::vector<std::unique_ptr<detail::Data>> parseSettings(
 
         if (selections.size() > 1) {
             ret.push_back(std::make_unique<OptionData>(
-                std::move(settingData),
+                std::move(*settingData),
                 std::move(selections)
             ));
         } else {
-            logger.warn("Option \"" + settingData.name_ + "\" doesn't have enough SELECTIONs, ignoring.");
+            logger.warn("Option \"" + settingData->name_ + "\" doesn't have enough SELECTIONs, ignoring.");
         }
     }
 
-    const auto numericEntries{hashedData.findAll("NUMERIC")};
-    for (const auto& numericEntry : numericEntries) {
-        auto commonData{parseSettingCommon(
-            numericEntry,
-            logger,
-            true,
-            true 
-        )};
-        if (not commonData)  continue;
-        auto& [settingData, entryMap]{*commonData};
+    const auto parseNumber{[&](
+        const Pending& setting, const std::string& name, Key key
+    ) -> std::optional<float64> {
+        const auto& field{setting.fields_[key]};
+        if (not field.value_) return std::nullopt;
+
+        auto val{utils::doStringMath(*field.value_)};
+        if (not val) {
+            std::string keyStr;
+            switch (key) {
+                case MIN: keyStr = "min"; break;
+                case MAX: keyStr = "max"; break;
+                case INCREMENT: keyStr = "increment"; break;
+                default: keyStr = "default"; break;
+            }
+            logger.warn("Could not parse " + name + ' ' + keyStr + '!');
+        }
+
+        return val;
+    }};
+
+    for (const auto& numeric : mNumerics) {
+        auto settingData{parseSettingCommon(numeric, logger, true, true)};
+        if (not settingData) continue;
 
         data::base::Integer::Params params;
         std::optional<int32> defaultVal;
 
-        const auto minEntry{entryMap.find("MIN")};
-        if (minEntry and minEntry->value_) {
-            auto val{utils::doStringMath(*minEntry->value_)};
-            if (val) params.min_ = static_cast<int32>(*val);
-            else logger.warn("Could not parse " + settingData.name_ + " min!");
+        const auto& name{settingData->name_};
+        if (auto val{parseNumber(numeric, name, MIN)}) {
+            params.min_ = static_cast<int32>(*val);
         }
-
-        const auto maxEntry{entryMap.find("MAX")};
-        if (maxEntry and maxEntry->value_) {
-            auto val{utils::doStringMath(*maxEntry->value_)};
-            if (val) params.max_ = static_cast<int32>(*val);
-            else logger.warn("Could not parse " + settingData.name_ + " max!");
+        if (auto val{parseNumber(numeric, name, MAX)}) {
+            params.max_ = static_cast<int32>(*val);
         }
-
-        const auto incrementEntry{entryMap.find("INCREMENT")};
-        if (incrementEntry and incrementEntry->value_) {
-            auto val{utils::doStringMath(*incrementEntry->value_)};
-            if (val) params.inc_ = static_cast<int32>(*val);
-            else logger.warn("Could not parse " + settingData.name_ + " increment!");
+        if (auto val{parseNumber(numeric, name, INCREMENT)}) {
+            params.inc_ = static_cast<int32>(*val);
         }
-
-        const auto defaultEntry{entryMap.find("DEFAULT")};
-        if (defaultEntry and defaultEntry->value_) {
-            auto val{utils::doStringMath(*defaultEntry->value_)};
-            if (val) defaultVal = static_cast<int32>(*val);
-            else logger.warn("Could not parse " + settingData.name_ + " default!");
+        if (auto val{parseNumber(numeric, name, DEFAULT)}) {
+            defaultVal = static_cast<int32>(*val);
         }
 
         if (params.min_ > params.max_) {
-            logger.warn("Setting " + settingData.name_ + " has a min value greater than max, this setting will be ignored!");
+            logger.warn("Setting " + name + " has a min value greater than max, this setting will be ignored!");
         } else {
             ret.emplace_back(std::make_unique<IntegerData>(
-                std::move(settingData),
+                std::move(*settingData),
                 params,
                 defaultVal
             ));
         }
     }
 
-    const auto decimalEntries{hashedData.findAll("DECIMAL")};
-    for (const auto& decimalEntry : decimalEntries) {
-        auto commonData{parseSettingCommon(
-            decimalEntry,
-            logger,
-            true,
-            true 
-        )};
-        if (not commonData)  continue;
-        auto& [settingData, entryMap]{*commonData};
+    for (const auto& decimal : mDecimals) {
+        auto settingData{parseSettingCommon(decimal, logger, true, true)};
+        if (not settingData) continue;
 
         data::base::Decimal::Params params;
         std::optional<float64> defaultVal;
 
-        const auto minEntry{entryMap.find("MIN")};
-        if (minEntry and minEntry->value_) {
-            auto val{utils::doStringMath(*minEntry->value_)};
-            if (val) params.min_ = *val;
-            else logger.warn("Could not parse " + settingData.name_ + " min!");
-        }
-
-        const auto maxEntry{entryMap.find("MAX")};
-        if (maxEntry and maxEntry->value_) {
-            auto val{utils::doStringMath(*maxEntry->value_)};
-            if (val) params.max_ = *val;
-            else logger.warn("Could not parse " + settingData.name_ + " max!");
-        }
-
-        const auto incrementEntry{entryMap.find("INCREMENT")};
-        if (incrementEntry and incrementEntry->value_) {
-            auto val{utils::doStringMath(*incrementEntry->value_)};
-            if (val) params.inc_ = *val;
-            else logger.warn("Could not parse " + settingData.name_ + " increment!");
-        }
-
-        const auto defaultEntry{entryMap.find("DEFAULT")};
-        if (defaultEntry and defaultEntry->value_) {
-            auto val{utils::doStringMath(*defaultEntry->value_)};
-            if (val) defaultVal = val;
-            else logger.warn("Could not parse " + settingData.name_ + " default!");
-        }
+        const auto& name{settingData->name_};
+        if (auto val{parseNumber(decimal, name, MIN)}) params.min_ = *val;
+        if (auto val{parseNumber(decimal, name, MAX)}) params.max_ = *val;
+        if (auto val{parseNumber(decimal, name, INCREMENT)}) params.inc_ = *val;
+        defaultVal = parseNumber(decimal, name, DEFAULT);
 
         if (params.min_ > params.max_) {
-            logger.warn("Setting " + settingData.name_ + " has a min value greater than max, this setting will be ignored!");
+            logger.warn("Setting " + name + " has a min value greater than max, this setting will be ignored!");
         } else {
             ret.emplace_back(std::make_unique<DecimalData>(
-                std::move(settingData),
+                std::move(*settingData),
                 params,
                 defaultVal
             ));
         }
     }
 
-    return std::move(ret);
+    return ret;
 }
 
-std::optional<std::pair<detail::Data, pconf::HashedData>> parseSettingCommon(
-    const pconf::EntryPtr& entry,
+std::optional<detail::Data> SettingsReader::parseSettingCommon(
+    const Pending& setting,
     logging::Logger& logger,
     bool requireLabel,
     bool requireName
 ) {
-    if (not entry->label_ and requireLabel) {
-        logger.warn(entry->name_ + " section has no label, ignoring!");
+    if (not setting.label_ and requireLabel) {
+        logger.warn(setting.type_ + " section has no label, ignoring!");
         return std::nullopt;
     }
 
-    if (not entry.section()) {
-        logger.warn(entry->name_ + " is not section, ignoring!");
+    if (not setting.isSection_) {
+        logger.warn(setting.type_ + " is not section, ignoring!");
         return std::nullopt;
     }
 
     std::string name;
 
-    auto data{pconf::hash(entry.section()->entries_)};
-    const auto nameEntry{data.find("NAME")};
-    if (not nameEntry or not nameEntry->value_) {
+    const auto& nameField{setting.fields_[NAME]};
+    if (not nameField.value_) {
         if (requireName) {
-            logger.warn(entry->name_ + " section does not have the required \"NAME\" entry, ignoring!");
+            logger.warn(setting.type_ + " section does not have the required \"NAME\" entry, ignoring!");
             return std::nullopt;
         }
     } else {
-        name = *nameEntry->value_;
+        name = *nameField.value_;
     }
-    if (nameEntry) data.erase(nameEntry);
 
-    std::string description;
+    const auto toRequires{[](const std::optional<std::string>& value) {
+        std::vector<Require> ret;
 
-    const auto descEntry{data.find("DESCRIPTION")};
-    if (descEntry and descEntry->value_) {
-        description = *descEntry->value_;
-        data.erase(descEntry);
-    }
+        auto rawVec{pconf::valueAsList(value)};
+        ret.reserve(rawVec.size());
+        for (auto& raw : rawVec)
+            ret.emplace_back(std::move(raw));
 
-    std::vector<Require> required;
+        return ret;
+    }};
 
-    const auto requiredEntry{data.find("REQUIRE")};
-    if (requiredEntry and requiredEntry->value_) {
-        auto rawVec{pconf::valueAsList(requiredEntry->value_)};
-        required.reserve(rawVec.size());
+    return detail::Data(
+        std::move(name),
+        // This is allowed to be nullopt here in some cases.
+        setting.label_.value_or(""),
+        setting.fields_[DESCRIPTION].value_.value_or(""),
+        toRequires(setting.fields_[REQUIRE].value_),
+        toRequires(setting.fields_[REQUIREANY].value_)
+    );
+}
 
-        for (auto& raw : rawVec)
-            required.emplace_back(std::move(raw));
+bool PropReader::onSectionBegin(const pconf::Event& event) {
+    if (mSettingsDepth) {
+        ++mSettingsDepth;
+        return mSettings.onSectionBegin(event);
+    }
 
-        data.erase(requiredEntry);
+    if (mDepth == 0 and event.name_ == "SETTINGS" and not mSettingsSeen) {
+        mSettingsSeen = true;
+        mSettingsSection = true;
+        mSettingsDepth = 1;
+        return true;
     }
 
-    std::vector<Require> requireAny;
+    ++mDepth;
+    return mRest.onSectionBegin(event);
+}
 
-    const auto requireAnyEntry{data.find("REQUIREANY")};
-    if (requireAnyEntry and requireAnyEntry->value_) {
-        auto rawVec{pconf::valueAsList(requireAnyEntry->value_)};
-        requireAny.reserve(rawVec.size());
+bool PropReader::onEntry(const pconf::Event& event) {
+    if (mSettingsDepth) return mSettings.onEntry(event);
 
-        for (auto& raw : rawVec)
-            requireAny.emplace_back(std::move(raw));
+    if (mDepth == 0 and event.name_ == "SETTINGS" and not mSettingsSeen) {
+        mSettingsSeen = true;
+        return true;
+    }
 
-        data.erase(requireAnyEntry);
+    return mRest.onEntry(event);
+}
+
+bool PropReader::onSectionEnd() {
+    if (mSettingsDepth) {
+        --mSettingsDepth;
+        return mSettingsDepth ? mSettings.onSectionEnd() : true;
     }
 
-    return std::pair{
-        detail::Data(
-            std::move(name),
-            // This is allowed to be nullopt here in some cases.
-            entry->label_.value_or(""),
-            std::move(description),
-            std::move(required),
-            std::move(requireAny)
-        ),
-        data
-    };
+    --mDepth;
+    return mRest.onSectionEnd();
 }
 
 Layout parseLayout(
@@ -1358,7 +1561,7 @@ Layout parseLayout(
             continue;
         }
 
-        if (not entry.section()) {
+        if (not entry.isSection()) {
             logger.warn("Skipping non-section " + entry->name_ + " in layout...");
             continue;
         }
@@ -1386,7 +1589,6 @@ Buttons parseButtons(
     logging::Branch& lBranch
 ) {
     auto& logger{lBranch.createLogger("Versions::parseButtons()")};
-    const auto hashedData{pconf::hash(data)};
 
     Buttons ret{};
     const Buttons *inherit{nullptr};
@@ -1428,7 +1630,7 @@ Buttons parseButtons(
             continue;
         }
 
-        if (not stateEntry.section()) {
+        if (not stateEntry.isSection()) {
             logger.warn("Skipping non-section buttons state...");
             continue;
         }
@@ -1446,7 +1648,7 @@ Buttons parseButtons(
                 continue;
             }
 
-            if (not buttonEntry.section()) {
+            if (not buttonEntry.isSection()) {
                 logger.warn("Skipping non-section button...");
                 continue;
             }
@@ -1560,7 +1762,7 @@ Errors parseErrors(const pconf::Data& data, logging::Branch& lBranch) {
             continue;
         }
 
-        if (not mapEntry.section()) {
+        if (not mapEntry.isSection()) {
             logger.warn("Skipping non-section MAP in errors...");
             continue;
         }
@@ -22,7 +22,9 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <set>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -264,6 +266,14 @@ struct VERSIONS_EXPORT PropData {
         const pconf::HashedData& data,
         logging::Branch *lBranch
     );
+    /**
+     * Generate directly from data.pconf contents, without building the
+     * SETTINGS tree.
+     */
+    static std::optional<PropData> generate(
+        std::string_view source,
+        logging::Branch *lBranch
+    );
 
     std::string name_;
     std::string filename_;
@@ -33,8 +33,10 @@
 #include "data/context.hpp"
 #include "log/context.hpp"
 #include "log/logger.hpp"
-#include "pconf/utils.hpp"
+#include "pconf/document.hpp"
+#include "pconf/parse.hpp"
 #include "pconf/read.hpp"
+#include "pconf/utils.hpp"
 #include "pconf/write.hpp"
 #include "utils/files.hpp"
 #include "utils/paths.hpp"
@@ -43,6 +45,7 @@
 #include "versions/detail/boards.hpp"
 #include "versions/detail/strings.hpp"
 #include "versions/os.hpp"
+#include "versions/priv/cache.hpp"
 #include "versions/priv/data.hpp"
 #include "versions/prop.hpp"
 
@@ -91,16 +94,13 @@ void versions::loadLocal(logging::Branch *lBranch) {
 
         logger.info("Found ProffieOS version " + static_cast<std::string>(version) + "...");
 
-        auto infoFile{files::openInput(entry.path() / detail::INFO_FILE_STR)};
-        pconf::Data infoData;
-        if (not pconf::read(infoFile, infoData, logger.bverbose("Reading info file..."))) {
+        pconf::Document infoDoc;
+        if (not pconf::read(entry.path() / detail::INFO_FILE_STR, infoDoc, logger.bverbose("Reading info file..."))) {
             logger.error("Could not read info pconf.");
             continue;
         }
 
-        const auto hashedInfoData{pconf::hash(infoData)};
-
-        const auto coreVersionEntry{hashedInfoData.find(detail::CORE_VER_STR)};
+        const auto *coreVersionEntry{infoDoc.find(detail::CORE_VER_STR)};
         if (not coreVersionEntry or not coreVersionEntry->value_) {
             logger.error("Missing core version entry.");
             continue;
@@ -112,17 +112,17 @@ void versions::loadLocal(logging::Branch *lBranch) {
             continue;
         }
 
-        const auto coreURLEntry{hashedInfoData.find(detail::CORE_URL_STR)};
+        const auto *coreURLEntry{infoDoc.find(detail::CORE_URL_STR)};
         if (not coreURLEntry or not coreURLEntry->value_) {
             logger.error("Missing core url entry.");
             continue;
         } 
 
-        auto& coreURL{*coreURLEntry->value_};
+        std::string coreURL{*coreURLEntry->value_};
 
         os::OS::BoardsMap boards;
-        const auto boardEntries{hashedInfoData.findAll(detail::BOARD_STR)};
-        for (const auto& boardEntry : boardEntries) {
+        const auto boardEntries{infoDoc.findAll(detail::BOARD_STR)};
+        for (const auto *boardEntry : boardEntries) {
             std::string include;
             std::string coreId;
 
@@ -142,22 +142,20 @@ void versions::loadLocal(logging::Branch *lBranch) {
                 continue;
             }
 
-            if (auto boardSection{boardEntry.section()}) {
-                const auto boardVars{pconf::hash(boardSection->entries_)};
-
-                auto coreIdEntry{boardVars.find(detail::CORE_ID_STR)};
+            if (boardEntry->isSection()) {
+                const auto *coreIdEntry{boardEntry->find(detail::CORE_ID_STR)};
                 if (coreIdEntry and coreIdEntry->value_) {
                     coreId = *coreIdEntry->value_;
                 }
 
-                auto includeEntry{boardVars.find(detail::INCLUDE_STR)};
+                const auto *includeEntry{boardEntry->find(detail::INCLUDE_STR)};
                 if (includeEntry and includeEntry->value_) {
                     include = *includeEntry->value_;
                 }
             }
 
             boards.emplace(*knownBoard, os::Board{
-                .name_=std::move(*boardEntry->label_),
+                .name_=std::string{*boardEntry->label_},
                 .coreId_=std::move(coreId),
                 .include_=std::move(include)
             });
@@ -200,19 +198,18 @@ void versions::loadLocal(logging::Branch *lBranch) {
 
         logger.info("Found prop " + propName + "...");
 
-        auto infoFile{files::openInput(
-            paths::propDir() / propName / detail::INFO_FILE_STR
-        )};
-        pconf::Data infoData;
-        if (not pconf::read(infoFile, infoData, logger.bverbose("Reading info file..."))) {
+        pconf::Document infoDoc;
+        if (not pconf::read(
+                paths::propDir() / propName / detail::INFO_FILE_STR,
+                infoDoc,
+                logger.bverbose("Reading info file...")
+            )) {
             logger.error("Could not read info pconf.");
             continue;
         }
 
-        const auto hashedInfoData{pconf::hash(infoData)};
-
-        const auto supportedVersionsEntry{
-            hashedInfoData.find(detail::SUPPORTED_VERSIONS_STR)
+        const auto *supportedVersionsEntry{
+            infoDoc.find(detail::SUPPORTED_VERSIONS_STR)
         };
         if (not supportedVersionsEntry) {
             logger.error("Prop missing supported versions.");
@@ -235,20 +232,38 @@ void versions::loadLocal(logging::Branch *lBranch) {
             versions.push_back(std::move(version));
         }
 
-        // Yeah this naming is stupid, what are you going to do about it?
-        auto dataFile{files::openInput(
-            paths::propDir() / propName / detail::DATA_FILE_STR
-        )};
-        pconf::Data dataData;
-        if (not pconf::read(dataFile, dataData, logger.bverbose("Reading data file..."))) {
-            logger.error("Cannot read data file for " + propName);
-            continue;
-        }
-        const auto hashedDataData{pconf::hash(dataData)};
+        const auto dataPath{paths::propDir() / propName / detail::DATA_FILE_STR};
 
-        auto prop{props::PropData::generate(
-            hashedDataData, logger.bverbose("Generating prop...")
-        )};
+        auto prop{[&]() -> std::optional<props::PropData> {
+            auto cached{priv::loadPropCache(
+                dataPath, logger.bverbose("Loading cached data...")
+            )};
+            if (cached) return cached;
+
+            std::unique_ptr<char[]> dataBuffer;
+            size dataLength{};
+            if (not pconf::readFile(
+                    dataPath,
+                    dataBuffer,
+                    dataLength,
+                    logger.bverbose("Reading data file...")
+                )) {
+                logger.error("Cannot read data file for " + propName);
+                return std::nullopt;
+            }
+
+            const std::string_view dataSource{dataBuffer.get(), dataLength};
+            auto ret{props::PropData::generate(
+                dataSource, logger.bverbose("Generating prop...")
+            )};
+            if (ret) {
+                priv::savePropCache(
+                    dataPath, dataSource, *ret, logger.bverbose("Caching data...")
+                );
+            }
+
+            return ret;
+        }()};
         if (not prop) {
             logger.error("Failed generating prop " + propName);
             continue;
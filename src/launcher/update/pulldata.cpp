@@ -21,6 +21,7 @@
 
 #include <fstream>
 #include <future>
+#include <span>
 #include <thread>
 #include <unordered_set>
 
@@ -261,7 +262,7 @@ bool checkMessages(
     bool hadFatal{false};
     const auto messageEntries{hashedRawData.findAll("MESSAGE")};
     for (const auto& messageEntry : messageEntries) {
-        if (not messageEntry.section()) {
+        if (not messageEntry.isSection()) {
             logger.warn("Message entry found in pconf! (Not a section)");
             continue;
         }
@@ -377,7 +378,7 @@ std::map<Update::ItemID, Update::Item> findItems(
     std::map<Update::ItemID, Update::Item> ret;
 
     auto findType{[&logger, &ret](
-        const std::vector<pconf::EntryPtr>& entries,
+        std::span<const pconf::EntryPtr> entries,
         Update::ItemType type,
         const std::string& typeStr
     ) {
@@ -412,20 +413,20 @@ std::optional<std::pair<std::string, Update::Item>> parseItem(
 
     auto name{*entry->label_};
 
-    if (not entry.section()) {
+    if (not entry.isSection()) {
         logger.warn("Item \"" + name + "\" not a section!");
         return std::nullopt;
     }
 
 #   ifdef _WIN32
-    constexpr cstring PATH_KEY{"PATH_Win32"};
-    constexpr cstring HASH_KEY{"HASH_Win32"};
+    static const pconf::Symbol PATH_KEY{"PATH_Win32"};
+    static const pconf::Symbol HASH_KEY{"HASH_Win32"};
 #   elif defined(__APPLE__)
-    constexpr cstring PATH_KEY{"PATH_macOS"};
-    constexpr cstring HASH_KEY{"HASH_macOS"};
+    static const pconf::Symbol PATH_KEY{"PATH_macOS"};
+    static const pconf::Symbol HASH_KEY{"HASH_macOS"};
 #   elif defined(__linux__)
-    constexpr cstring PATH_KEY{"PATH_Linux"};
-    constexpr cstring HASH_KEY{"HASH_Linux"};
+    static const pconf::Symbol PATH_KEY{"PATH_Linux"};
+    static const pconf::Symbol HASH_KEY{"HASH_Linux"};
 #   endif
 
     auto hashedEntries{pconf::hash(entry.section()->entries_)};
@@ -445,7 +446,7 @@ std::optional<std::pair<std::string, Update::Item>> parseItem(
             logger.warn("Item \"" + name + "\" version unlabeled.");
             continue;
         }
-        if (not versionEntry.section()) {
+        if (not versionEntry.isSection()) {
             logger.warn("Item \"" + name + "\" version not a section.");
             continue;
         }
@@ -559,7 +560,7 @@ Update::Bundles resolveBundles(
             logger.warn("Bundle unlabeled.");
             continue;
         }
-        if (not bundleEntry.section()) {
+        if (not bundleEntry.isSection()) {
             logger.warn("Bundle \"" + bundleEntry->label_.value() + "\" not a section.");
             continue;
         }
@@ -601,7 +602,7 @@ Update::Bundles resolveBundles(
         }};
 
         auto fillReqFiles{[&](
-            const std::vector<pconf::EntryPtr>& entries, Update::ItemType type
+            std::span<const pconf::EntryPtr> entries, Update::ItemType type
         ) {
             for (const auto& entry : entries) {
                 auto parsed{parseReqItem(entry)};
@@ -54,6 +54,14 @@ constexpr auto NUM_ENUM_PREFS{static_cast<size>(state::prefs::Enum::Max)};
 
 std::bitset<NUM_BOOL_PREFS> boolPrefs;
 
+// Serialized state file, so that saving only re-serializes what changed.
+pconf::Writer stateWriter;
+
+// Prefs changed since the last saveState(). Everything starts dirty.
+std::bitset<NUM_BOOL_PREFS> dirtyBoolPrefs{~0ULL};
+std::bitset<NUM_STR_PREFS> dirtyStrPrefs{~0ULL};
+std::bitset<NUM_ENUM_PREFS> dirtyEnumPrefs{~0ULL};
+
 // Helpers to provide names and have no default dtor to avoid errors when
 // updating/adding preferences.
 struct BoolPrefStrings {
@@ -146,6 +154,7 @@ bool state::prefs::get(Bool pref) {
 void state::prefs::set(Bool pref, bool set) {
     assert(pref < Bool::Max);
     boolPrefs[static_cast<size>(pref)] = set;
+    dirtyBoolPrefs[static_cast<size>(pref)] = true;
 }
 
 std::string state::prefs::get(Str pref) {
@@ -156,6 +165,7 @@ std::string state::prefs::get(Str pref) {
 void state::prefs::set(Str pref, std::string s) {
     assert(pref < Str::Max);
     strPrefs[static_cast<size>(pref)] = std::move(s);
+    dirtyStrPrefs[static_cast<size>(pref)] = true;
 }
 
 size state::prefs::priv::get(Enum pref) {
@@ -166,58 +176,60 @@ size state::prefs::priv::get(Enum pref) {
 void state::prefs::priv::set(Enum pref, size e) {
     assert(pref < Enum::Max);
     enumPrefs[static_cast<size>(pref)] = e;
+    dirtyEnumPrefs[static_cast<size>(pref)] = true;
 }
 
 void state::saveState() {
     auto& logger{logging::Context::getGlobal().createLogger("state::saveState()")};
 
-    auto stateStream{files::openOutput(paths::stateFile() += ".tmp")};
-    if (stateStream.fail()) {
-        logger.error("Failed creating temporary save file.");
-        stateStream.close();
-        return;
-    }
-
-    pconf::Data data;
-    
-    data.push_back(pconf::Entry::create(
-        LAST_VERSION_STR, wxSTRINGIZE(BIN_VERSION)
-    ));
+    // These aren't tracked, but the writer won't touch the image if they're
+    // unchanged.
+    stateWriter.set(LAST_VERSION_STR, wxSTRINGIZE(BIN_VERSION));
 
     if (not manifestChannel.empty()) {
-        data.push_back(pconf::Entry::create(
-            UPDATE_MANIFEST_STR, manifestChannel
-        ));
+        stateWriter.set(UPDATE_MANIFEST_STR, manifestChannel);
+    } else {
+        stateWriter.erase(UPDATE_MANIFEST_STR);
     }
 
     if (doneWithFirstRun) {
-        data.push_back(pconf::Entry::create(FIRSTRUN_COMPLETE_STR));
+        stateWriter.set(FIRSTRUN_COMPLETE_STR);
+    } else {
+        stateWriter.erase(FIRSTRUN_COMPLETE_STR);
     }
 
     for (size idx{0}; idx < NUM_BOOL_PREFS; ++idx) {
-        if (boolPrefs[idx])
-            data.push_back(pconf::Entry::create(BOOL_PREF_STRS[idx].key_));
+        if (not dirtyBoolPrefs[idx]) continue;
+
+        if (boolPrefs[idx]) {
+            stateWriter.set(BOOL_PREF_STRS[idx].key_);
+        } else {
+            stateWriter.erase(BOOL_PREF_STRS[idx].key_);
+        }
     }
 
     for (size idx{0}; idx < NUM_STR_PREFS; ++idx) {
-        cstring key{STR_PREF_STRS[idx].key_};
-        data.push_back(pconf::Entry::create(key, strPrefs[idx]));
+        if (not dirtyStrPrefs[idx]) continue;
+
+        stateWriter.set(STR_PREF_STRS[idx].key_, strPrefs[idx]);
     }
 
     for (size idx{0}; idx < NUM_ENUM_PREFS; ++idx) {
-        cstring key{ENUM_PREF_STRS[idx].key_};
-        cstring val{ENUM_PREF_STRS[idx].values_[enumPrefs[idx]]};
-        data.push_back(pconf::Entry::create(key, val));
+        if (not dirtyEnumPrefs[idx]) continue;
+
+        stateWriter.set(
+            ENUM_PREF_STRS[idx].key_,
+            ENUM_PREF_STRS[idx].values_[enumPrefs[idx]]
+        );
     }
 
-    pconf::write(stateStream, data, logger.bdebug("Writing save file..."));
-    stateStream.close();
+    dirtyBoolPrefs.reset();
+    dirtyStrPrefs.reset();
+    dirtyEnumPrefs.reset();
 
-    std::error_code err;
-    fs::remove(paths::stateFile(), err); // we don't care if it fails bc there's nothing there
-    err.clear();
-    fs::rename(paths::stateFile() += ".tmp", paths::stateFile(), err);
-    if (err.value() != 0) {
+    if (not stateWriter.save(
+            paths::stateFile(), logger.bdebug("Writing save file...")
+        )) {
         logger.error("Failed saving state file.");
         return;
     }
@@ -162,6 +162,25 @@ pcui::DescriptorPtr GeneralPage::setup() {
           .label_=_("Enable WebUSB"),
           .data_=mConfig.settings_.webUsb_,
         }(),
+        pcui::Spacer{.size_=pcui::interGroupSpacing()}(),
+        pcui::Stack{
+          .base_={.align_=wxALIGN_CENTER},
+          .orient_=wxHORIZONTAL,
+          .children_={
+            pcui::CheckBox{
+              .win_={
+                .base_={.align_=wxALIGN_CENTER},
+                .tooltip_=_("Output preset styles used more than this many times once, as a style alias.\nShrinks the config file, and often the compiled size."),
+              },
+              .label_=_("Deduplicate Styles"),
+              .data_=mConfig.settings_.dedupStyles_.enable_,
+            }(),
+            pcui::Spacer{.size_=pcui::interControlSpacing()}(),
+            pcui::Stepper{
+              .data_=mConfig.settings_.dedupStyles_.threshold_,
+            }(),
+          }
+        }(),
       }
     }();
 }
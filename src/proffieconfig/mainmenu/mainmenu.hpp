@@ -20,6 +20,7 @@
  */
 
 #include <map>
+#include <set>
 
 #include "config/config.hpp"
 #include "data/primitive/models/choice.hpp"
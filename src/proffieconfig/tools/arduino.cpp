@@ -23,6 +23,7 @@
 #include <cstring>
 #include <filesystem>
 #include <optional>
+#include <unordered_map>
 #include <unordered_set>
 #include <variant>
 
@@ -55,6 +56,7 @@
 #include "log/logger.hpp"
 #include "log/branch.hpp"
 #include "process/process.hpp"
+#include "sketch/sketch.hpp"
 #include "ui/dialogs/progress.hpp"
 #include "utils/files.hpp"
 #include "utils/paths.hpp"
@@ -107,6 +109,43 @@ std::optional<wxString> ensureCoreInstalled(
 
 std::string dfuSuffixPath;
 
+/**
+ * Flash used by the last compile of each config with style deduplication
+ * off and on, to report what the option saves.
+ *
+ * Both are only kept for as long as the rest of the config is the same.
+ */
+struct FlashUse {
+    uint64 contentHash_{0};
+    int32 dedupOff_{-1};
+    int32 dedupOn_{-1};
+};
+std::unordered_map<std::string, FlashUse> flashUse;
+
+/**
+ * @return Hash of everything in the config but the style dedup settings
+ */
+uint64 flashUseHash(const config::Config& config) {
+    const auto& settings{config.settings_};
+
+    uint64 ret{0};
+    for (const auto *child : config.children()) {
+        if (child == &settings) continue;
+        ret = child->hash(ret);
+    }
+    for (const auto *child : settings.children()) {
+        if (
+                child == &settings.dedupStyles_.enable_ or
+                child == &settings.dedupStyles_.threshold_
+           ) {
+            continue;
+        }
+        ret = child->hash(ret);
+    }
+
+    return ret;
+}
+
 constexpr auto MAX_ERRMESSAGE_LENGTH{1024};
 constexpr cstring ARDUINOCORE_PBV1{"proffieboard:stm32l4:Proffieboard-L433CC"};
 constexpr cstring ARDUINOCORE_PBV2{"proffieboard:stm32l4:ProffieboardV2-L433CC"};
@@ -372,66 +411,13 @@ std::variant<arduino::CompileOutput, wxString> compile(
         paths::osDir() / config.os()->version_.string() / "ProffieOS"
     };
 
-    if (const auto *prop{config.prop()}) {
-        constexpr cstring PROPINST_MSG{wxTRANSLATE("Installing Prop File...")};
-        prog.set(20, wxGetTranslation(PROPINST_MSG));
-        logger.info(PROPINST_MSG);
-
-        std::error_code err;
-        const auto sourcePropHeader{
-            paths::propDir() / prop->installName_ / versions::detail::HEADER_FILE_STR
-        };
-
-        if (not prop->filename_.empty()) {
-            if (not fs::exists(sourcePropHeader, err)) {
-                logger.error("Prop doesn't have a header.");
-                return _("Invalid Prop Selected");
-            }
-
-            const auto propHeaderDest{osPath / "props" / prop->filename_};
-            auto res{files::copyOverwrite(
-                sourcePropHeader, propHeaderDest, err
-            )};
-
-            if (not res) {
-                logger.error("Failed to copy in prop header.");
-                return _("OS FS Error");
-            }
-        }
-    }
-
-    const auto injectionsDest{osPath / "config" / config::priv::INJECTION_STR};
-    auto injectionVec{data::context(config.injections_)};
-
-    if (not injectionVec.children().empty()) {
-        constexpr cstring PROPINST_MSG{wxTRANSLATE("Installing Injection Files...")};
-        prog.set(25, wxGetTranslation(PROPINST_MSG));
-
-        std::error_code ec;
-        fs::create_directories(injectionsDest, ec);
-        if (ec) {
-            logger.error("Failed to create injections dir: " + ec.message());
-            return _("OS FS Error");
-        }
+    constexpr cstring DEPS_MESSAGE{wxTRANSLATE("Installing Prop and Injection Files...")};
+    prog.set(20, wxGetTranslation(DEPS_MESSAGE));
+    if (auto depErr{sketch::installDeps(config, osPath, *logger.binfo(DEPS_MESSAGE))}) {
+        return wxGetTranslation(*depErr);
     }
 
-    for (const auto& model : injectionVec.children()) {
-        auto& injection{dynamic_cast<config::Injection&>(*model)};
-
-        const auto srcPath{paths::injectionDir() / injection.filename_};
-        const auto dstPath{injectionsDest / injection.filename_};
-
-        std::error_code err;
-        if (not files::copyOverwrite(srcPath, dstPath, err)) {
-            logger.error("Failed to copy injection file \"" + srcPath.string() + "\" to \"" + dstPath.string() + "\": " + err.message());
-            return _("OS FS Error");
-        }
-    }
-
-    // Use a prefix on the name, "ProffieConfig" so that the core config
-    // headers can't be overwritten. I could check for this elsewhere, but it's
-    // a lot easier to just prevent it this way.
-    const auto outName{"ProffieConfig " + name + ".h"};
+    const auto outName{sketch::configFileName(name)};
     const auto configPath{osPath / "config" / outName};
 
     constexpr cstring GENERATE_MESSAGE{wxTRANSLATE("Generating configuration file...")};
@@ -441,97 +427,17 @@ std::variant<arduino::CompileOutput, wxString> compile(
 
     constexpr cstring UPDATE_INO_MESSAGE{wxTRANSLATE("Updating ProffieOS file...")};
     prog.set(35, wxGetTranslation(UPDATE_INO_MESSAGE));
-    logger.info(UPDATE_INO_MESSAGE);
-
-    const auto inoPath{osPath / "ProffieOS.ino"};
-    const auto tmpInoPath{fs::temp_directory_path() / "ProffieOS.ino"};
-    auto ino{files::openInput(inoPath)};
-    if (ino.fail()) {
-        logger.error("Failed to open ProffieOS INO");
-        return _("OS Inaccessible or Corrupted");
-    }
-
-    auto tmpIno{files::openOutput(tmpInoPath)};
-    if (tmpIno.fail()) {
-        logger.error("Failed to open tmp ProffieOS INO");
-        return _("Computer FS Error");
-    }
-
-    bool alreadyOutputConfigDefine{false};
-    while (ino.good()) {
-        std::string buffer;
-        std::getline(ino, buffer);
-
-
-        // This one doesn't need to be replaced, but I've been doing it for
-        // a while now, no real reason to stop I guess.
-        constexpr cstring COMMENTED_LINE{
-            R"(// #define CONFIG_FILE "config/YOUR_CONFIG_FILE_NAME_HERE.h")"
-        };
-        constexpr cstring UNCOMMENTED_LINE{
-            R"(#define CONFIG_FILE)"
-        };
-
-        if (
-                buffer.starts_with(COMMENTED_LINE) or
-                buffer.starts_with(UNCOMMENTED_LINE)
-           ) {
-            if (not alreadyOutputConfigDefine) {
-                tmpIno << "#define CONFIG_FILE \"config/";
-                tmpIno << outName << "\"\n";
-                alreadyOutputConfigDefine = true;
-            }
-        } else if (buffer.starts_with(R"(const char version[] = ")")) {
-            tmpIno << R"(const char version[] = ")";
-            tmpIno << config.os()->version_.string() << "\";\n";
-        } else {
-            tmpIno << buffer << '\n';
-        }
-    }
-    ino.close();
-    tmpIno.close();
-
-    std::error_code errCode;
-    if (not files::copyOverwrite(tmpInoPath, inoPath, errCode)) {
-        logger.error("Failed to copy in tmp ProffieOS INO: " + errCode.message());
-        return _("Computer FS Error");
-    }
+    auto inoErr{sketch::updateIno(
+        osPath, outName, config, *logger.binfo(UPDATE_INO_MESSAGE)
+    )};
+    if (inoErr) return wxGetTranslation(*inoErr);
 
     constexpr cstring COMPILE_MESSAGE{wxTRANSLATE("Compiling ProffieOS...")};
     prog.set(40, wxGetTranslation(COMPILE_MESSAGE));
     logger.info(COMPILE_MESSAGE);
 
-    wxString output;
-    std::array<char, 32> buffer;
-
     Process proc;
-    std::vector<std::string> args{
-        "compile",
-        "-b",
-    };
-
-    const auto& board{*config.board()};
-
-    args.push_back(board.coreId_);
-    args.emplace_back("--board-options");
-
-    std::string options;
-    auto massStorage{data::context(config.settings_.massStorage_)};
-    auto webUSB{data::context(config.settings_.webUsb_)};
-
-    if (massStorage.val() and webUSB.val()) options = "usb=cdc_msc_webusb";
-    else if (webUSB.val()) options = "usb=cdc_webusb";
-    else if (massStorage.val()) options = "usb=cdc_msc";
-    else options = "usb=cdc";
-
-    using versions::detail::BOARDS;
-    using enum versions::detail::BoardIdx;
-    if (board.name_ == BOARDS[eBoard_Proffie_V3].name_) {
-        options +=",dosfs=sdmmc1";
-    }
-
-    args.push_back(std::move(options));
-    args.push_back(osPath.string());
+    auto args{sketch::compileArgs(config, osPath)};
     args.emplace_back("-v");
     cli(proc, args);
 
@@ -646,26 +552,31 @@ std::variant<arduino::CompileOutput, wxString> compile(
         return wxGetTranslation(UTIL_ERR);
     }
 
-    // Set to negatives to mark missing
-    ret.used_ = -1;
-    ret.total_ = -1;
-
-    constexpr std::string_view USED_PREFIX{"Sketch uses "};
-    constexpr std::string_view MAX_PREFIX{"Maximum is "};
-    const auto usedPrefixPos{compileOutput.find(USED_PREFIX)};
-    const auto maxPrefixPos{compileOutput.find(MAX_PREFIX)};
-    if (
-            usedPrefixPos != std::string::npos and
-            maxPrefixPos != std::string::npos
-       ) {
-        const auto usedPos{usedPrefixPos + USED_PREFIX.length()};
-        const auto maxPos{maxPrefixPos + MAX_PREFIX.length()};
-
-        const auto used{strtoul(&compileOutput[usedPos], nullptr, 10)};
-        const auto total{strtoul(&compileOutput[maxPos], nullptr, 10)};
+    const auto usage{sketch::parseUsage(compileOutput)};
+    ret.used_ = usage.used_;
+    ret.total_ = usage.total_;
+    if (ret.used_ >= 0 and ret.total_ >= 0) {
+        const auto dedup{
+            data::context(config.settings_.dedupStyles_.enable_).val()
+        };
+        auto& use{flashUse[name]};
+        const auto contentHash{flashUseHash(config)};
+        if (use.contentHash_ != contentHash) {
+            use = {.contentHash_=contentHash};
+        }
+        (dedup ? use.dedupOn_ : use.dedupOff_) = ret.used_;
 
-        ret.used_ = static_cast<int32>(used);
-        ret.total_ = static_cast<int32>(total);
+        std::string msg{
+            "Flash used: " + std::to_string(ret.used_) +
+            " with style dedup " + (dedup ? "on" : "off")
+        };
+        if (use.dedupOn_ >= 0 and use.dedupOff_ >= 0) {
+            const auto delta{use.dedupOn_ - use.dedupOff_};
+            msg += ", dedup on uses ";
+            msg += (delta > 0 ? "+" : "") + std::to_string(delta);
+            msg += " bytes vs. off";
+        }
+        logger.info(msg);
     } else {
         logger.warn("Usage data not found in compilation output.");
     }
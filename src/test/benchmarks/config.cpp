@@ -0,0 +1,511 @@
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2026 Ryan Ogurek
+ *
+ * test/benchmarks/config.cpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "config/config.hpp"
+#include "config/presets/array.hpp"
+#include "config/presets/preset.hpp"
+#include "config/presets/style.hpp"
+#include "config/priv/io.hpp"
+#include "config/priv/parse/lexer.hpp"
+#include "config/styles/style.hpp"
+#include "config/synth.hpp"
+#include "data/context.hpp"
+#include "utils/files.hpp"
+#include "utils/string.hpp"
+#include "utils/timing.hpp"
+
+namespace {
+
+const fs::path CONFIG_DIR{CONFIG_DIR_STR};
+
+std::vector<std::string> configs() {
+    std::vector<std::string> ret;
+    for (const auto& entry : fs::directory_iterator(CONFIG_DIR)) {
+        if (entry.path().extension() != ".h") continue;
+
+        auto file{files::openInput(entry.path())};
+        std::ostringstream content;
+        content << file.rdbuf();
+        ret.push_back(std::move(content).str());
+    }
+
+    return ret;
+}
+
+/**
+ * The loop every section parser is built on: skip comments, take a char.
+ */
+size scanStream(const std::string& buf) {
+    std::istringstream stream(buf);
+
+    size ret{0};
+    while (stream.good()) {
+        utils::CommentData commentData{.stream_=stream};
+        (void)utils::extractComments(commentData);
+        ret += commentData.out_.size();
+
+        const auto chr{stream.get()};
+        if (not stream.good()) break;
+
+        ret += static_cast<size>(chr);
+    }
+
+    return ret;
+}
+
+size scanLexer(std::string_view buf) {
+    config::priv::parse::Lexer lexer{buf};
+
+    size ret{0};
+    while (lexer.good()) {
+        config::priv::parse::Lexer::Comments commentData;
+        (void)lexer.extractComments(commentData);
+        ret += commentData.out_.size();
+
+        const auto chr{lexer.get()};
+        if (not lexer.good()) break;
+
+        ret += static_cast<size>(chr);
+    }
+
+    return ret;
+}
+
+/**
+ * Comment extraction alone, as a stream. Content is stepped over a char at a
+ * time.
+ */
+size commentsStream(const std::string& buf) {
+    std::istringstream stream(buf);
+
+    size ret{0};
+    while (stream.good()) {
+        utils::CommentData commentData{.stream_=stream};
+        (void)utils::extractComments(commentData);
+        ret += commentData.out_.size();
+
+        (void)stream.get();
+    }
+
+    return ret;
+}
+
+size commentsBuffer(std::string_view buf) {
+    utils::BufferCommentData commentData{.buf_=buf};
+
+    size ret{0};
+    while (commentData.pos_ < buf.size()) {
+        (void)utils::extractComments(commentData);
+        for (const auto& span : commentData.spans_) {
+            ret += span.end_ - span.begin_;
+        }
+
+        ++commentData.pos_;
+    }
+
+    return ret;
+}
+
+/**
+ * @return MB/s of func over bufs, best of a few runs.
+ */
+template <typename F>
+float64 throughput(const std::vector<std::string>& bufs, const F& func) {
+    size bytes{0};
+    for (const auto& buf : bufs) bytes += buf.size();
+
+    std::chrono::duration<float64> best{std::chrono::hours{1}};
+    for (size run{0}; run < 20; ++run) {
+        const auto start{std::chrono::steady_clock::now()};
+        size sink{0};
+        for (const auto& buf : bufs) sink += func(buf);
+        const auto elapsed{std::chrono::steady_clock::now() - start};
+
+        REQUIRE(sink > 0);
+        best = std::min<std::chrono::duration<float64>>(best, elapsed);
+    }
+
+    return static_cast<float64>(bytes) / 1e6 / best.count();
+}
+
+/**
+ * Repeat every preset in every array factor times. Each copy is made unique
+ * so it isn't served from the generator or check caches.
+ */
+void repeatPresets(config::Config& config, size factor) {
+    using config::presets::Preset;
+
+    auto presetArrays{data::context(config.presetArrays_)};
+    for (const auto& arrayModel : presetArrays.children()) {
+        auto& array{dynamic_cast<config::presets::Array&>(*arrayModel)};
+        auto presets{data::context(array.presets_)};
+
+        const auto count{presets.children().size()};
+        for (size copy{1}; copy < factor; ++copy) {
+            for (size idx{0}; idx < count; ++idx) {
+                auto& source{dynamic_cast<Preset&>(*presets.children()[idx])};
+                auto& preset{presets.append<Preset>(source, config)};
+
+                const auto tag{std::to_string(copy * count + idx)};
+                auto name{data::context(preset.name_)};
+                name.change("scaled " + tag);
+
+                auto styles{data::context(preset.styles_)};
+                if (styles.children().empty()) continue;
+
+                auto& style{styles.child<config::presets::Style>(0)};
+                auto comment{data::context(style.comment_)};
+                comment.change("scaled " + tag);
+            }
+        }
+    }
+}
+
+/**
+ * Repeat every style alias factor times, under new names.
+ */
+void repeatStyles(config::Config& config, size factor) {
+    using config::styles::Style;
+
+    auto styles{data::context(config.styles_)};
+    const auto count{styles.children().size()};
+    for (size copy{1}; copy < factor; ++copy) {
+        for (size idx{0}; idx < count; ++idx) {
+            auto& source{dynamic_cast<Style&>(*styles.children()[idx])};
+            auto& style{styles.append<Style>(source, config)};
+
+            auto name{data::context(style.name_)};
+            name.change(name.val() + "Scaled" + std::to_string(copy));
+
+            auto comments{data::context(style.comments_)};
+            comments.change("scaled " + std::to_string(copy));
+        }
+    }
+}
+
+/**
+ * Repeat every entry in the blade array of a generated config factor times.
+ * Copies get their own ID and name so they don't conflict.
+ *
+ * Blade arrays are done as text since they can't be copied as models.
+ */
+std::string repeatBladeConfigs(const std::string& header, size factor) {
+    constexpr std::string_view BLADES_START{"BladeConfig blades[] = {\n"};
+    constexpr std::string_view BLADES_END{"};\n"};
+    constexpr std::string_view ENTRY_START{"\t{ "};
+    constexpr std::string_view ENTRY_END{"\n\t},\n"};
+    constexpr std::string_view CONFIG_ARRAY{"CONFIGARRAY("};
+
+    // Well clear of real resistances, and still under NO_BLADE
+    constexpr size ID_BASE{100000000};
+
+    const auto start{header.find(BLADES_START)};
+    if (start == std::string::npos) return header;
+
+    const auto bodyStart{start + BLADES_START.size()};
+    const auto bodyEnd{header.find(BLADES_END, bodyStart)};
+    if (bodyEnd == std::string::npos) return header;
+
+    const std::string_view body{
+        std::string_view{header}.substr(bodyStart, bodyEnd - bodyStart)
+    };
+
+    std::vector<std::string_view> entries;
+    for (size pos{0}; pos < body.size();) {
+        const auto end{body.find(ENTRY_END, pos)};
+        if (end == std::string_view::npos) break;
+
+        entries.push_back(body.substr(pos, end - pos));
+        pos = end + ENTRY_END.size();
+    }
+
+    auto ret{header.substr(0, bodyEnd)};
+    for (size copy{1}; copy < factor; ++copy) {
+        for (size idx{0}; idx < entries.size(); ++idx) {
+            const auto entry{entries[idx]};
+            const auto idEnd{entry.find(',')};
+            const auto arrayEnd{entry.find(')', entry.find(CONFIG_ARRAY))};
+
+            const auto tag{std::to_string(copy * entries.size() + idx)};
+
+            ret += ENTRY_START;
+            ret += std::to_string(ID_BASE + copy * entries.size() + idx);
+            ret += entry.substr(idEnd, arrayEnd + 1 - idEnd);
+            ret += ", \"scaled";
+            ret += tag;
+            ret += '"';
+            ret += ENTRY_END;
+        }
+    }
+    ret += header.substr(bodyEnd);
+
+    return ret;
+}
+
+/**
+ * Read a config from path, scale its presets, style aliases and blade arrays
+ * by factor, and write it back out to outPath.
+ *
+ * @return false if the config couldn't be scaled
+ */
+bool scaleConfig(const fs::path& path, size factor, const fs::path& outPath) {
+    std::unique_ptr<config::Config> config;
+    if (config::read(path, config)) return false;
+
+    repeatPresets(*config, factor);
+    repeatStyles(*config, factor);
+
+    std::string header;
+    if (config::priv::io::generate(header, *config)) return false;
+
+    std::error_code err;
+    return files::writeAtomic(
+        outPath, repeatBladeConfigs(header, factor), err
+    );
+}
+
+} // namespace
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("Config comment extraction", "[.][benchmark]") {
+    auto bufs{configs()};
+    REQUIRE(not bufs.empty());
+
+    // The biggest configs are the ones worth measuring.
+    std::ranges::sort(bufs, std::ranges::greater{}, &std::string::size);
+    bufs.resize(std::min<size>(bufs.size(), 3));
+
+    WARN("istringstream: " << throughput(bufs, commentsStream) << " MB/s");
+    WARN("Buffer: " << throughput(bufs, commentsBuffer) << " MB/s");
+
+    BENCHMARK("istringstream") {
+        size ret{0};
+        for (const auto& buf : bufs) ret += commentsStream(buf);
+        return ret;
+    };
+
+    BENCHMARK("Buffer") {
+        size ret{0};
+        for (const auto& buf : bufs) ret += commentsBuffer(buf);
+        return ret;
+    };
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("Config scanning", "[.][benchmark]") {
+    const auto bufs{configs()};
+    REQUIRE(not bufs.empty());
+
+    size expected{0};
+    for (const auto& buf : bufs) expected += scanStream(buf);
+
+    size lexed{0};
+    for (const auto& buf : bufs) lexed += scanLexer(buf);
+    REQUIRE(lexed == expected);
+
+    BENCHMARK("istringstream") {
+        size ret{0};
+        for (const auto& buf : bufs) ret += scanStream(buf);
+        return ret;
+    };
+
+    BENCHMARK("Lexer") {
+        size ret{0};
+        for (const auto& buf : bufs) ret += scanLexer(buf);
+        return ret;
+    };
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("Config round trip scaling", "[.][benchmark]") {
+    constexpr std::array<size, 3> FACTORS{1, 4, 16};
+    constexpr size RUNS{3};
+
+    const auto tmpDir{fs::temp_directory_path() / "proffieconfig-bench"};
+    fs::create_directories(tmpDir);
+
+    std::vector<fs::path> paths;
+    for (const auto& entry : fs::directory_iterator(CONFIG_DIR)) {
+        if (entry.path().extension() != config::RAW_FILE_EXTENSION) continue;
+        paths.push_back(entry.path());
+    }
+    std::ranges::sort(paths);
+
+    size measured{0};
+    for (const auto& path : paths) {
+        // Start from generated output, so every scale is read from the same
+        // form. Configs which can't be generated are skipped.
+        const auto basePath{tmpDir / path.filename()};
+        if (not scaleConfig(path, 1, basePath)) continue;
+
+        for (const auto factor : FACTORS) {
+            const auto name{
+                path.stem().string() + " x" + std::to_string(factor)
+            };
+            INFO(name);
+
+            const auto scaledPath{
+                tmpDir / (name + config::RAW_FILE_EXTENSION)
+            };
+            REQUIRE(scaleConfig(basePath, factor, scaledPath));
+
+            struct {
+                float64 parse_{1e9};
+                float64 hash_{1e9};
+                float64 checkCold_{1e9};
+                float64 checkWarm_{1e9};
+                float64 generateCold_{1e9};
+                float64 generateWarm_{1e9};
+            } best;
+
+            std::string header;
+            for (size run{0}; run < RUNS; ++run) {
+                std::unique_ptr<config::Config> config;
+                std::optional<std::string> err;
+                uint64 hash{};
+
+                const auto keep{[](float64& slot, float64 time) {
+                    slot = std::min(slot, time);
+                }};
+
+                keep(best.parse_, utils::timeMs([&] {
+                    err = config::read(scaledPath, config);
+                }));
+                REQUIRE(err == std::nullopt);
+
+                keep(best.hash_, utils::timeMs([&] { hash = config->hash(); }));
+
+                keep(best.checkCold_, utils::timeMs([&] {
+                    err = config::check(*config);
+                }));
+                REQUIRE(err == std::nullopt);
+                keep(best.checkWarm_, utils::timeMs([&] {
+                    err = config::check(*config);
+                }));
+
+                keep(best.generateCold_, utils::timeMs([&] {
+                    err = config::priv::io::generate(header, *config);
+                }));
+                REQUIRE(err == std::nullopt);
+                keep(best.generateWarm_, utils::timeMs([&] {
+                    err = config::priv::io::generate(header, *config);
+                }));
+
+                // The model must survive being generated and read back.
+                if (run != 0) continue;
+
+                const auto roundTripPath{tmpDir / "roundtrip.h"};
+                std::error_code ec;
+                REQUIRE(files::writeAtomic(roundTripPath, header, ec));
+
+                std::unique_ptr<config::Config> reparsed;
+                REQUIRE(config::read(roundTripPath, reparsed) == std::nullopt);
+                REQUIRE(reparsed->hash() == hash);
+            }
+
+            WARN(
+                name << " (" << header.size() / 1000 << " kB): "
+                "parse " << best.parse_ << " ms, "
+                "hash " << best.hash_ << " ms, "
+                "preCheck " << best.checkCold_ << " ms "
+                "(warm " << best.checkWarm_ << " ms), "
+                "generate " << best.generateCold_ << " ms "
+                "(warm " << best.generateWarm_ << " ms)"
+            );
+            ++measured;
+        }
+    }
+
+    fs::remove_all(tmpDir);
+    REQUIRE(measured > 0);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("Config synthetic", "[.][benchmark]") {
+    struct Case {
+        cstring name_;
+        config::synth::Shape shape_;
+    };
+    const std::array<Case, 3> CASES{{
+        {"small", {.presets_=20, .blades_=2}},
+        {"medium", {.presets_=200, .bladeConfigs_=4, .blades_=10, .splits_=3, .styleAliases_=50}},
+        {"large", {.presetArrays_=2, .presets_=1000, .bladeConfigs_=8, .blades_=40, .splits_=4, .styleAliases_=500}},
+    }};
+
+    const auto path{fs::temp_directory_path() / "proffieconfig-synth-bench.h"};
+
+    for (const auto& [name, shape] : CASES) {
+        INFO(name);
+
+        std::unique_ptr<config::Config> config;
+        std::optional<std::string> err;
+
+        const auto buildMs{utils::timeMs([&] {
+            err = config::synth::build(shape, config);
+        })};
+        REQUIRE(err == std::nullopt);
+
+        std::string header;
+        const auto generateMs{utils::timeMs([&] {
+            err = config::priv::io::generate(header, *config);
+        })};
+        REQUIRE(err == std::nullopt);
+
+        std::error_code ec;
+        REQUIRE(files::writeAtomic(path, header, ec));
+
+        std::unique_ptr<config::Config> reparsed;
+        const auto parseMs{utils::timeMs([&] {
+            err = config::read(path, reparsed);
+        })};
+        REQUIRE(err == std::nullopt);
+
+        uint64 hash{};
+        const auto hashMs{utils::timeMs([&] { hash = reparsed->hash(); })};
+        REQUIRE(hash == config->hash());
+
+        const auto checkMs{utils::timeMs([&] { err = config::check(*reparsed); })};
+        REQUIRE(err == std::nullopt);
+
+        WARN(
+            name << " (" << header.size() / 1000 << " kB): "
+            "build " << buildMs << " ms, "
+            "generate " << generateMs << " ms, "
+            "parse " << parseMs << " ms, "
+            "hash " << hashMs << " ms, "
+            "preCheck " << checkMs << " ms"
+        );
+    }
+
+    std::error_code ec;
+    fs::remove(path, ec);
+}
@@ -0,0 +1,156 @@
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2026 Ryan Ogurek
+ *
+ * test/benchmarks/data.cpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "config/config.hpp"
+#include "config/synth.hpp"
+#include "data/hierarchic/model.hpp"
+#include "data/primitive/models/number.hpp"
+#include "data/receiver.hpp"
+
+namespace {
+
+/**
+ * Stand-in for a control, which only counts what it's told.
+ */
+struct Counter : data::Receiver {
+    Counter(const data::prim::Integer& model) {
+        observeWith(model, TABLE);
+        activate();
+    }
+
+    ~Counter() override { deactivate(); }
+
+    void onSet(const data::base::Model&) { ++count_; }
+
+    size count_{0};
+
+    static const data::base::Integer::RecvTable TABLE;
+};
+
+const data::base::Integer::RecvTable Counter::TABLE{[] {
+    data::base::Integer::RecvTable table;
+    table.onSet_ = data::map<&Counter::onSet>();
+    return table;
+}()};
+
+/**
+ * Stand-in for an editor control or page, which observes a model, or a model
+ * and the items in it.
+ */
+struct Watcher : data::Receiver {
+    Watcher(const std::vector<const data::hier::Model *>& models) {
+        for (const auto *model : models) observeWith(*model, TABLE);
+        activate();
+    }
+
+    ~Watcher() override { deactivate(); }
+
+    static const data::base::Model::RecvTable TABLE;
+};
+
+const data::base::Model::RecvTable Watcher::TABLE{};
+
+void collect(
+    const data::hier::Model& model,
+    std::vector<const data::hier::Model *>& out
+) {
+    out.push_back(&model);
+    for (const auto *child : model.children()) collect(*child, out);
+}
+
+} // namespace
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("Receiver fan-out", "[.][benchmark]") {
+    constexpr size NUM_RECEIVERS{64};
+
+    data::prim::Integer model;
+    std::vector<std::unique_ptr<Counter>> counters;
+    for (size idx{0}; idx < NUM_RECEIVERS; ++idx) {
+        counters.push_back(std::make_unique<Counter>(model));
+    }
+
+    REQUIRE(model.set(1));
+    for (const auto& counter : counters) REQUIRE(counter->count_ == 1);
+
+    int32 val{1};
+    BENCHMARK("Set") {
+        val = val == 1 ? 2 : 1;
+        return model.set(val);
+    };
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("Receiver build and teardown", "[.][benchmark]") {
+    std::unique_ptr<config::Config> config;
+    REQUIRE(config::synth::build(
+        {
+            .presetArrays_=2,
+            .presets_=1000,
+            .bladeConfigs_=8,
+            .blades_=40,
+            .splits_=4,
+            .styleAliases_=500,
+        },
+        config
+    ) == std::nullopt);
+
+    std::vector<const data::hier::Model *> models;
+    collect(*config, models);
+
+    // Roughly what the editor does: a control for each model, and a list for
+    // each model with items.
+    const auto build{[&] {
+        std::vector<std::unique_ptr<Watcher>> watchers;
+        watchers.reserve(models.size() * 2);
+        for (const auto *model : models) {
+            watchers.push_back(std::make_unique<Watcher>(
+                std::vector<const data::hier::Model *>{model}
+            ));
+
+            const auto children{model->children()};
+            if (not children.empty()) {
+                watchers.push_back(std::make_unique<Watcher>(children));
+            }
+        }
+        return watchers;
+    }};
+
+    WARN(models.size() << " models");
+
+    BENCHMARK("Build") {
+        return build().size();
+    };
+
+    BENCHMARK_ADVANCED("Teardown")(Catch::Benchmark::Chronometer meter) {
+        std::vector<std::vector<std::unique_ptr<Watcher>>> runs(meter.runs());
+        for (auto& run : runs) run = build();
+
+        meter.measure([&](int idx) { runs[idx].clear(); });
+    };
+}
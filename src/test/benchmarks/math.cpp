@@ -0,0 +1,81 @@
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2026 Ryan Ogurek
+ *
+ * test/benchmarks/math.cpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "utils/string.hpp"
+
+namespace {
+
+/**
+ * Strings of the sort read from a config: IDs, lengths, ranges, and timeouts.
+ */
+std::vector<std::string> corpus() {
+    std::vector<std::string> ret{
+        "0", "2000", "NO_BLADE", "NO_BLADE", "NO_BLADE",
+        "10 * 60 * 1000", "60 * 5 * 1000", "2 * 60 * 1000", "1.0", "4.5",
+        "(144 - 1) / 2", "-5", "3.000000", "0x10", "NO_BLADE - 1",
+    };
+
+    for (size idx{0}; idx < 200; ++idx) {
+        ret.push_back(std::to_string(idx % 150));
+        ret.push_back(std::to_string(idx % 20) + " * 1000");
+    }
+
+    return ret;
+}
+
+} // namespace
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("String math evaluation", "[.][benchmark]") {
+    const auto strs{corpus()};
+    constexpr std::array<utils::MathConstant, 1> CONSTANTS{{
+        {.name_="NO_BLADE", .value_=1000000000},
+    }};
+
+    for (const auto& str : strs) {
+        INFO(str);
+        const auto expr{utils::MathExpression::compile(str)};
+        REQUIRE(expr);
+        REQUIRE(utils::doStringMath(str, CONSTANTS) == expr->evaluate(CONSTANTS));
+    }
+
+    BENCHMARK("Compile") {
+        float64 ret{0};
+        for (const auto& str : strs) {
+            ret += *utils::MathExpression::compile(str)->evaluate(CONSTANTS);
+        }
+        return ret;
+    };
+
+    BENCHMARK("Cached") {
+        float64 ret{0};
+        for (const auto& str : strs) {
+            ret += *utils::doStringMath(str, CONSTANTS);
+        }
+        return ret;
+    };
+}
@@ -0,0 +1,128 @@
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2026 Ryan Ogurek
+ *
+ * test/benchmarks/pconf.cpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "pconf/document.hpp"
+#include "pconf/read.hpp"
+#include "pconf/utils.hpp"
+#include "utils/files.hpp"
+
+namespace {
+
+const fs::path PROPS_DIR{PROPS_DIR_STR};
+
+std::vector<fs::path> propFiles() {
+    std::vector<fs::path> ret;
+    for (const auto& entry : fs::recursive_directory_iterator(PROPS_DIR)) {
+        if (entry.path().extension() == ".pconf") ret.push_back(entry.path());
+    }
+
+    return ret;
+}
+
+/**
+ * Visit every node and touch its value, which is what consumers of either
+ * representation effectively do.
+ */
+size traverse(const pconf::Data& data) {
+    size ret{0};
+    for (const auto& entry : data) {
+        ret += entry->name_.size();
+        if (entry->value_) ret += entry->value_->size();
+
+        if (auto section{entry.section()}) ret += traverse(section->entries_);
+    }
+
+    return ret;
+}
+
+size traverse(pconf::Document::Children children) {
+    size ret{0};
+    for (const auto& node : children) {
+        ret += node.name_.size();
+        if (node.value_) ret += node.value_->size();
+
+        if (node.isSection()) ret += traverse(node.entries());
+    }
+
+    return ret;
+}
+
+} // namespace
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("PConf traversal", "[.][benchmark]") {
+    std::vector<pconf::Data> trees;
+    std::vector<pconf::Document> docs;
+    for (const auto& path : propFiles()) {
+        auto stream{files::openInput(path)};
+        REQUIRE(pconf::read(stream, trees.emplace_back(), nullptr));
+        REQUIRE(pconf::read(path, docs.emplace_back(), nullptr));
+    }
+
+    size expected{0};
+    for (const auto& tree : trees) expected += traverse(tree);
+
+    size docTotal{0};
+    for (const auto& doc : docs) docTotal += traverse(doc.entries());
+    REQUIRE(docTotal == expected);
+
+    BENCHMARK("shared_ptr tree") {
+        size ret{0};
+        for (const auto& tree : trees) ret += traverse(tree);
+        return ret;
+    };
+
+    BENCHMARK("Flat document") {
+        size ret{0};
+        for (const auto& doc : docs) ret += traverse(doc.entries());
+        return ret;
+    };
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("PConf hash", "[.][benchmark]") {
+    std::vector<pconf::Data> trees;
+    for (const auto& path : propFiles()) {
+        auto stream{files::openInput(path)};
+        REQUIRE(pconf::read(stream, trees.emplace_back(), nullptr));
+    }
+
+    // Each section's entries, as prop settings are read.
+    std::vector<const pconf::Data *> sections;
+    for (const auto& tree : trees) {
+        sections.push_back(&tree);
+        for (const auto& entry : tree) {
+            if (auto section{entry.section()}) sections.push_back(&section->entries_);
+        }
+    }
+
+    BENCHMARK("Hash") {
+        size ret{0};
+        for (const auto *data : sections) {
+            ret += pconf::hash(*data).findAll("NAME").size();
+        }
+        return ret;
+    };
+}
@@ -18,6 +18,11 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <random>
+#include <sstream>
 #include <string>
 
 #include <catch2/catch_test_macros.hpp>
@@ -28,10 +33,17 @@
 #include "config/presets/array.hpp"
 #include "config/presets/preset.hpp"
 #include "config/presets/style.hpp"
+#include "config/priv/generate/buffer.hpp"
+#include "config/priv/generate/cache.hpp"
+#include "config/priv/io.hpp"
+#include "config/priv/parse/lexer.hpp"
+#include "config/priv/parse/styles.hpp"
 #include "config/settings/define.hpp"
 #include "config/styles/style.hpp"
 #include "config/strings.hpp"
+#include "config/synth.hpp"
 #include "data/context.hpp"
+#include "utils/files.hpp"
 #include "utils/paths.hpp"
 #include "utils/string.hpp"
 
@@ -39,6 +51,108 @@ namespace {
 
 const fs::path CONFIG_DIR{CONFIG_DIR_STR};
 
+/**
+ * @return The presets of the config's first array
+ */
+data::hier::Vector& presetsOf(config::Config& cfg) {
+    return data::context(cfg.presetArrays_)
+        .child<config::presets::Array>(0).presets_;
+}
+
+/**
+ * What one extractComments() call reported, either way it was read.
+ */
+struct CommentResult {
+    bool read_;
+    uint32 type_;
+    std::string out_;
+    size pos_;
+
+    bool operator==(const CommentResult&) const = default;
+};
+
+CommentResult commentsFromStream(
+    std::string_view buf, size pos, const utils::BufferCommentData& opts
+) {
+    std::istringstream stream{std::string{buf}};
+    stream.seekg(static_cast<std::streamoff>(pos));
+
+    utils::CommentData data{
+        .stream_=stream,
+        .type_=opts.type_,
+        .single_=opts.single_,
+        .skipNewlines_=opts.skipNewlines_,
+        .skipSpaces_=opts.skipSpaces_,
+    };
+
+    CommentResult ret{};
+    ret.read_ = utils::extractComments(data);
+    ret.type_ = data.type_;
+    ret.out_ = std::move(data.out_);
+
+    stream.clear();
+    const auto end{stream.tellg()};
+    ret.pos_ = end < 0 ? buf.size() : static_cast<size>(end);
+
+    return ret;
+}
+
+CommentResult commentsFromBuffer(
+    std::string_view buf, size pos, utils::BufferCommentData opts
+) {
+    opts.buf_ = buf;
+    opts.pos_ = pos;
+
+    CommentResult ret{};
+    ret.read_ = utils::extractComments(opts);
+    ret.type_ = opts.type_;
+    utils::formatComments(buf, opts.spans_, ret.out_);
+    ret.pos_ = opts.pos_;
+
+    return ret;
+}
+
+/**
+ * Check both ways of reading comments agree from pos, for every combination
+ * of options.
+ */
+void checkComments(std::string_view buf, size pos) {
+    constexpr uint32 NUM_COMBOS{1U << 5};
+    for (uint32 combo{0}; combo < NUM_COMBOS; ++combo) {
+        const utils::BufferCommentData opts{
+            .type_=combo & (
+                utils::CommentData::eType_Line |
+                utils::CommentData::eType_Block
+            ),
+            .single_=(combo & (1U << 2)) != 0,
+            .skipNewlines_=(combo & (1U << 3)) != 0,
+            .skipSpaces_=(combo & (1U << 4)) != 0,
+        };
+
+        auto fromStream{commentsFromStream(buf, pos, opts)};
+        const auto fromBuffer{commentsFromBuffer(buf, pos, opts)};
+
+        // Once peek() has hit the end, the stream can't put a trailing '/'
+        // back. The buffer leaves it, as it does anywhere else.
+        if (
+                fromStream.pos_ == buf.size() and
+                fromBuffer.pos_ == buf.size() - 1 and
+                buf.back() == '/'
+           ) {
+            fromStream.pos_ = fromBuffer.pos_;
+        }
+
+        // There are millions of these, only report what differs.
+        if (fromBuffer == fromStream) continue;
+
+        INFO("From " << pos << ", options " << combo);
+        CHECK(fromBuffer.read_ == fromStream.read_);
+        CHECK(fromBuffer.type_ == fromStream.type_);
+        CHECK(fromBuffer.out_ == fromStream.out_);
+        CHECK(fromBuffer.pos_ == fromStream.pos_);
+    }
+}
+
 } // namespace
 
 // NOLINTNEXTLINE(misc-use-anonymous-namespace)
@@ -158,3 +272,457 @@ TEST_CASE("Config") {
     }
 }
 
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("Config generation cache") {
+    for (const auto& entry : fs::directory_iterator(paths::configDir()))
+        fs::remove_all(entry);
+
+    config::update();
+
+    constexpr cstring CONFIG_NAME{"Tsukuyomi"};
+
+    auto importErr{config::import(
+        CONFIG_NAME,
+        CONFIG_DIR / (std::string(CONFIG_NAME) + ".h")
+    )};
+    REQUIRE(importErr == std::nullopt);
+
+    auto listCtxt{data::context(config::list())};
+    auto& info{dynamic_cast<config::Info&>(*listCtxt.children()[0])};
+    REQUIRE(info.load() == std::nullopt);
+
+    auto& cfg{*info.config()};
+    const auto& stats{config::priv::gen::Cache::of(cfg).stats()};
+
+    std::string first;
+    REQUIRE(config::priv::io::generate(first, cfg) == std::nullopt);
+    const auto lookups{stats.hits_ + stats.renders_};
+    REQUIRE(stats.renders_ > 0);
+
+    // Fully cached the second time around, must be identical.
+    auto before{stats};
+    std::string cached;
+    REQUIRE(config::priv::io::generate(cached, cfg) == std::nullopt);
+    REQUIRE(cached == first);
+    CHECK(stats.renders_ == before.renders_);
+    CHECK(stats.hits_ - before.hits_ == lookups);
+
+    auto& preset{
+        data::context(presetsOf(cfg)).child<config::presets::Preset>(0)
+    };
+    auto nameCtxt{data::context(preset.name_)};
+    const auto name{nameCtxt.val()};
+
+    // Only the renamed preset is rendered again.
+    nameCtxt.change("cachetest");
+    before = stats;
+    std::string edited;
+    REQUIRE(config::priv::io::generate(edited, cfg) == std::nullopt);
+    REQUIRE(edited != first);
+    REQUIRE(edited.find("cachetest") != std::string::npos);
+    CHECK(stats.renders_ - before.renders_ == 1);
+    CHECK(stats.hits_ - before.hits_ == lookups - 1);
+
+    // The old text was swept by the last generation, so it's rendered again.
+    nameCtxt.change(std::string{name});
+    before = stats;
+    std::string reverted;
+    REQUIRE(config::priv::io::generate(reverted, cfg) == std::nullopt);
+    REQUIRE(reverted == first);
+    CHECK(stats.renders_ - before.renders_ == 1);
+    CHECK(stats.hits_ - before.hits_ == lookups - 1);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("Config check cache") {
+    for (const auto& entry : fs::directory_iterator(paths::configDir()))
+        fs::remove_all(entry);
+
+    config::update();
+
+    constexpr cstring CONFIG_NAME{"Tsukuyomi"};
+
+    auto importErr{config::import(
+        CONFIG_NAME,
+        CONFIG_DIR / (std::string(CONFIG_NAME) + ".h")
+    )};
+    REQUIRE(importErr == std::nullopt);
+
+    auto listCtxt{data::context(config::list())};
+    auto& info{dynamic_cast<config::Info&>(*listCtxt.children()[0])};
+    REQUIRE(info.load() == std::nullopt);
+
+    auto& cfg{*info.config()};
+    const auto& stats{config::priv::gen::Cache::of(cfg).stats()};
+
+    REQUIRE(config::check(cfg) == std::nullopt);
+    REQUIRE(stats.checks_ > 0);
+
+    auto before{stats};
+    REQUIRE(config::check(cfg) == std::nullopt);
+    CHECK(stats.checks_ == before.checks_);
+
+    auto& style{
+        data::context(
+            data::context(presetsOf(cfg)).child<config::presets::Preset>(1).styles_
+        ).child<config::presets::Style>(0)
+    };
+    auto contentCtxt{data::context(style.content_)};
+    const auto content{contentCtxt.val()};
+
+    // Only the edited preset is checked again, must still be caught.
+    contentCtxt.change("StylePtr<Black>(");
+    before = stats;
+    const auto err{config::check(cfg)};
+    REQUIRE(err != std::nullopt);
+    CHECK(err->find("preset 1") != std::string::npos);
+    CHECK(stats.checks_ - before.checks_ == 1);
+
+    contentCtxt.change(std::string{content});
+    before = stats;
+    REQUIRE(config::check(cfg) == std::nullopt);
+    CHECK(stats.checks_ - before.checks_ == 1);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("Config style dedup") {
+    for (const auto& entry : fs::directory_iterator(paths::configDir()))
+        fs::remove_all(entry);
+
+    config::update();
+
+    // Repeats the same blade style across dozens of presets.
+    constexpr cstring CONFIG_NAME{"CONFIG_FILE"};
+
+    auto importErr{config::import(
+        CONFIG_NAME,
+        CONFIG_DIR / (std::string(CONFIG_NAME) + ".h")
+    )};
+    REQUIRE(importErr == std::nullopt);
+
+    auto listCtxt{data::context(config::list())};
+    auto& info{dynamic_cast<config::Info&>(*listCtxt.children()[0])};
+    REQUIRE(info.load() == std::nullopt);
+
+    auto& cfg{*info.config()};
+
+    std::string plain;
+    REQUIRE(config::priv::io::generate(plain, cfg) == std::nullopt);
+    REQUIRE(plain.find("DedupStyle") == std::string::npos);
+
+    cfg.settings_.dedupStyles_.enable_.set(true);
+    cfg.settings_.dedupStyles_.threshold_.set(2);
+
+    std::string deduped;
+    REQUIRE(config::priv::io::generate(deduped, cfg) == std::nullopt);
+    CHECK(deduped.size() < plain.size());
+
+    const auto stylesPos{deduped.find("#ifdef CONFIG_STYLES")};
+    REQUIRE(stylesPos != std::string::npos);
+    CHECK(deduped.find("using DedupStyle1 = ", stylesPos) != std::string::npos);
+    CHECK(deduped.find("StylePtr<DedupStyle1>()") < stylesPos);
+
+    // Saved and read back, the aliases are still only an output detail.
+    const auto path{fs::temp_directory_path() / "proffieconfig-dedup.h"};
+    std::error_code err;
+    REQUIRE(files::writeAtomic(path, deduped, err));
+
+    std::unique_ptr<config::Config> reparsed;
+    REQUIRE(config::read(path, reparsed) == std::nullopt);
+    fs::remove(path, err);
+
+    auto reparsedStyles{data::context(reparsed->styles_)};
+    for (const auto& model : reparsedStyles.children()) {
+        auto& style{dynamic_cast<config::styles::Style&>(*model)};
+        CHECK_FALSE(data::context(style.name_).val().starts_with("DedupStyle"));
+    }
+    REQUIRE(data::context(reparsed->settings_.dedupStyles_.enable_).val());
+
+    std::string rededuped;
+    REQUIRE(config::priv::io::generate(rededuped, *reparsed) == std::nullopt);
+    CHECK(rededuped == deduped);
+
+    cfg.settings_.dedupStyles_.enable_.set(false);
+    reparsed->settings_.dedupStyles_.enable_.set(false);
+
+    std::string reverted;
+    REQUIRE(config::priv::io::generate(reverted, cfg) == std::nullopt);
+    CHECK(reverted == plain);
+
+    std::string reloadedReverted;
+    REQUIRE(config::priv::io::generate(
+        reloadedReverted, *reparsed
+    ) == std::nullopt);
+    CHECK(reloadedReverted == plain);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("Config lexer") {
+    using config::priv::parse::Lexer;
+
+    for (const auto& entry : fs::directory_iterator(CONFIG_DIR)) {
+        if (entry.path().extension() != ".h") continue;
+        INFO(entry.path().string());
+
+        auto file{files::openInput(entry.path())};
+        std::ostringstream content;
+        content << file.rdbuf();
+        const auto buf{std::move(content).str()};
+
+        // Both must agree on every comment and char, however they're read.
+        for (const bool skipWhitespace : {true, false}) {
+            std::istringstream stream(buf);
+            Lexer lexer{buf};
+
+            while (stream.good()) {
+                utils::CommentData streamComments{
+                    .stream_=stream,
+                    .skipNewlines_=skipWhitespace,
+                    .skipSpaces_=skipWhitespace,
+                };
+                Lexer::Comments lexerComments{
+                    .skipNewlines_=skipWhitespace,
+                    .skipSpaces_=skipWhitespace,
+                };
+                REQUIRE(
+                    utils::extractComments(streamComments) ==
+                    lexer.extractComments(lexerComments)
+                );
+                REQUIRE(streamComments.out_ == lexerComments.out_);
+                REQUIRE(streamComments.type_ == lexerComments.type_);
+
+                REQUIRE(stream.get() == lexer.get());
+                REQUIRE(stream.good() == lexer.good());
+            }
+        }
+    }
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("Config style aliases") {
+    const auto styles{config::priv::parse::readStyles(
+        "using namespace std;\n"
+        "// Red\n"
+        "using Red = Rgb<255, 0, 0>;\n"
+        "causing Nothing = Rgb<0, 0, 0>;\n"
+        "using std::move;\n"
+        "/* Block */using Blue/* Name */=\n"
+        "    Rgb<0, 0, // Inline\n"
+        "    255>;\n"
+        "template<class T> using Wrapped = Layers<T>;\n"
+    )};
+
+    REQUIRE(styles.size() == 3);
+
+    CHECK(styles[0].name_ == "Red");
+    CHECK(styles[0].comments_ == "Red");
+    CHECK(styles[0].content_ == "Rgb<255,0,0>");
+
+    CHECK(styles[1].name_ == "Blue");
+    CHECK(styles[1].comments_ == "Block\nName");
+    CHECK(styles[1].content_ == "Rgb<0,0,\n// Inline\n255>");
+
+    CHECK(styles[2].name_ == "Wrapped");
+    CHECK(styles[2].content_ == "Layers<T>");
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("Config comment spans") {
+    constexpr std::string_view BUF{"  // Line\n/* Block\n * Framed */ content"};
+
+    utils::BufferCommentData commentData{.buf_=BUF};
+    REQUIRE(utils::extractComments(commentData));
+    REQUIRE(commentData.type_ == (
+        utils::CommentData::eType_Line | utils::CommentData::eType_Block
+    ));
+    REQUIRE(commentData.pos_ == BUF.find("content"));
+
+    REQUIRE(commentData.spans_.size() == 2);
+    const auto& line{commentData.spans_[0]};
+    const auto& block{commentData.spans_[1]};
+    CHECK(BUF.substr(line.begin_, line.end_ - line.begin_) == " Line");
+    CHECK(
+        BUF.substr(block.begin_, block.end_ - block.begin_) ==
+        " Block\n * Framed "
+    );
+
+    // Same as the stream version, block comments don't start a new line.
+    std::string out;
+    utils::formatComments(BUF, commentData.spans_, out);
+    CHECK(out == "Line Block\nFramed");
+
+    // Only up to the next comment with single_
+    commentData.pos_ = 0;
+    commentData.single_ = true;
+    REQUIRE(utils::extractComments(commentData));
+    CHECK(commentData.spans_.size() == 1);
+    CHECK(commentData.pos_ == BUF.find("/*"));
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("Config comment extraction") {
+    SECTION("Corpus") {
+        for (const auto& entry : fs::directory_iterator(CONFIG_DIR)) {
+            if (entry.path().extension() != config::RAW_FILE_EXTENSION) continue;
+            INFO(entry.path().filename().string());
+
+            auto stream{files::openInput(entry.path())};
+            const std::string buf{
+                std::istreambuf_iterator<char>{stream},
+                std::istreambuf_iterator<char>{}
+            };
+
+            // Everywhere the lexer might start reading comments.
+            for (size pos{0}; pos < buf.size(); ++pos) {
+                if (pos == 0 or buf[pos - 1] == '\n' or buf[pos] == '/') {
+                    checkComments(buf, pos);
+                }
+            }
+        }
+    }
+
+    SECTION("Random") {
+        constexpr std::string_view ALPHABET{"/*  \n\ta\r"};
+        constexpr size NUM_BUFFERS{3000};
+        constexpr size MAX_LENGTH{48};
+
+        std::mt19937 rng{1};
+        for (size idx{0}; idx < NUM_BUFFERS; ++idx) {
+            std::string buf;
+            const auto length{rng() % MAX_LENGTH};
+            for (size chr{0}; chr < length; ++chr) {
+                buf += ALPHABET[rng() % ALPHABET.size()];
+            }
+
+            INFO('"' << buf << '"');
+            for (size pos{0}; pos <= buf.size(); ++pos) {
+                checkComments(buf, pos);
+            }
+        }
+    }
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("Config generate buffer") {
+    config::priv::gen::Buffer buf;
+    std::ostringstream stream;
+
+    // Must format everything the generators output the same as a stream.
+    const auto both{[&](const auto& val) {
+        buf << val;
+        stream << val;
+    }};
+
+    both("Preset ");
+    both(std::string{"presets"});
+    both('[');
+    both(int32{-144});
+    both(uint32{4000000000});
+    both(size{1} << 40);
+    both(float64{2.5});
+    both(float64{0.1} * 3);
+    both(float64{1e-7});
+    both(float64{123456789});
+    both(float64{3});
+
+    REQUIRE(buf.str() == stream.str());
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("Config round trip") {
+    const auto tmpDir{fs::temp_directory_path() / "proffieconfig-roundtrip"};
+    fs::create_directories(tmpDir);
+
+    // From an old version, these may not read or generate, and only what
+    // can be generated can be round tripped. Everything else must.
+    constexpr std::array<std::string_view, 1> MAY_FAIL{
+        "errorconfig.h",
+    };
+
+    size tested{0};
+    for (const auto& entry : fs::directory_iterator(CONFIG_DIR)) {
+        if (entry.path().extension() != config::RAW_FILE_EXTENSION) continue;
+
+        const auto name{entry.path().filename().string()};
+        INFO(name);
+
+        const auto mayFail{std::ranges::find(MAY_FAIL, name) != MAY_FAIL.end()};
+
+        std::unique_ptr<config::Config> original;
+        auto readErr{config::read(entry.path(), original)};
+        if (readErr and mayFail) continue;
+        REQUIRE(readErr == std::nullopt);
+
+        std::string first;
+        auto genErr{config::priv::io::generate(first, *original)};
+        if (genErr and mayFail) continue;
+        REQUIRE(genErr == std::nullopt);
+
+        const auto path{tmpDir / name};
+        std::error_code err;
+        REQUIRE(files::writeAtomic(path, first, err));
+
+        std::unique_ptr<config::Config> reparsed;
+        REQUIRE(config::read(path, reparsed) == std::nullopt);
+        CHECK(reparsed->hash() == original->hash());
+
+        // Generated output must read back to itself.
+        std::string second;
+        REQUIRE(config::priv::io::generate(second, *reparsed) == std::nullopt);
+        CHECK(second == first);
+
+        ++tested;
+    }
+
+    fs::remove_all(tmpDir);
+    REQUIRE(tested > 0);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("Config synth") {
+    config::synth::Shape shape;
+    REQUIRE(config::synth::parseShape(
+        "seed=7,arrays=2,presets=5,configs=3,blades=3,splits=3,aliases=4",
+        shape
+    ) == std::nullopt);
+    CHECK(shape.seed_ == 7);
+    CHECK(shape.bladeConfigs_ == 3);
+    CHECK(shape.styleAliases_ == 4);
+
+    CHECK(config::synth::parseShape("presets", shape) != std::nullopt);
+    CHECK(config::synth::parseShape("bogus=1", shape) != std::nullopt);
+    CHECK(config::synth::parseShape("blades=0", shape) != std::nullopt);
+    shape.blades_ = 3;
+
+    std::unique_ptr<config::Config> first;
+    REQUIRE(config::synth::build(shape, first) == std::nullopt);
+
+    auto presetArrays{data::context(first->presetArrays_)};
+    REQUIRE(presetArrays.children().size() == 2);
+    auto& array{presetArrays.child<config::presets::Array>(0)};
+    CHECK(data::context(array.presets_).children().size() == 5);
+    CHECK(data::context(first->bladeConfigs_).children().size() == 3);
+    CHECK(data::context(first->styles_).children().size() == 4);
+
+    // The same shape must always build the same config.
+    std::unique_ptr<config::Config> second;
+    REQUIRE(config::synth::build(shape, second) == std::nullopt);
+
+    std::string firstHeader;
+    REQUIRE(config::priv::io::generate(firstHeader, *first) == std::nullopt);
+    std::string secondHeader;
+    REQUIRE(config::priv::io::generate(secondHeader, *second) == std::nullopt);
+    CHECK(firstHeader == secondHeader);
+
+    // And read back as itself.
+    const auto path{fs::temp_directory_path() / "proffieconfig-synth.h"};
+    std::error_code err;
+    REQUIRE(files::writeAtomic(path, firstHeader, err));
+
+    std::unique_ptr<config::Config> reparsed;
+    REQUIRE(config::read(path, reparsed) == std::nullopt);
+    CHECK(reparsed->hash() == first->hash());
+
+    fs::remove(path, err);
+}
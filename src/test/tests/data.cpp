@@ -0,0 +1,644 @@
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2026 Ryan Ogurek
+ *
+ * test/tests/data.cpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "config/config.hpp"
+#include "config/presets/array.hpp"
+#include "config/presets/preset.hpp"
+#include "config/presets/style.hpp"
+#include "config/synth.hpp"
+#include "data/context.hpp"
+#include "data/hierarchic/models/bool.hpp"
+#include "data/hierarchic/models/selector.hpp"
+#include "data/receiver.hpp"
+
+namespace {
+
+/**
+ * @return The presets of the config's first array
+ */
+data::hier::Vector& presetsOf(config::Config& cfg) {
+    return data::context(cfg.presetArrays_)
+        .child<config::presets::Array>(0).presets_;
+}
+
+/**
+ * Build a synthetic config, failing the test if it can't be.
+ *
+ * @return The config's first preset
+ */
+config::presets::Preset& buildSynth(
+    std::unique_ptr<config::Config>& cfg,
+    const config::synth::Shape& shape = {}
+) {
+    REQUIRE(config::synth::build(shape, cfg) == std::nullopt);
+    return data::context(presetsOf(*cfg)).child<config::presets::Preset>(0);
+}
+
+// Moved by hand, so coalescing doesn't depend on how fast the test runs.
+std::chrono::steady_clock::time_point fixedNow;
+
+/**
+ * Stand-in for a control bound through a selector, which notes what's bound
+ * each time it's told of a rebind.
+ */
+struct RebindWatcher : data::Receiver {
+    RebindWatcher(const data::base::Selector& sel) : mSel{sel} {
+        observeWith(sel, TABLE);
+        activate();
+    }
+
+    ~RebindWatcher() override { deactivate(); }
+
+    void preRebound() { pre_.push_back(data::context(mSel).bound()); }
+    void onRebound() { on_.push_back(data::context(mSel).bound()); }
+
+    std::vector<const data::base::Vector *> pre_;
+    std::vector<const data::base::Vector *> on_;
+
+    static const data::base::Selector::RecvTable TABLE;
+
+private:
+    const data::base::Selector& mSel;
+};
+
+const data::base::Selector::RecvTable RebindWatcher::TABLE{[] {
+    data::base::Selector::RecvTable table;
+    table.preRebound_ = data::map<&RebindWatcher::preRebound>();
+    table.onRebound_ = data::map<&RebindWatcher::onRebound>();
+    return table;
+}()};
+
+/**
+ * Stand-in for a control listing a vector, which counts what it's told.
+ */
+struct ResizeWatcher : data::Receiver {
+    ResizeWatcher(const data::base::Vector& vec) {
+        observeWith(vec, TABLE);
+        activate();
+    }
+
+    ~ResizeWatcher() override { deactivate(); }
+
+    void onInsert(size) { ++inserts_; }
+    void onResized() { ++resizes_; }
+
+    size inserts_{0};
+    size resizes_{0};
+
+    static const data::base::Vector::RecvTable TABLE;
+};
+
+const data::base::Vector::RecvTable ResizeWatcher::TABLE{[] {
+    data::base::Vector::RecvTable table;
+    table.onInsert_ = data::map<&ResizeWatcher::onInsert>();
+    table.onResized_ = data::map<&ResizeWatcher::onResized>();
+    return table;
+}()};
+
+/**
+ * Stand-in for a control which can take focus, and which may close another
+ * (or itself) when it does.
+ */
+struct FocusWatcher : data::Receiver {
+    FocusWatcher(const data::base::Model& model) {
+        observeWith(model, TABLE);
+        activate();
+    }
+
+    ~FocusWatcher() override { deactivate(); }
+
+    void onFocus() {
+        ++focuses_;
+        if (detach_) detach_->deactivate();
+    }
+
+    size focuses_{0};
+    data::Receiver *detach_{nullptr};
+
+    static const data::base::Model::RecvTable TABLE;
+};
+
+const data::base::Model::RecvTable FocusWatcher::TABLE{[] {
+    data::base::Model::RecvTable table;
+    table.onFocus_ = data::map<&FocusWatcher::onFocus>();
+    return table;
+}()};
+
+} // namespace
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("Data hash cache") {
+    config::synth::Shape shape;
+    REQUIRE(
+        config::synth::parseShape("presets=50,blades=4", shape) == std::nullopt
+    );
+
+    std::unique_ptr<config::Config> cfg;
+    auto& preset{buildSynth(cfg, shape)};
+
+    const auto original{cfg->hash()};
+    const auto fullCount{cfg->hashesComputed()};
+
+    // Nothing changed, nothing to hash again.
+    CHECK(cfg->hash() == original);
+    CHECK(cfg->hashesComputed() == fullCount);
+
+    data::context(preset.name_).change("hashcache");
+
+    // Only the path down to the edited name is hashed again.
+    const auto edited{cfg->hash()};
+    const auto editCount{cfg->hashesComputed() - fullCount};
+    CHECK(edited != original);
+    CHECK(editCount > 0);
+    CHECK(editCount * 10 < fullCount);
+
+    REQUIRE(data::context(*cfg).canUndo());
+    data::context(*cfg).undo();
+    CHECK(cfg->hash() == original);
+
+    data::context(*cfg).redo();
+    CHECK(cfg->hash() == edited);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("Data undo budget") {
+    std::unique_ptr<config::Config> cfg;
+    auto nameCtxt{data::context(buildSynth(cfg).name_)};
+
+    auto root{data::context(*cfg)};
+    root.setUndoBudget(5, data::hier::Root::eUndo_Max_Footprint);
+
+    for (auto idx{0}; idx < 10; ++idx)
+        nameCtxt.change("budget" + std::to_string(idx));
+
+    CHECK(root.undoDepth() == 5);
+    CHECK(root.undoFootprint() > 0);
+
+    // The oldest were dropped, only the last five can be undone.
+    for (auto idx{0}; idx < 5; ++idx) {
+        REQUIRE(root.canUndo());
+        root.undo();
+    }
+    CHECK(not root.canUndo());
+    CHECK(nameCtxt.val() == "budget4");
+
+    // Every action is on the redo side, those are never dropped.
+    root.setUndoBudget(1, 1);
+    CHECK(root.undoDepth() == 5);
+
+    root.redo();
+    root.redo();
+    root.setUndoBudget(1, 1);
+    CHECK(root.undoDepth() == 4);
+    CHECK(nameCtxt.val() == "budget6");
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("Data string edits") {
+    std::unique_ptr<config::Config> cfg;
+    auto& preset{buildSynth(cfg)};
+
+    auto root{data::context(*cfg)};
+
+    auto& style{
+        data::context(preset.styles_).child<config::presets::Style>(0)
+    };
+    auto contentCtxt{data::context(style.content_)};
+
+    std::string big{"StylePtr<Layers<Black"};
+    for (auto idx{0}; idx < 200; ++idx) big += ",AlphaL<Red,Int<0>>";
+    big += ">>()";
+    contentCtxt.change(std::string{big});
+    const auto original{contentCtxt.val()};
+
+    auto edited{original};
+    edited.insert(edited.length() / 2, "Blue");
+
+    // Only the inserted text is held, not a copy of the whole thing.
+    const auto footprint{root.undoFootprint()};
+    contentCtxt.change(std::string{edited});
+    CHECK(contentCtxt.val() == edited);
+    CHECK(root.undoFootprint() - footprint < original.length() / 4);
+
+    auto replaced{edited};
+    replaced.replace(10, 20, "Green");
+    contentCtxt.change(std::string{replaced});
+    CHECK(contentCtxt.val() == replaced);
+
+    root.undo();
+    CHECK(contentCtxt.val() == edited);
+    root.undo();
+    CHECK(contentCtxt.val() == original);
+
+    root.redo();
+    CHECK(contentCtxt.val() == edited);
+    root.redo();
+    CHECK(contentCtxt.val() == replaced);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("Data action coalescing") {
+    config::synth::Shape shape;
+    shape.presets_ = 2;
+
+    std::unique_ptr<config::Config> cfg;
+    auto nameCtxt{data::context(buildSynth(cfg, shape).name_)};
+
+    auto root{data::context(*cfg)};
+    fixedNow = {};
+    root.setClock([] { return fixedNow; });
+
+    auto presets{data::context(presetsOf(*cfg))};
+    const auto name{nameCtxt.val()};
+
+    constexpr std::chrono::milliseconds WINDOW{
+        data::hier::Root::eCoalesce_Window_Ms
+    };
+
+    SECTION("Typing") {
+        nameCtxt.append('a');
+        nameCtxt.append('b');
+        nameCtxt.append('c');
+        CHECK(root.undoDepth() == 1);
+
+        // A new word is a new action.
+        nameCtxt.append(' ');
+        nameCtxt.append('d');
+        CHECK(root.undoDepth() == 2);
+
+        // As is anything on another model.
+        data::context(presets.child<config::presets::Preset>(1).name_)
+            .append('e');
+        CHECK(root.undoDepth() == 3);
+
+        root.undo();
+        root.undo();
+        CHECK(nameCtxt.val() == name + "abc ");
+        root.undo();
+        CHECK(nameCtxt.val() == name);
+        CHECK(not root.canUndo());
+
+        root.redo();
+        CHECK(nameCtxt.val() == name + "abc ");
+        root.redo();
+        CHECK(nameCtxt.val() == name + "abc d");
+    }
+
+    SECTION("Window") {
+        nameCtxt.append('a');
+        fixedNow += WINDOW;
+        nameCtxt.append('b');
+        CHECK(root.undoDepth() == 1);
+
+        // Measured from the last merged in, not the first.
+        fixedNow += WINDOW;
+        nameCtxt.append('c');
+        CHECK(root.undoDepth() == 1);
+
+        fixedNow += WINDOW + std::chrono::milliseconds{1};
+        nameCtxt.append('d');
+        CHECK(root.undoDepth() == 2);
+
+        root.undo();
+        CHECK(nameCtxt.val() == name + "abc");
+        root.undo();
+        CHECK(nameCtxt.val() == name);
+    }
+
+    SECTION("Backspace") {
+        nameCtxt.append("xyz");
+        auto val{nameCtxt.val()};
+        const auto depth{root.undoDepth()};
+
+        for (auto idx{0}; idx < 3; ++idx) {
+            val.pop_back();
+            nameCtxt.change(std::string{val});
+        }
+        CHECK(nameCtxt.val() == name);
+        CHECK(root.undoDepth() == depth + 1);
+
+        root.undo();
+        CHECK(nameCtxt.val() == name + "xyz");
+        root.redo();
+        CHECK(nameCtxt.val() == name);
+    }
+
+    SECTION("Number") {
+        auto thresholdCtxt{data::context(cfg->settings_.clashThreshold_)};
+        const auto threshold{thresholdCtxt.val()};
+
+        thresholdCtxt.set(1.0);
+        thresholdCtxt.set(2.0);
+        thresholdCtxt.set(4.0);
+        CHECK(root.undoDepth() == 1);
+
+        root.undo();
+        CHECK(thresholdCtxt.val() == threshold);
+        root.redo();
+        CHECK(thresholdCtxt.val() == 4.0);
+    }
+
+    SECTION("Compound") {
+        // Volume is the max of boot volume, so each set also causes an update
+        // there, and those can't be merged, only undone together.
+        auto volumeCtxt{data::context(cfg->settings_.volume_)};
+        auto bootVolCtxt{data::context(cfg->settings_.bootVolume_.value_)};
+        const auto volume{volumeCtxt.val()};
+
+        volumeCtxt.set(1500);
+        volumeCtxt.set(2000);
+        CHECK(root.undoDepth() == 2);
+        CHECK(bootVolCtxt.params().max_ == 2000);
+
+        root.undo();
+        CHECK(volumeCtxt.val() == volume);
+        CHECK(bootVolCtxt.params().max_ == volume);
+        CHECK(not root.canUndo());
+
+        root.redo();
+        CHECK(volumeCtxt.val() == 2000);
+        CHECK(bootVolCtxt.params().max_ == 2000);
+        CHECK(not root.canRedo());
+
+        // Past the window, it's a step of its own again.
+        fixedNow += WINDOW + std::chrono::milliseconds{1};
+        volumeCtxt.set(2500);
+        root.undo();
+        CHECK(volumeCtxt.val() == 2000);
+        CHECK(bootVolCtxt.params().max_ == 2000);
+    }
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("Data transaction") {
+    config::synth::Shape shape;
+    shape.presets_ = 4;
+
+    std::unique_ptr<config::Config> cfg;
+    buildSynth(cfg, shape);
+
+    auto root{data::context(*cfg)};
+    auto presets{data::context(presetsOf(*cfg))};
+
+    std::vector<std::string> names;
+    for (size idx{0}; idx < presets.children().size(); ++idx) {
+        names.push_back(data::context(
+            presets.child<config::presets::Preset>(idx).name_
+        ).val());
+    }
+
+    { data::hier::Root::Transaction transaction(*cfg);
+        for (size idx{0}; idx < names.size(); ++idx) {
+            data::context(presets.child<config::presets::Preset>(idx).name_)
+                .change("batch" + std::to_string(idx));
+        }
+
+        { data::hier::Root::Transaction nested(*cfg);
+            presets.append<config::presets::Preset>(*cfg);
+        }
+    }
+
+    // All of it is one step.
+    CHECK(root.undoDepth() == 1);
+    CHECK(presets.children().size() == names.size() + 1);
+
+    root.undo();
+    CHECK(not root.canUndo());
+    REQUIRE(presets.children().size() == names.size());
+    for (size idx{0}; idx < names.size(); ++idx) {
+        CHECK(data::context(
+            presets.child<config::presets::Preset>(idx).name_
+        ).val() == names[idx]);
+    }
+
+    root.redo();
+    CHECK(presets.children().size() == names.size() + 1);
+    CHECK(data::context(
+        presets.child<config::presets::Preset>(0).name_
+    ).val() == "batch0");
+
+    // Nothing done, nothing to undo.
+    { data::hier::Root::Transaction transaction(*cfg); }
+    CHECK(root.undoDepth() == 1);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("Data transaction notifications") {
+    config::synth::Shape shape;
+    shape.presets_ = 2;
+
+    std::unique_ptr<config::Config> cfg;
+    auto& first{buildSynth(cfg, shape).styles_};
+    auto& second{
+        data::context(presetsOf(*cfg)).child<config::presets::Preset>(1).styles_
+    };
+
+    ResizeWatcher firstWatcher(first);
+    ResizeWatcher secondWatcher(second);
+
+    constexpr size NUM_INSERTS{3};
+
+    SECTION("Plain") {
+        for (size idx{0}; idx < NUM_INSERTS; ++idx) {
+            data::context(first).append<config::presets::Style>(*cfg);
+        }
+        CHECK(firstWatcher.inserts_ == NUM_INSERTS);
+        CHECK(firstWatcher.resizes_ == NUM_INSERTS);
+    }
+
+    SECTION("Transaction") {
+        { data::hier::Root::Transaction transaction(*cfg);
+            for (size idx{0}; idx < NUM_INSERTS; ++idx) {
+                data::context(first).append<config::presets::Style>(*cfg);
+                data::context(second).append<config::presets::Style>(*cfg);
+            }
+
+            // Inserts carry their position, so can't wait.
+            CHECK(firstWatcher.inserts_ == NUM_INSERTS);
+            CHECK(firstWatcher.resizes_ == 0);
+        }
+
+        CHECK(firstWatcher.resizes_ == 1);
+        CHECK(secondWatcher.inserts_ == NUM_INSERTS);
+        CHECK(secondWatcher.resizes_ == 1);
+
+        // Undo isn't batched, each step is told as it's undone.
+        data::context(*cfg).undo();
+        CHECK(firstWatcher.resizes_ == 1 + NUM_INSERTS);
+        CHECK(secondWatcher.resizes_ == 1 + NUM_INSERTS);
+    }
+
+    SECTION("Sync") {
+        const auto numBlades{
+            static_cast<size>(data::context(cfg->numBlades()).val())
+        };
+        REQUIRE(numBlades > 1);
+
+        // Leave every blade uncovered, for the sync to fill back in.
+        data::context(first).clear();
+        data::context(second).clear();
+
+        firstWatcher.resizes_ = 0;
+        secondWatcher.resizes_ = 0;
+        cfg->syncStyles();
+
+        CHECK(firstWatcher.inserts_ == numBlades);
+        CHECK(firstWatcher.resizes_ == 1);
+        CHECK(secondWatcher.inserts_ == numBlades);
+        CHECK(secondWatcher.resizes_ == 1);
+    }
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("Data transaction removal") {
+    std::unique_ptr<config::Config> cfg;
+    auto& styles{buildSynth(cfg).styles_};
+
+    ResizeWatcher stylesWatcher(styles);
+
+    { data::hier::Root::Transaction transaction(*cfg);
+        data::context(styles).append<config::presets::Style>(*cfg);
+
+        // Told of something, then gone before the transaction ends and
+        // what's held is sent.
+        auto model{std::make_unique<data::hier::Bool>(*cfg)};
+        { FocusWatcher watcher(*model);
+            data::context(*model).focus();
+            CHECK(watcher.focuses_ == 0);
+        }
+        model.reset();
+
+        // And w/o anyone to tell, nothing is held at all.
+        model = std::make_unique<data::hier::Bool>(*cfg);
+        data::context(*model).focus();
+        model.reset();
+    }
+
+    CHECK(stylesWatcher.resizes_ == 1);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("Data receiver detach") {
+    std::unique_ptr<config::Config> cfg;
+    buildSynth(cfg);
+
+    data::hier::Bool model(*cfg);
+    FocusWatcher first(model);
+    FocusWatcher second(model);
+    FocusWatcher third(model);
+
+    SECTION("Self") {
+        first.detach_ = &first;
+        data::context(model).focus();
+
+        CHECK(first.focuses_ == 1);
+        CHECK(second.focuses_ == 1);
+        CHECK(third.focuses_ == 1);
+
+        data::context(model).focus();
+        CHECK(first.focuses_ == 1);
+        CHECK(second.focuses_ == 2);
+        CHECK(third.focuses_ == 2);
+    }
+
+    SECTION("Earlier") {
+        second.detach_ = &first;
+        data::context(model).focus();
+
+        CHECK(first.focuses_ == 1);
+        CHECK(second.focuses_ == 1);
+        CHECK(third.focuses_ == 1);
+    }
+
+    SECTION("Later") {
+        first.detach_ = &second;
+        data::context(model).focus();
+
+        CHECK(first.focuses_ == 1);
+        CHECK(second.focuses_ == 0);
+        CHECK(third.focuses_ == 1);
+    }
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("Data selector rebind") {
+    std::unique_ptr<config::Config> cfg;
+    buildSynth(cfg);
+
+    auto root{data::context(*cfg)};
+    fixedNow = {};
+    root.setClock([] { return fixedNow; });
+
+    const auto *arrays{&cfg->presetArrays_};
+    const auto *presets{&presetsOf(*cfg)};
+
+    data::hier::Selector sel(*cfg);
+    sel.activate();
+
+    { RebindWatcher watcher(sel);
+        // Observers always see the old binding before, and the new after,
+        // however the rebind comes about.
+        const auto check{[&watcher](
+            const data::base::Vector *from, const data::base::Vector *to
+        ) {
+            REQUIRE(watcher.pre_.size() == 1);
+            REQUIRE(watcher.on_.size() == 1);
+            CHECK(watcher.pre_[0] == from);
+            CHECK(watcher.on_[0] == to);
+            watcher.pre_.clear();
+            watcher.on_.clear();
+        }};
+
+        // Each its own step.
+        data::context(sel).bind(arrays);
+        check(nullptr, arrays);
+        fixedNow += std::chrono::hours{1};
+        data::context(sel).bind(presets);
+        check(arrays, presets);
+
+        SECTION("Undo") {
+            root.undo();
+            check(presets, arrays);
+            root.redo();
+            check(arrays, presets);
+        }
+
+        SECTION("Transaction") {
+            { data::hier::Root::Transaction transaction(*cfg);
+                data::context(sel).bind(arrays);
+                check(presets, arrays);
+            }
+            CHECK(watcher.pre_.empty());
+
+            root.undo();
+            check(arrays, presets);
+        }
+    }
+
+    sel.deactivate();
+}
@@ -18,6 +18,9 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <sstream>
+#include <string_view>
+
 #include <catch2/catch_test_macros.hpp>
 
 #include "utils/hash.hpp"
@@ -31,3 +34,15 @@ TEST_CASE("Hash string") {
     REQUIRE(static_cast<std::string>(*hash) == HASH_STR);
 }
 
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("Hash buffer") {
+    constexpr std::string_view CONTENT{"abc"};
+    constexpr cstring HASH_STR{"ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"};
+
+    std::istringstream stream{std::string{CONTENT}};
+    const auto streamHash{utils::hash::SHA256::stream(stream)};
+    const auto bufferHash{utils::hash::SHA256::buffer(CONTENT)};
+
+    REQUIRE(static_cast<std::string>(bufferHash) == HASH_STR);
+    REQUIRE(bufferHash == streamHash);
+}
@@ -0,0 +1,155 @@
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2026 Ryan Ogurek
+ *
+ * test/tests/math.cpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <array>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "utils/files.hpp"
+#include "utils/string.hpp"
+
+namespace {
+
+const fs::path CONFIG_DIR{CONFIG_DIR_STR};
+
+/**
+ * Values of every #define in the test configs which is only arithmetic.
+ */
+std::vector<std::string> defineCorpus() {
+    std::vector<std::string> ret;
+    for (const auto& entry : fs::directory_iterator(CONFIG_DIR)) {
+        if (entry.path().extension() != ".h") continue;
+
+        auto file{files::openInput(entry.path())};
+        std::string line;
+        while (std::getline(file, line)) {
+            std::istringstream lineStream{line};
+            std::string directive;
+            std::string name;
+            lineStream >> directive >> name;
+            if (directive != "#define") continue;
+
+            std::string value;
+            std::getline(lineStream, value);
+            if (value.find_first_not_of(" \t") == std::string::npos) continue;
+            if (value.find_first_not_of("0123456789.+-*/() \t") != std::string::npos) {
+                continue;
+            }
+
+            ret.push_back(std::move(value));
+        }
+    }
+
+    return ret;
+}
+
+} // namespace
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("String math") {
+    CHECK(utils::doStringMath("42") == 42);
+    CHECK(utils::doStringMath(" 1.5 ") == 1.5);
+    CHECK(utils::doStringMath("0x10") == 16);
+    CHECK(utils::doStringMath("1 + 2 * 3") == 7);
+    CHECK(utils::doStringMath("(1 + 2) * 3") == 9);
+    CHECK(utils::doStringMath("10 - 4 - 3") == 3);
+    CHECK(utils::doStringMath("12 / 3 / 2") == 2);
+    CHECK(utils::doStringMath("2 * -3") == -6);
+    CHECK(utils::doStringMath("7 - +6") == 1);
+    CHECK(utils::doStringMath("-(2 + 3)") == -5);
+    CHECK(utils::doStringMath("15 * 60 * 1000") == 900000);
+
+    CHECK(not utils::doStringMath(""));
+    CHECK(not utils::doStringMath("1 2"));
+    CHECK(not utils::doStringMath("5 (6)"));
+    CHECK(not utils::doStringMath("* 5"));
+    CHECK(not utils::doStringMath("(1 + 2"));
+    CHECK(not utils::doStringMath("1 + 2)"));
+    CHECK(not utils::doStringMath("1 +"));
+    CHECK(not utils::doStringMath("1.2.3"));
+    CHECK(not utils::doStringMath("1 % 2"));
+
+    // Whitespace normalization mustn't merge separate numbers in the cache.
+    CHECK(utils::doStringMath("12") == 12);
+    CHECK(not utils::doStringMath("1 2"));
+
+    constexpr std::array<utils::MathConstant, 2> CONSTANTS{{
+        {.name_="NO_BLADE", .value_=1000000000},
+        {.name_="BLADE_ID", .value_=2000},
+    }};
+    CHECK(utils::doStringMath("NO_BLADE", CONSTANTS) == 1000000000);
+    CHECK(utils::doStringMath("BLADE_ID * 2 + 1", CONSTANTS) == 4001);
+    CHECK(not utils::doStringMath("NO_BLADE"));
+    CHECK(not utils::doStringMath("UNKNOWN", CONSTANTS));
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("String math config corpus") {
+    const auto corpus{defineCorpus()};
+    REQUIRE(not corpus.empty());
+
+    for (const auto& str : corpus) {
+        INFO(str);
+
+        const auto expr{utils::MathExpression::compile(str)};
+        REQUIRE(expr);
+        const auto val{expr->evaluate()};
+        REQUIRE(val);
+        REQUIRE(std::isfinite(*val));
+
+        // Cached results must match, the first time and every time after.
+        REQUIRE(utils::doStringMath(str) == val);
+        REQUIRE(utils::doStringMath(str) == val);
+    }
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("String math cache") {
+    // Well past what's kept, from several threads at once, so entries are
+    // evicted while others are still evaluating theirs.
+    constexpr uint32 NUM_EXPRS{4096};
+    constexpr uint32 NUM_THREADS{4};
+
+    std::array<uint32, NUM_THREADS> wrong{};
+    std::vector<std::thread> threads;
+    for (uint32 thread{0}; thread < NUM_THREADS; ++thread) {
+        threads.emplace_back([thread, &wrong] {
+            // Each starts somewhere else.
+            const auto offset{thread * NUM_EXPRS / NUM_THREADS};
+            for (uint32 idx{0}; idx < NUM_EXPRS; ++idx) {
+                const auto num{(idx + offset) % NUM_EXPRS};
+                const auto res{utils::doStringMath(std::to_string(num) + " * 2 + 1")};
+                if (res != (num * 2) + 1) ++wrong[thread];
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    for (const auto count : wrong) CHECK(count == 0);
+
+    // And what was evicted comes back.
+    CHECK(utils::doStringMath("0 * 2 + 1") == 1);
+    CHECK(utils::doStringMath("1 * 2 + 1") == 3);
+}
@@ -0,0 +1,362 @@
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2026 Ryan Ogurek
+ *
+ * test/tests/pconf.cpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "pconf/document.hpp"
+#include "pconf/parse.hpp"
+#include "pconf/read.hpp"
+#include "pconf/types.hpp"
+#include "pconf/utils.hpp"
+#include "pconf/write.hpp"
+#include "utils/files.hpp"
+
+namespace {
+
+const fs::path PROPS_DIR{PROPS_DIR_STR};
+
+std::vector<fs::path> propFiles() {
+    std::vector<fs::path> ret;
+    for (const auto& entry : fs::recursive_directory_iterator(PROPS_DIR)) {
+        if (entry.path().extension() == ".pconf") ret.push_back(entry.path());
+    }
+
+    return ret;
+}
+
+/**
+ * Flattens events into one string per event for easy comparison.
+ */
+struct Recorder : pconf::Handler {
+    bool onSectionBegin(const pconf::Event& event) override {
+        events_.push_back("begin " + describe(event));
+        return true;
+    }
+
+    bool onEntry(const pconf::Event& event) override {
+        events_.push_back("entry " + describe(event));
+        return true;
+    }
+
+    bool onSectionEnd() override {
+        events_.emplace_back("end");
+        return true;
+    }
+
+    static std::string describe(const pconf::Event& event) {
+        std::string ret{event.name_};
+        if (event.label_) ret += "(" + std::string{*event.label_} + ")";
+        if (event.labelNum_) ret += "{" + std::to_string(*event.labelNum_) + "}";
+        if (event.value_) ret += "=" + std::string{*event.value_};
+        return ret;
+    }
+
+    std::vector<std::string> events_;
+};
+
+std::string serialize(const pconf::Data& data) {
+    std::ostringstream stream;
+    pconf::write(stream, data, nullptr);
+    return stream.str();
+}
+
+} // namespace
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("PConf Document") {
+    SECTION("Matches stream reader") {
+        for (const auto& path : propFiles()) {
+            INFO(path.string());
+
+            auto stream{files::openInput(path)};
+            pconf::Data data;
+            REQUIRE(pconf::read(stream, data, nullptr));
+
+            pconf::Document doc;
+            REQUIRE(pconf::read(path, doc, nullptr));
+
+            REQUIRE(serialize(doc.data()) == serialize(data));
+        }
+    }
+
+    SECTION("Joined and sectioned values") {
+        constexpr std::string_view SRC{
+            "A: unquoted // comment\n"
+            "B: \"one\", \"two\"\n"
+            "C(\"label\") {\n"
+            "    D: {\n"
+            "        \"multi\"\n"
+            "        \"line\"\n"
+            "    }\n"
+            "}\n"
+            "E{3}\n"
+        };
+
+        std::unique_ptr<char[]> buffer{new char[SRC.size()]};
+        SRC.copy(buffer.get(), SRC.size());
+
+        pconf::Document doc;
+        REQUIRE(pconf::read(std::move(buffer), SRC.size(), doc, nullptr));
+        REQUIRE(doc.numNodes() == 5);
+
+        const auto *aEntry{doc.find("A")};
+        REQUIRE(aEntry);
+        REQUIRE(aEntry->value_ == " unquoted");
+
+        const auto *bEntry{doc.find("B")};
+        REQUIRE(bEntry);
+        REQUIRE(bEntry->value_ == "one\ntwo");
+
+        const auto *cEntry{doc.find("C")};
+        REQUIRE(cEntry);
+        REQUIRE(cEntry->isSection());
+        REQUIRE(cEntry->label_ == "label");
+
+        const auto *dEntry{cEntry->find("D")};
+        REQUIRE(dEntry);
+        REQUIRE(dEntry->value_ == "multi\nline");
+
+        const auto *eEntry{doc.find("E")};
+        REQUIRE(eEntry);
+        REQUIRE(not eEntry->isSection());
+        REQUIRE(eEntry->labelNum_ == 3);
+    }
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("PConf Events") {
+    SECTION("Document order") {
+        constexpr std::string_view SRC{
+            "A: \"one\"\n"
+            "B(\"label\") {\n"
+            "    C{2}: {\n"
+            "        \"multi\"\n"
+            "        \"line\"\n"
+            "    }\n"
+            "    D {\n"
+            "}\n"
+        };
+
+        Recorder recorder;
+        REQUIRE(pconf::parse(SRC, recorder, nullptr));
+
+        const std::vector<std::string> expected{
+            "entry A=one",
+            "begin B(label)",
+            "entry C{2}=multi\nline",
+            "begin D",
+            "end",
+            "end",
+        };
+        REQUIRE(recorder.events_ == expected);
+    }
+
+    SECTION("Walk matches parse") {
+        for (const auto& path : propFiles()) {
+            INFO(path.string());
+
+            std::unique_ptr<char[]> buffer;
+            size length{};
+            REQUIRE(pconf::readFile(path, buffer, length, nullptr));
+
+            const std::string_view source{buffer.get(), length};
+
+            Recorder parsed;
+            REQUIRE(pconf::parse(source, parsed, nullptr));
+
+            pconf::Data data;
+            pconf::DataBuilder builder{data};
+            REQUIRE(pconf::parse(source, builder, nullptr));
+
+            Recorder walked;
+            REQUIRE(pconf::walk(data, walked));
+
+            REQUIRE(walked.events_ == parsed.events_);
+        }
+    }
+
+    SECTION("Unbalanced end") {
+        Recorder recorder;
+        REQUIRE(not pconf::parse("A\n}\n", recorder, nullptr));
+    }
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("PConf Symbol") {
+    const std::string text{"SYMBOL_TEST"};
+    const pconf::Symbol first{text};
+    const pconf::Symbol second{std::string{text}};
+    const pconf::Symbol prehashed{pconf::Symbol::Prehashed{text}};
+
+    // Same text, same storage, whichever way it was made.
+    CHECK(first == second);
+    CHECK(first == prehashed);
+    CHECK(first.str().data() == second.str().data());
+    CHECK(first.str().data() == prehashed.str().data());
+    CHECK(first.str().data() != text.data());
+
+    CHECK(first.str() == text);
+    CHECK(first.hash() == std::hash<std::string_view>{}(text));
+    CHECK(first.hash() == prehashed.hash());
+
+    const pconf::Symbol other{"SYMBOL_TEST_OTHER"};
+    CHECK(not (first == other));
+    CHECK(other.str() == "SYMBOL_TEST_OTHER");
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("PConf HashedData") {
+    const pconf::Data data{
+        pconf::Entry::create("A", "1"),
+        pconf::Entry::create("B", "2"),
+        pconf::Entry::create("A", "3"),
+        pconf::Section::create("C"),
+    };
+    auto hashed{pconf::hash(data)};
+
+    // Looked up as text or as a symbol, it's the same entries, in order.
+    for (const auto& key : {"A", "B", "C"}) {
+        INFO(key);
+        const auto byText{hashed.findAll(std::string_view{key})};
+        const auto bySymbol{hashed.findAll(pconf::Symbol{key})};
+        REQUIRE(byText.size() == bySymbol.size());
+        for (size idx{0}; idx < byText.size(); ++idx) {
+            CHECK(byText[idx] == bySymbol[idx]);
+        }
+        CHECK(hashed.find(std::string_view{key}) == byText[0]);
+        CHECK(hashed.find(pconf::Symbol{key}) == byText[0]);
+    }
+
+    REQUIRE(hashed.findAll("A").size() == 2);
+    CHECK(hashed.findAll("A")[0] == data[0]);
+    CHECK(hashed.findAll("A")[1] == data[2]);
+    CHECK(hashed.find("C").isSection());
+
+    CHECK(hashed.find("D") == nullptr);
+    CHECK(hashed.findAll("D").empty());
+    CHECK(hashed.find(pconf::Symbol{"D"}) == nullptr);
+
+    // Added by text or symbol, it's one key.
+    hashed["D"].push_back(pconf::Entry::create("D", "4"));
+    hashed[pconf::Symbol{"D"}].push_back(pconf::Entry::create("D", "5"));
+    REQUIRE(hashed.findAll("D").size() == 2);
+    CHECK(hashed.findAll("D")[1]->value_ == "5");
+
+    hashed.erase(data[0]);
+    REQUIRE(hashed.findAll("A").size() == 1);
+    CHECK(hashed.find("A") == data[2]);
+    hashed.erase(data[2]);
+    CHECK(hashed.find("A") == nullptr);
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("PConf Writer") {
+    SECTION("Matches expected text") {
+        // Written out by the stream writer from before writes were buffered.
+        constexpr std::string_view EXPECTED{
+            "FLAG\n"
+            "NAME: \"value\"\n"
+            "LABELED(\"lbl\"){2}: \"v\"\n"
+            "QUOTED: {\n"
+            "\t\"has \"quotes\"\"\n"
+            "}\n"
+            "SECT(\"s\"){1} {\n"
+            "\tMULTI: {\n"
+            "\t\t\"one\"\n"
+            "\t\t\"two\"\n"
+            "\t}\n"
+            "\tINNER {\n"
+            "\t\tX: \"y\"\n"
+            "\t}\n"
+            "\tEMPTY {\n"
+            "\t}\n"
+            "}\n"
+        };
+
+        const pconf::Data data{
+            pconf::Entry::create("FLAG"),
+            pconf::Entry::create("NAME", "value"),
+            pconf::Entry::create("LABELED", "v", "lbl", 2),
+            pconf::Entry::create("QUOTED", "has \"quotes\""),
+            pconf::Section::create("SECT", "s", 1, {
+                pconf::Entry::create("MULTI", "one\ntwo"),
+                pconf::Section::create("INNER", std::nullopt, std::nullopt, {
+                    pconf::Entry::create("X", "y"),
+                }),
+                pconf::Section::create("EMPTY"),
+            }),
+        };
+
+        std::string buffer;
+        pconf::write(buffer, data);
+        CHECK(buffer == EXPECTED);
+        CHECK(serialize(data) == EXPECTED);
+    }
+
+    SECTION("Rereads the same") {
+        for (const auto& path : propFiles()) {
+            INFO(path.string());
+
+            auto stream{files::openInput(path)};
+            pconf::Data data;
+            REQUIRE(pconf::read(stream, data, nullptr));
+
+            std::string written;
+            pconf::write(written, data);
+
+            pconf::Data reread;
+            pconf::DataBuilder builder{reread};
+            REQUIRE(pconf::parse(written, builder, nullptr));
+
+            std::string rewritten;
+            pconf::write(rewritten, reread);
+            REQUIRE(rewritten == written);
+        }
+    }
+
+    SECTION("Splice matches full write") {
+        pconf::Writer writer;
+        REQUIRE(writer.set("A"));
+        REQUIRE(writer.set("B", "short"));
+        REQUIRE(writer.set(pconf::Section::create("C", "label", 3, {
+            pconf::Entry::create("D", "multi\nline"),
+        })));
+        REQUIRE(writer.set("E", "has \"quotes\""));
+
+        REQUIRE(not writer.set("B", "short"));
+        REQUIRE(writer.set("B", "a much longer value"));
+        REQUIRE(writer.erase("A"));
+        REQUIRE(not writer.erase("A"));
+        REQUIRE(writer.set("E", "e"));
+
+        const pconf::Data expected{
+            pconf::Entry::create("B", "a much longer value"),
+            pconf::Section::create("C", "label", 3, {
+                pconf::Entry::create("D", "multi\nline"),
+            }),
+            pconf::Entry::create("E", "e"),
+        };
+        REQUIRE(writer.image() == serialize(expected));
+    }
+}
@@ -0,0 +1,175 @@
+/*
+ * ProffieConfig, All-In-One Proffieboard Management Utility
+ * Copyright (C) 2026 Ryan Ogurek
+ *
+ * test/tests/versions.cpp
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "pconf/parse.hpp"
+#include "pconf/read.hpp"
+#include "pconf/utils.hpp"
+#include "utils/files.hpp"
+#include "versions/detail/strings.hpp"
+#include "versions/priv/cache.hpp"
+#include "versions/prop.hpp"
+
+namespace {
+
+const fs::path PROPS_DIR{PROPS_DIR_STR};
+
+/**
+ * @return The data.pconf of every shipped prop
+ */
+std::vector<fs::path> propDataFiles() {
+    std::vector<fs::path> ret;
+    for (const auto& entry : fs::directory_iterator(PROPS_DIR)) {
+        const auto path{entry.path() / versions::detail::DATA_FILE_STR};
+        if (fs::exists(path)) ret.push_back(path);
+    }
+
+    return ret;
+}
+
+std::string readAll(const fs::path& path) {
+    std::unique_ptr<char[]> buffer;
+    size length{};
+    REQUIRE(pconf::readFile(path, buffer, length, nullptr));
+    return {buffer.get(), length};
+}
+
+void writeAll(const fs::path& path, std::string_view content) {
+    std::error_code err;
+    REQUIRE(files::writeAtomic(path, content, err));
+}
+
+std::string encode(const std::optional<versions::props::PropData>& data) {
+    REQUIRE(data);
+    auto ret{versions::priv::encodePropData(*data)};
+    REQUIRE(ret);
+    return std::move(*ret);
+}
+
+} // namespace
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("Prop data") {
+    const auto files{propDataFiles()};
+    REQUIRE(not files.empty());
+
+    // From the source, settings are read as they're parsed, and from a tree
+    // they're walked after. Either way must come out the same.
+    for (const auto& file : files) {
+        INFO(file.string());
+
+        const auto fromSource{versions::props::PropData::generate(
+            readAll(file), nullptr
+        )};
+
+        auto stream{files::openInput(file)};
+        pconf::Data data;
+        REQUIRE(pconf::read(stream, data, nullptr));
+        const auto fromTree{versions::props::PropData::generate(
+            pconf::hash(data), nullptr
+        )};
+
+        CHECK(encode(fromSource) == encode(fromTree));
+    }
+}
+
+// NOLINTNEXTLINE(misc-use-anonymous-namespace)
+TEST_CASE("Prop cache") {
+    const auto files{propDataFiles()};
+    REQUIRE(not files.empty());
+
+    // The cache is written next to its source, so work on a copy.
+    const auto dir{fs::temp_directory_path() / "proffieconfig-prop-cache"};
+    std::error_code err;
+    fs::remove_all(dir, err);
+    fs::create_directories(dir);
+
+    const auto source{dir / versions::detail::DATA_FILE_STR};
+    const auto cache{dir / versions::detail::DATA_CACHE_FILE_STR};
+
+    SECTION("Round trip") {
+        for (const auto& file : files) {
+            INFO(file.string());
+            const auto content{readAll(file)};
+            writeAll(source, content);
+
+            const auto data{versions::props::PropData::generate(content, nullptr)};
+            const auto expected{encode(data)};
+
+            fs::remove(cache, err);
+            CHECK(not versions::priv::loadPropCache(source, nullptr));
+
+            versions::priv::savePropCache(source, content, *data, nullptr);
+            CHECK(encode(versions::priv::loadPropCache(source, nullptr)) == expected);
+        }
+    }
+
+    const auto content{readAll(files.front())};
+    writeAll(source, content);
+    const auto data{versions::props::PropData::generate(content, nullptr)};
+    REQUIRE(data);
+    versions::priv::savePropCache(source, content, *data, nullptr);
+    REQUIRE(versions::priv::loadPropCache(source, nullptr));
+
+    SECTION("Stale source") {
+        // Same size, and likely within the same mtime tick, so only the
+        // content can tell.
+        auto edited{content};
+        edited[edited.find_first_not_of(" \n\t")] ^= 0x20;
+        writeAll(source, edited);
+        CHECK(not versions::priv::loadPropCache(source, nullptr));
+
+        writeAll(source, content + "\n");
+        CHECK(not versions::priv::loadPropCache(source, nullptr));
+
+        // Rewritten, but the same, is still good.
+        writeAll(source, content);
+        CHECK(versions::priv::loadPropCache(source, nullptr));
+    }
+
+    SECTION("Corrupt cache") {
+        const auto image{readAll(cache)};
+
+        // Anywhere, from the header through the payload.
+        for (const auto pos : {0UZ, image.size() / 2, image.size() - 1}) {
+            auto corrupt{image};
+            corrupt[pos] ^= 0x01;
+            writeAll(cache, corrupt);
+            CHECK(not versions::priv::loadPropCache(source, nullptr));
+        }
+
+        writeAll(cache, image.substr(0, image.size() - 1));
+        CHECK(not versions::priv::loadPropCache(source, nullptr));
+
+        writeAll(cache, image.substr(0, 8));
+        CHECK(not versions::priv::loadPropCache(source, nullptr));
+
+        writeAll(cache, {});
+        CHECK(not versions::priv::loadPropCache(source, nullptr));
+    }
+
+    fs::remove_all(dir, err);
+}